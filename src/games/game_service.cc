@@ -0,0 +1,276 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file game_service.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: many concurrent Hex games searched on one pool
+
+// Standard C++ Headers
+#include <algorithm>        // std::find, std::swap
+#include <exception>        // std::exception_ptr
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/game_service.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t GameService::DEFAULT_MAX_GAMES;
+constexpr uint32_t GameService::DEFAULT_MAX_QUEUED_MOVES;
+// End of Forward Declarations
+
+GameService::GameService(const MCStrategy::Type strategy,
+                         const uint32_t num_threads,
+                         const uint32_t max_games,
+                         const uint32_t max_queued_moves,
+                         const bool     auto_test,
+                         const uint32_t num_sim_trials_allowed) :
+    _strategy_type{strategy}, _max_games{max_games},
+    _max_queued_moves{max_queued_moves}, _auto_test{auto_test},
+    _num_sim_trials_allowed{num_sim_trials_allowed}, _pool{num_threads},
+    _next_id{0}, _next_seq{0}, _num_running{0}, _num_rejected{0} {
+  DLOG(INFO) << "GameService: strategy " << strategy
+             << ": # threads " << num_threads << ": max games " << max_games
+             << ": max queued moves " << max_queued_moves;
+
+  return;
+}
+
+GameService::~GameService() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_queue.empty()) {
+    const Request &r = _queue.top();
+    r.result->set_exception(std::make_exception_ptr(
+        std::string("GameService: stopped")));
+    _queue.pop();
+  }
+  // Searches in progress touch the games: the games go once they end
+  _cv.wait(lock, [this]() { return _num_running == 0; });
+
+  return;
+}
+
+GameService::GameId GameService::open_game(const uint32_t dimension) {
+  if (dimension < Hex::MIN_DIMENSION || dimension > Hex::MAX_DIMENSION) {
+    std::stringstream ss;
+    ss << "GameService: dimension " << dimension << ": should be in ["
+       << Hex::MIN_DIMENSION << ", " << Hex::MAX_DIMENSION << "]";
+    throw ss.str();
+  }
+  std::unique_ptr<MCStrategy> strategy_p = MCHex::make_strategy(
+      _strategy_type, dimension, _auto_test, _num_sim_trials_allowed,
+      MCHex::factorial_inverse(_num_sim_trials_allowed), 1, &_pool);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_games.size() >= _max_games) {
+    ++_num_rejected;
+    std::stringstream ss;
+    ss << "GameService: # games " << _games.size() << ": at capacity";
+    throw ss.str();
+  }
+  GameId id = _next_id++;
+  _games[id].reset(new Game(dimension, std::move(strategy_p)));
+
+  return id;
+}
+
+void GameService::close_game(const GameId id) {
+  std::unique_ptr<Game> game_p;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    get_idle_game(id);
+    game_p = std::move(_games.at(id));
+    _games.erase(id);
+  }
+  // The engine (e.g. its trees) is freed outside the lock
+
+  return;
+}
+
+void GameService::play_move(const GameId id, const uint32_t vid) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Game *game_p = get_open_game(id);
+  if (vid >= game_p->moves.size() ||
+      std::find(game_p->moves.begin() + game_p->num_moves,
+                game_p->moves.end(), vid) == game_p->moves.end()) {
+    std::stringstream ss;
+    ss << "GameService: game " << id << ": illegal move " << vid;
+    throw ss.str();
+  }
+  record_move(game_p, vid);
+
+  return;
+}
+
+std::future<uint32_t> GameService::request_move(const GameId id,
+                                                const TimePoint deadline) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Game *game_p = get_open_game(id);
+  if (_queue.size() >= _max_queued_moves ||
+      TimeManager::is_expired(deadline)) {
+    ++_num_rejected;
+    std::stringstream ss;
+    ss << "GameService: game " << id << ": overloaded: # queued moves "
+       << _queue.size();
+    throw ss.str();
+  }
+  game_p->busy = true;
+  Request r{deadline, _next_seq++, id,
+            std::make_shared<std::promise<uint32_t>>()};
+  std::future<uint32_t> result = r.result->get_future();
+  _queue.push(r);
+  dispatch();
+
+  return result;
+}
+
+Hex::State GameService::get_winner(const GameId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _games.find(id);
+  if (it == _games.end()) {
+    std::stringstream ss;
+    ss << "GameService: game " << id << ": unknown";
+    throw ss.str();
+  }
+  return it->second->h.get_winner();
+}
+
+uint32_t GameService::get_num_moves(const GameId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _games.find(id);
+  if (it == _games.end()) {
+    std::stringstream ss;
+    ss << "GameService: game " << id << ": unknown";
+    throw ss.str();
+  }
+  return it->second->num_moves;
+}
+
+uint32_t GameService::get_num_games(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _games.size();
+}
+
+uint32_t GameService::get_num_queued(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queue.size();
+}
+
+uint64_t GameService::get_num_rejected(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _num_rejected;
+}
+
+GameService::Game *GameService::get_idle_game(const GameId id) {
+  auto it = _games.find(id);
+  std::stringstream ss;
+  ss << "GameService: game " << id << ": ";
+  if (it == _games.end()) {
+    ss << "unknown";
+    throw ss.str();
+  }
+  Game *game_p = it->second.get();
+  if (game_p->busy) {
+    ss << "move in progress";
+    throw ss.str();
+  }
+  return game_p;
+}
+
+GameService::Game *GameService::get_open_game(const GameId id) {
+  Game *game_p = get_idle_game(id);
+  if (game_p->h.is_play_over()) {
+    std::stringstream ss;
+    ss << "GameService: game " << id << ": game over";
+    throw ss.str();
+  }
+  return game_p;
+}
+
+void GameService::record_move(Game *game_p, uint32_t vid) {
+  auto it = std::find(game_p->moves.begin() + game_p->num_moves,
+                      game_p->moves.end(), vid);
+  assert(it != game_p->moves.end());
+  std::swap(game_p->moves.at(game_p->num_moves), *it);
+  ++game_p->num_moves;
+  game_p->h.set_next_move(vid);
+  game_p->h.assess_positions();
+
+  return;
+}
+
+//! @details A search holds a thread of the pool until its deadline (or its
+//! trials) run out: searches beyond the # of threads would only share the
+//! threads & miss their deadlines together
+void GameService::dispatch(void) {
+  while (_num_running < _pool.get_num_threads() && !_queue.empty()) {
+    Request r = _queue.top();
+    _queue.pop();
+    ++_num_running;
+    _pool.submit([this, r]() { search(r); return; });
+  }
+
+  return;
+}
+
+//! @details The game is busy: nothing else touches its moves or engine
+//! until the move is recorded
+void GameService::search(const Request &r) {
+  Game *game_p;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    game_p = _games.at(r.id).get();
+  }
+  uint32_t vid = 0;
+  std::exception_ptr error;
+  try {
+    vid = game_p->strategy->get_next_move(&game_p->moves, game_p->num_moves,
+                                          r.deadline);
+  }
+  catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!error)
+      record_move(game_p, vid);
+    game_p->busy = false;
+    --_num_running;
+    dispatch();
+    // Under the lock: the service may go as soon as the lock is released
+    _cv.notify_all();
+  }
+  if (error)
+    r.result->set_exception(error);
+  else
+    r.result->set_value(vid);
+
+  DLOG(INFO) << "GameService: game " << r.id << ": move " << vid;
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
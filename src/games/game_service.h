@@ -0,0 +1,208 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     game_service.h
+//! @brief    Definition: many concurrent Hex games searched on one pool
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _GAME_SERVICE_H_
+#define _GAME_SERVICE_H_
+// C++ Standard Headers
+#include <condition_variable> // std::condition_variable
+#include <future>           // std::future, std::promise
+#include <map>              // std::map
+#include <memory>           // std::unique_ptr, std::shared_ptr
+#include <mutex>            // std::mutex
+#include <queue>            // std::priority_queue
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/mc_hex.h"
+#include "games/mc_strategy.h"
+#include "games/time_manager.h"
+#include "utils/work_stealing_pool.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    GameService
+//! @brief    Hosts many concurrent games: the moves of the engine in every
+//!           game are searched on one pool of threads shared by all games
+//! @details  A game is a board, its moves & a search engine (one worker
+//!           of its strategy) keeping its statistics across moves. Moves
+//!           of the opponent are played as they arrive; a move of the
+//!           engine is requested with a deadline & delivered via a future.
+//!           Scheduling: at most one search per thread of the pool runs at
+//!           a time; requests waiting for a thread are served earliest
+//!           deadline first (ties: first come first served). Time spent
+//!           waiting counts against the deadline of the request. A game
+//!           has at most one request in progress.
+//!           Admission control: a game beyond max_games is refused & so is
+//!           a request once max_queued_moves requests wait (or when its
+//!           deadline has passed): callers shed load instead of letting
+//!           every deadline slip.
+//!           Errors (unknown game, move in progress, illegal move, game
+//!           over, capacity reached) are thrown as a std::string.
+//! EXAMPLE USAGE:
+//!   GameService service(MCStrategy::Type::UCT, 8);
+//!   GameService::GameId id = service.open_game(11);
+//!   service.play_move(id, 60);
+//!   std::future<uint32_t> move = service.request_move(
+//!       id, TimeManager::Clock::now() + std::chrono::seconds(1));
+//!   uint32_t vid = move.get();
+//!   service.close_game(id);
+class GameService {
+ public:
+  using GameId    = uint32_t;
+  using TimePoint = TimeManager::TimePoint;
+
+  //! Default cap of games hosted at once
+  constexpr static uint32_t DEFAULT_MAX_GAMES = 256;
+  //! Default cap of requests waiting for a thread
+  constexpr static uint32_t DEFAULT_MAX_QUEUED_MOVES = 256;
+
+  //! @param[in] strategy search engine of every game
+  //! @param[in] num_threads # of threads of the pool shared by the games
+  //! @param[in] max_games max # of games hosted at once
+  //! @param[in] max_queued_moves max # of requests waiting for a thread
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_sim_trials_allowed max trials allowed for each move
+  GameService(const MCStrategy::Type strategy,
+              const uint32_t num_threads,
+              const uint32_t max_games = DEFAULT_MAX_GAMES,
+              const uint32_t max_queued_moves = DEFAULT_MAX_QUEUED_MOVES,
+              const bool     auto_test = false,
+              const uint32_t num_sim_trials_allowed =
+                             MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED);
+  //! Requests waiting are dropped (their futures throw) & searches in
+  //! progress are completed
+  ~GameService();
+
+  //! @brief New game on an empty board of dimension
+  //! @return id of the game
+  GameId open_game(const uint32_t dimension);
+
+  //! @brief Game is dropped: refused while a move of it is in progress
+  void close_game(const GameId id);
+
+  //! @brief Plays the next move of the game (BLUE first & players
+  //! alternate) at the open position vid
+  void play_move(const GameId id, const uint32_t vid);
+
+  //! @brief Queues the search of the next move of the game
+  //! @param[in] id game
+  //! @param[in] deadline search ends once deadline passes
+  //! @return the move: played in the game once the search ends
+  std::future<uint32_t> request_move(const GameId id,
+                                     const TimePoint deadline);
+
+  //! @brief Winner of the game: EMPTY while in progress
+  Hex::State get_winner(const GameId id);
+
+  //! @brief # of moves played in the game
+  uint32_t get_num_moves(const GameId id);
+
+  //! # of games hosted
+  uint32_t get_num_games(void);
+  //! # of requests waiting for a thread
+  uint32_t get_num_queued(void);
+  //! # of games & requests refused by admission control
+  uint64_t get_num_rejected(void);
+
+  GameService(const GameService &)    = delete; //!< @brief disallow copy ctor
+  GameService(GameService &&)         = delete; //!< @brief disallow move ctor
+  void operator=(const GameService &) = delete; //!< @brief disallow assignment
+  void operator=(GameService &&)      = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  //! @brief Board, moves & search engine of a game
+  struct Game {
+    Game(uint32_t dimension, std::unique_ptr<MCStrategy> strategy_p) :
+        moves(dimension*dimension), num_moves{0}, h(dimension),
+        strategy(std::move(strategy_p)), busy{false} {
+      for (uint32_t i = 0; i < moves.size(); ++i)
+        moves.at(i) = i;
+    }
+    //! moves[0..num_moves) played (BLUE first) & the rest open
+    std::vector<uint32_t>       moves;
+    uint32_t                    num_moves;
+    Hex                         h;
+    std::unique_ptr<MCStrategy> strategy;
+    //! true while a request of the game is queued or searched
+    bool                        busy;
+  };
+  //! @brief Search of the next move of a game
+  struct Request {
+    TimePoint                               deadline;
+    uint64_t                                seq; //!< order of arrival
+    GameId                                  id;
+    std::shared_ptr<std::promise<uint32_t>> result;
+  };
+  //! Earliest deadline first: ties by order of arrival
+  struct Later {
+    bool operator()(const Request &a, const Request &b) const {
+      return (a.deadline != b.deadline) ?
+          (a.deadline > b.deadline) : (a.seq > b.seq);
+    }
+  };
+
+  const MCStrategy::Type          _strategy_type;
+  const uint32_t                  _max_games;
+  const uint32_t                  _max_queued_moves;
+  const bool                      _auto_test;
+  const uint32_t                  _num_sim_trials_allowed;
+  //! threads shared by the searches of all games: outlives the games
+  utils::WorkStealingPool         _pool;
+  //! guards every member below
+  std::mutex                      _mutex;
+  //! signals a search ended
+  std::condition_variable         _cv;
+  std::map<GameId, std::unique_ptr<Game>> _games;
+  std::priority_queue<Request, std::vector<Request>, Later> _queue;
+  GameId                          _next_id;
+  uint64_t                        _next_seq;
+  //! # of searches running on the pool
+  uint32_t                        _num_running;
+  uint64_t                        _num_rejected;
+
+  //! @brief Game of id: throws unless hosted & idle. _mutex held
+  Game *get_idle_game(const GameId id);
+  //! @brief Idle game of id: throws once the game is over. _mutex held
+  Game *get_open_game(const GameId id);
+  //! @brief Occupies the open position vid of the game. _mutex held
+  static void record_move(Game *game_p, uint32_t vid);
+  //! @brief Starts the most urgent requests on free threads. _mutex held
+  void dispatch(void);
+  //! @brief Searches the move of a request on a thread of the pool
+  void search(const Request &r);
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _GAME_SERVICE_H_
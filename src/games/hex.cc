@@ -20,6 +20,7 @@
 #include <iomanip>          // std::setw, std::left, std::setfill
 #include <sstream>          // std::stringstream
 #include <exception>        // throw
+#include <algorithm>        // std::min
 // Standard C Headers
 #include <cassert>          // assert()
 // Google Headers
@@ -27,6 +28,7 @@
 // Local Headers
 #include "utils/graph_iter.h"
 #include "games/hex.h"
+#include "games/hex_zobrist.h"
 
 using namespace hexgame;
 using namespace hexgame::utils;
@@ -35,21 +37,30 @@ using namespace std;
 namespace hexgame { namespace games {
 //-----------------------------------------------------------------------------
 Hex::Hex(const uint32_t dimension) :
-    _dim(dimension), _g(dimension*dimension), 
+    _dim(dimension), _topo(build_topology()),
+    _zobrist(std::make_shared<const HexZobrist>(dimension)), _g(*_topo), 
     _state{ ._round = 0, ._last = Hex::State::EMPTY, 
             ._over = false, ._winner = Hex::State::EMPTY,
-            ._blue = 0, ._red = 0} {
+            ._blue = 0, ._red = 0, ._key = _zobrist->get_empty_key()}, 
+    _fm(dimension*dimension + NUM_SIDES), _saves{} {
+  return;
+}
+
+// Builds the board topology: once per game & shared by all copies of Hex
+std::shared_ptr<const Hex::HexTopology> Hex::build_topology(void) {
   if (_dim < Hex::MIN_DIMENSION || _dim > Hex::MAX_DIMENSION) {
     std::stringstream ss;
-    ss << "Hex: Game dimension " << dimension 
+    ss << "Hex: Game dimension " << _dim 
        << ": accepted-range 26 >= dimension >=3";
     throw ss.str();
   }
-  connect_corner_nodes();
-  connect_boundary_nodes();
-  connect_internal_nodes();
+  std::shared_ptr<HexTopology> topo = 
+      std::make_shared<HexTopology>(GEdgeType::UNDIRECTED, _dim*_dim, 0, 1, 1);
+  connect_corner_nodes(topo.get());
+  connect_boundary_nodes(topo.get());
+  connect_internal_nodes(topo.get());
 
-  return;
+  return topo;
 }
 
 // Provides the node position based on move_str
@@ -100,7 +111,7 @@ int32_t Hex::get_node_pos_from_str(std::string move_str) {
   // 2. Determine the node position where the move is made
   uint32_t ns = static_cast<uint32_t>(ch - 'A');
   uint32_t vid = get_node_pos(ns, ew);
-  State s = this->_g.get_vertex_attr(vid);
+  State s = get_node_state(vid);
   // once a board position is taken by BLUE or RED it cannot be 
   // overriden by the opponent
   if (s != State::EMPTY)
@@ -180,7 +191,7 @@ std::ostream& operator <<(std::ostream& os, const Hex &h) {
       // Display East edges (West Edges are displayed in the previous iteration)
       if (ew >= h._dim - 1)
         continue;
-      if (h._g.get_edge_value(vid, vid+1) < kGInfinityCost())
+      if (h._topo->get_edge_value(vid, vid+1) < kGInfinityCost())
         os << std::left << std::setfill(' ') << std::setw(2) << ew_edge;
     }
     // West Label
@@ -200,7 +211,7 @@ std::ostream& operator <<(std::ostream& os, const Hex &h) {
       if (ew == 0) {
         nvid1 = h.get_node_pos(ns, 0);
         svid1 = h.get_node_pos(ns + 1, 0);
-        if (h._g.get_edge_value(nvid1, svid1) < kGInfinityCost())
+        if (h._topo->get_edge_value(nvid1, svid1) < kGInfinityCost())
           os << std::left << std::setfill(' ') << std::setw(2) 
              << disp_ns_edge.at(i++%2);
         continue;
@@ -208,10 +219,10 @@ std::ostream& operator <<(std::ostream& os, const Hex &h) {
       nvid1 = h.get_node_pos(ns, ew);
       svid1 = h.get_node_pos(ns+1, ew-1);
       svid2 = h.get_node_pos(ns+1, ew);
-      if (h._g.get_edge_value(nvid1, svid1) < kGInfinityCost())
+      if (h._topo->get_edge_value(nvid1, svid1) < kGInfinityCost())
         os << std::left << std::setfill(' ') << std::setw(2) 
            << disp_ns_edge.at(i++%2);
-      if (h._g.get_edge_value(nvid1, svid2) < kGInfinityCost())
+      if (h._topo->get_edge_value(nvid1, svid2) < kGInfinityCost())
         os << std::left << std::setfill(' ') << std::setw(2) 
            << disp_ns_edge.at(i++%2);
     }
@@ -227,111 +238,111 @@ std::ostream& operator <<(std::ostream& os, const Hex &h) {
   return os;
 }
 
-void Hex::connect_corner_nodes(void) {
+void Hex::connect_corner_nodes(HexTopology *topo_p) {
   // connect corner nodes
   // 1. North West: 2 edges
-  _g.add_edge(get_node_pos(0, 0), 
-              get_node_pos(0, 1)); 
-  _g.add_edge(get_node_pos(0, 0), 
-              get_node_pos(1, 0));
+  topo_p->add_edge(get_node_pos(0, 0), 
+                   get_node_pos(0, 1)); 
+  topo_p->add_edge(get_node_pos(0, 0), 
+                   get_node_pos(1, 0));
   // 2. North East: 3 edges
-  _g.add_edge(get_node_pos(0, _dim-1), 
-              get_node_pos(0, _dim-2));
-  _g.add_edge(get_node_pos(0, _dim-1), 
-              get_node_pos(1, _dim-2));
-  _g.add_edge(get_node_pos(0, _dim-1), 
-              get_node_pos(1, _dim-1));
+  topo_p->add_edge(get_node_pos(0, _dim-1), 
+                   get_node_pos(0, _dim-2));
+  topo_p->add_edge(get_node_pos(0, _dim-1), 
+                   get_node_pos(1, _dim-2));
+  topo_p->add_edge(get_node_pos(0, _dim-1), 
+                   get_node_pos(1, _dim-1));
   // 3. South West: 3 edges
-  _g.add_edge(get_node_pos(_dim-1, 0),
-              get_node_pos(_dim-2, 0));
-  _g.add_edge(get_node_pos(_dim-1, 0),
-              get_node_pos(_dim-2, 1));
-  _g.add_edge(get_node_pos(_dim-1, 0),
-              get_node_pos(_dim-1, 1));
+  topo_p->add_edge(get_node_pos(_dim-1, 0),
+                   get_node_pos(_dim-2, 0));
+  topo_p->add_edge(get_node_pos(_dim-1, 0),
+                   get_node_pos(_dim-2, 1));
+  topo_p->add_edge(get_node_pos(_dim-1, 0),
+                   get_node_pos(_dim-1, 1));
   // 4. South East: 2 edges
-  _g.add_edge(get_node_pos(_dim-1, _dim-1), 
-              get_node_pos(_dim-1, _dim-2)); 
-  _g.add_edge(get_node_pos(_dim-1, _dim-1), 
-              get_node_pos(_dim-2, _dim-1));
+  topo_p->add_edge(get_node_pos(_dim-1, _dim-1), 
+                   get_node_pos(_dim-1, _dim-2)); 
+  topo_p->add_edge(get_node_pos(_dim-1, _dim-1), 
+                   get_node_pos(_dim-2, _dim-1));
   return;
 }
 
 // Connects the edges of all boundary nodes 
 // Ignore the very edges
-void Hex::connect_boundary_nodes(void) {
+void Hex::connect_boundary_nodes(HexTopology *topo_p) {
   // North Boundary (ns = 0): 
   // 4 edges from each node: west, east, south west, south east
   for (uint32_t ew = 1; ew < _dim -1; ++ew) {
-    _g.add_edge(get_node_pos(0, ew),
-                get_node_pos(0, ew-1));
-    _g.add_edge(get_node_pos(0, ew),
-                get_node_pos(0, ew+1));
-    _g.add_edge(get_node_pos(0, ew),
-                get_node_pos(1, ew-1));
-    _g.add_edge(get_node_pos(0, ew),
-                get_node_pos(1, ew));
+    topo_p->add_edge(get_node_pos(0, ew),
+                     get_node_pos(0, ew-1));
+    topo_p->add_edge(get_node_pos(0, ew),
+                     get_node_pos(0, ew+1));
+    topo_p->add_edge(get_node_pos(0, ew),
+                     get_node_pos(1, ew-1));
+    topo_p->add_edge(get_node_pos(0, ew),
+                     get_node_pos(1, ew));
   }
   
   // South Boundary (ns = _dim-1)
   // 4 edges from each node: west, east, north west, north east
   for (uint32_t ew = 1; ew < _dim -1; ++ew) {
-    _g.add_edge(get_node_pos(_dim-1, ew),
-                get_node_pos(_dim-1, ew-1));
-    _g.add_edge(get_node_pos(_dim-1, ew),
-                get_node_pos(_dim-1, ew+1));
-    _g.add_edge(get_node_pos(_dim-1, ew),
-                get_node_pos(_dim-2, ew));
-    _g.add_edge(get_node_pos(_dim-1, ew),
-                get_node_pos(_dim-2, ew+1));
+    topo_p->add_edge(get_node_pos(_dim-1, ew),
+                     get_node_pos(_dim-1, ew-1));
+    topo_p->add_edge(get_node_pos(_dim-1, ew),
+                     get_node_pos(_dim-1, ew+1));
+    topo_p->add_edge(get_node_pos(_dim-1, ew),
+                     get_node_pos(_dim-2, ew));
+    topo_p->add_edge(get_node_pos(_dim-1, ew),
+                     get_node_pos(_dim-2, ew+1));
   } 
 
   // West Boundary (ew = 0)
   // 4 edges from each node: north west, north east, east, south east
   for (uint32_t ns = 1; ns < _dim -1; ++ns) {
-    _g.add_edge(get_node_pos(ns, 0),
-                get_node_pos(ns-1, 0));
-    _g.add_edge(get_node_pos(ns, 0),
-                get_node_pos(ns-1, 1));
-    _g.add_edge(get_node_pos(ns, 0),
-                get_node_pos(ns, 1));
-    _g.add_edge(get_node_pos(ns, 0),
-                get_node_pos(ns+1, 0));
+    topo_p->add_edge(get_node_pos(ns, 0),
+                     get_node_pos(ns-1, 0));
+    topo_p->add_edge(get_node_pos(ns, 0),
+                     get_node_pos(ns-1, 1));
+    topo_p->add_edge(get_node_pos(ns, 0),
+                     get_node_pos(ns, 1));
+    topo_p->add_edge(get_node_pos(ns, 0),
+                     get_node_pos(ns+1, 0));
   }  
 
   // East Boundary (ew = _dim-1)
   // 4 edges from each node: north west, west, south west, south east
   for (uint32_t ns = 1; ns < _dim -1; ++ns) {
-    _g.add_edge(get_node_pos(ns, _dim-1),
-                get_node_pos(ns-1, _dim-1));
-    _g.add_edge(get_node_pos(ns, _dim-1),
-                get_node_pos(ns, _dim-2));
-    _g.add_edge(get_node_pos(ns, _dim-1),
-                get_node_pos(ns+1, _dim-2));
-    _g.add_edge(get_node_pos(ns, _dim-1),
-                get_node_pos(ns+1, _dim-1));
+    topo_p->add_edge(get_node_pos(ns, _dim-1),
+                     get_node_pos(ns-1, _dim-1));
+    topo_p->add_edge(get_node_pos(ns, _dim-1),
+                     get_node_pos(ns, _dim-2));
+    topo_p->add_edge(get_node_pos(ns, _dim-1),
+                     get_node_pos(ns+1, _dim-2));
+    topo_p->add_edge(get_node_pos(ns, _dim-1),
+                     get_node_pos(ns+1, _dim-1));
   }
 
   return;
 }
 
-void Hex::connect_internal_nodes(void) {
+void Hex::connect_internal_nodes(HexTopology *topo_p) {
   // 6 edges from each node: 
 
   // west, east, north west, north east, south west, south east
   for (uint32_t ns = 1; ns < _dim - 1; ++ns) {
     for (uint32_t ew = 1; ew < _dim -1; ++ew) {
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns, ew-1));
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns, ew+1));
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns-1, ew));
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns-1, ew+1));
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns+1, ew-1));
-      _g.add_edge(get_node_pos(ns, ew),
-                  get_node_pos(ns+1, ew));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns, ew-1));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns, ew+1));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns-1, ew));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns-1, ew+1));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns+1, ew-1));
+      topo_p->add_edge(get_node_pos(ns, ew),
+                       get_node_pos(ns+1, ew));
     }
   }
 
@@ -342,10 +353,12 @@ void Hex::connect_internal_nodes(void) {
 // occupy vid position on the hex board
 // Assumed: all sanity checks are done and the move is a legal move
 void Hex::set_next_move(uint32_t vid) {
-  State s = this->_g.get_vertex_attr(vid);
+  State s = get_node_state(vid);
   ++_state._last;
 
   _g.set_vertex_attr(vid, _state._last);
+  merge_groups(vid, _state._last);
+  _state._key ^= _zobrist->get_stone_key(vid, _state._last);
 
   DLOG(INFO) << "VertexId " << vid 
              << "(" << get_row(vid) << "," << get_col(vid) 
@@ -401,110 +414,35 @@ bool Hex::assess_positions(void) {
   return false;
 }
 
-// Assess whether player "blue" won the game
-bool Hex::did_blue_win(void) {
-  // ALGORITHM: DFS seeding all the vertices in the north border occupied by BLUE
-  // If any vertex during the DFS iteration occupies the south border then
-  // BLUE has won.
-  // WHY DFS (not BFS): DFS from each of the west border nodes ensures that
-  // were a path to exist from north to south, 
-  // on average we would hit the south border in around (_dim^2/2)/2 iterations.
-  // On the other hand BFS from each north border node would have 
-  // converged in (_dim^2/2 - _dim/2/2) iterations.
-  // 1. Add all vertices in the west border (ew == 0)
-  //    occupied by BLUE as the seed vertices to initiate DFS.
-  // 2. Initiate a DFS on these seed vertices
-  // 3. If any of the DFS traversal reaches the east border (ew == _dim-=)
-  //    BLUE has won
-  
-  GVertexIterSeed seed_v;
-  GVertexId  vid;
-  DLOG(INFO) << "Assess " << str_state(State::BLUE) << " won?" << std::endl; 
-  DLOG(INFO) << "Seed Vertices (# " << seed_v.size() << ")";
-  // 1. Add all vertices in the west border (ew == 0)
-  //    occupied by BLUE as the seed vertices to initiate DFS.
-  for (uint32_t ns=0; ns < _dim; ++ns) {
-    vid = get_node_pos(ns, 0);
-    if (_g.get_vertex_attr(vid) == State::BLUE) {
-      DLOG(INFO) << " " << Hex::disp_row(ns) << Hex::disp_col(0);
-      seed_v.push_back(vid);
-    }
-  }
-
-  // 2. Initiate a DFS on these seed vertices
-  uint32_t ew, i=0;
-  DLOG(INFO) << "Initiate DFS - vertices visited: ";
-  for (auto it = _g.vcbegin(GVertexIterType::DFS_ORDER, seed_v);
-       it != _g.vcend(GVertexIterType::DFS_ORDER); 
-       ++it, ++i) {
-    ew = get_col(*it);
-    DLOG(INFO) << " vid" << *it << " " 
-               << disp_row(get_row(*it)) << disp_col(ew)
-               << " state " << Hex::str_state(_g.get_vertex_attr(*it));
-    // 3. If any of the DFS traversal reaches the east border (col == _dim-=)
-    //    BLUE has won
-    if (ew == _dim-1)
-      return true;
-
-    // Sanity Check: no way should we be visiting more than the 
-    // maximum number of BLUE nodes possible in the graph
-    assert(i < ((_dim*_dim + 1)/2));
-  }
-
-  return false;
-}
-
-// Assess whether player "red" won the game
-bool Hex::did_red_win(void) {
-  // ALGORITHM: DFS seeding all the vertices in the north border occupied by RED
-  // If any vertex during the DFS iteration occupies the south border then
-  // RED has won.
-  // WHY DFS (not BFS): DFS from each of the north border nodes ensures that
-  // were a path to exist from north to south, 
-  // on average we would hit the south border in around (_dim^2/2)/2 iterations.
-  // On the other hand BFS from each north border node would have 
-  // converged in (_dim^2/2 - _dim/2/2) iterations.
-  // 1. Add all vertices in the north border (ns == 0)
-  //    occupied by RED as the seed vertices to initiate DFS.
-  // 2. Initiate a DFS on these seed vertices
-  // 3. If any of the DFS traversal reaches the south border (ns == _dim-1)
-  //    RED has won
-  
-  GVertexIterSeed seed_v;
-  GVertexId  vid;
-  DLOG(INFO) << "Assess " << str_state(State::BLUE) << " won?" << std::endl; 
-  DLOG(INFO) << "Seed Vertices (# " << seed_v.size() << ")";
-  // 1. Add all vertices in the north border (ns == 0)
-  //    occupied by RED as the seed vertices to initiate DFS.
-  for (uint32_t ew=0; ew < _dim; ++ew) {
-    vid = get_node_pos(0, ew);
-    if (_g.get_vertex_attr(vid) == State::RED) {
-      DLOG(INFO) << " " << Hex::disp_row(0) << Hex::disp_col(ew);
-      seed_v.push_back(vid);
-    }
+// Merge the group of a newly occupied position vid with the groups of
+// neighbors & sides (if any) of the same player
+void Hex::merge_groups(uint32_t vid, State s) {
+  // 1. BLUE connects West (ew == 0) to East (ew == _dim-1) & 
+  //    RED connects North (ns == 0) to South (ns == _dim-1)
+  if (s == State::BLUE) {
+    if (get_col(vid) == 0)
+      _fm.merge_set(vid, get_side_node(Side::WEST));
+    if (get_col(vid) == _dim-1)
+      _fm.merge_set(vid, get_side_node(Side::EAST));
+  } else {
+    if (get_row(vid) == 0)
+      _fm.merge_set(vid, get_side_node(Side::NORTH));
+    if (get_row(vid) == _dim-1)
+      _fm.merge_set(vid, get_side_node(Side::SOUTH));
   }
 
-  // 2. Initiate a DFS on these seed vertices
-  uint32_t ns, i=0;
-  DLOG(INFO) << "Initiate DFS - vertices visited: ";
-  for (auto it = _g.vcbegin(GVertexIterType::DFS_ORDER, seed_v);
-       it != _g.vcend(GVertexIterType::DFS_ORDER); 
-       ++it, ++i) {
-    ns = get_row(*it);
-    DLOG(INFO) << " vid" << *it << " " 
-               << disp_row(ns) << disp_col(get_col(*it))
-               << " state " << Hex::str_state(_g.get_vertex_attr(*it));
-    // 3. If any of the DFS traversal reaches the south border (ns == _dim-1)
-    //    BLUE has won
-    if (ns == _dim-1)
-      return true;
-
-    // Sanity Check: no way should we be visiting more than the 
-    // maximum number of RED nodes possible in the graph
-    assert(i < ((_dim*_dim + 1)/2));
+  // 2. Neighbors occupied by the same player: the board only yields
+  //    neighbors whose state matches vid. Neighbors are within _dim
+  //    positions of vid.
+  GVertexId nbr_end = std::min(vid + _dim + 1, _dim*_dim);
+  for (GVertexId nbr = _g.get_next_nbr(vid, (vid > _dim) ? vid - _dim : 0);
+       nbr < nbr_end; nbr = _g.get_next_nbr(vid, nbr + 1)) {
+    DLOG(INFO) << " merge vid " << vid << " nbr " << nbr
+               << " state " << Hex::str_state(s);
+    _fm.merge_set(vid, nbr);
   }
 
-  return false;
+  return;
 }
 
 //-----------------------------------------------------------------------------
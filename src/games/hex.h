@@ -20,18 +20,43 @@
 #include <fstream>          // std::ifstream & std::ofstream
 #include <functional>       // std::BinaryPredicate, std::equal_to
 #include <iostream>         // std::cout
+#include <memory>           // std::shared_ptr
+#include <string>           // std::string, std::to_string
+#include <utility>          // std::pair
 #include <vector>           // std::vector
 // C Standard Headers
 #include <cassert>
 // Local Headers
-#include "utils/egraph.h"
+#include "utils/graph.h"
+#include "utils/rollback_find_merge.h"
+#include "utils/vattr_overlay.h"
 
 namespace hexgame { namespace games {
 //-----------------------------------------------------------------------------
+// Each Position: Empty or taken by one of two players (Blue, Red)
+// Declared ahead of Hex (as Hex::State) so that the board eGraph may
+// index positions by state
+enum class HexPosState {EMPTY=0, BLUE, RED};
+} // namespace games {
+
+namespace utils {
+template <>
+struct eGraphAttrTraits<games::HexPosState> {
+  constexpr static uint32_t NUM_VALUES = 3; // Empty, Blue, and Red
+  static inline uint32_t index(const games::HexPosState &s) {
+    return static_cast<uint32_t>(s);
+  }
+};
+} // namespace utils {
+
+namespace games {
+// Keys of positions: hex_zobrist.h includes this header
+class HexZobrist;
+
 class Hex {
  public:
   // Each Position: Empty or taken by one of two players (Blue, Red)
-  enum class State {EMPTY=0, BLUE, RED};
+  using State = HexPosState;
 
   constexpr static uint32_t NUM_STATES = 3; // Empty, Blue, and Red
   constexpr static uint32_t NUM_PLAYERS = 2; // Blue and Red
@@ -50,9 +75,11 @@ class Hex {
   explicit Hex(uint32_t dimension = DEFAULT_DIMENSION);
   ~Hex() = default;
 
+  // Copy: shares the immutable board topology & copies the positions: O(V)
+  // (e.g. private board per worker thread)
+  Hex(const Hex&) = default;
   // Prevent unintended bad usage: 
-  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
-  Hex(const Hex&) = delete;
+  // Disallow: assignable or move ctor/assignable (C++11)
   Hex(Hex &&) = delete; // C++11 only
   void operator=(const Hex &) = delete;
   void operator=(Hex &&) = delete; // C++11 only
@@ -65,6 +92,13 @@ class Hex {
   // Returns INVALID position if the move_str is bad format or invalid
   int32_t get_node_pos_from_str(std::string move_str);
 
+  // Provides move_str (rowcol format e.g. A0) of the node position
+  inline std::string get_str_from_node_pos(uint32_t vid) const {
+    assert(vid < _dim*_dim);
+    return std::string(1, disp_row(vid / _dim)) +
+        std::to_string(disp_col(vid % _dim));
+  }
+
   // Return false if move for the next player is illegal
   // Otherwise: accept the move and modify state accordingly
   inline bool play_next_move(std::string move_str) {
@@ -103,6 +137,10 @@ class Hex {
   inline const Hex::State 
   get_last_player(void) const { return _state._last; }
 
+  // Zobrist key of the position (see HexZobrist): updated by every move
+  // & restored by restore_state
+  inline uint64_t get_key(void) const { return _state._key; }
+
   // Returns the next player that is due to play the next move
   // Cannot insert the function inlined as the compiler has not 
   // yet seen the ++ operator
@@ -112,9 +150,16 @@ class Hex {
   }
 
   // Save State & Restore State: used by MCHex to run "what if scenarios" without
-  // messing up current state of Hex
-  inline void save_state(void) { _g.save_state(); _save = _state; return; }
-  inline void restore_state(void) { _state = _save; _g.restore_state(); return; }
+  // messing up current state of Hex. Saves nest: the board, the state &
+  // the groups are pushed & popped together
+  inline void save_state(void) { 
+    _g.save_state(); _saves.emplace_back(_state, _fm.checkpoint()); return; 
+  }
+  inline void restore_state(void) { 
+    assert(!_saves.empty());
+    _state = _saves.back().first; _g.restore_state();
+    _fm.rollback(_saves.back().second); _saves.pop_back(); return; 
+  }
 
   // helper function to allow chained cout cmds: example
   // cout << "The Hex: " << endl << h << endl << "---------" << endl;
@@ -122,7 +167,14 @@ class Hex {
   
  protected:
  private:
-  using HexGraph = utils::eGraph<State>;
+  // Board: topology (adjacency) shared read-only by all copies of Hex &
+  // a private overlay of the position states
+  using HexTopology = utils::Graph<uint32_t>;
+  using HexBoard = utils::VAttrOverlay<State>;
+  // Virtual nodes of the 4 sides of the board: indices following the
+  // positions (_dim*_dim + side) in the union find of the groups
+  enum class Side {WEST=0, EAST, NORTH, SOUTH};
+  constexpr static uint32_t NUM_SIDES = 4;
   typedef struct _HexState {
     // round progresses to next value when both players have made their move
     uint32_t     _round; 
@@ -136,23 +188,54 @@ class Hex {
     // Local cached running variables
     uint32_t     _blue;  // number of positions occupied by blue
     uint32_t     _red;   // number of positions occupied by red
+    // Zobrist key: the empty board key xor the keys of the stones played
+    uint64_t     _key;
   } HexState;
 
   const uint32_t _dim;
-  HexGraph       _g;
+  std::shared_ptr<const HexTopology> _topo;
+  // Keys of the positions: shared read-only by all copies of Hex
+  std::shared_ptr<const HexZobrist>  _zobrist;
+  HexBoard       _g;
   HexState       _state;  
-  HexState       _save; 
+  // Groups of connected positions of the same player: a position only
+  // ever merges with neighbors of its own player, so groups of both
+  // players share one union find. A player has won when its two sides
+  // (virtual nodes) belong to the same group.
+  utils::RollbackFindMerge             _fm;
+  // Saved states & checkpoints of the groups: innermost save last
+  std::vector<std::pair<HexState, utils::RollbackFindMerge::Checkpoint>>
+                                       _saves;
 
   // PRIVATE METHODS
+  // Validates the dimension & builds the topology of the board
+  std::shared_ptr<const HexTopology> build_topology(void);
   // Create appropriate edges for the graph by connecting corner, boundary
   // and internal nodes
-  void connect_corner_nodes(void);
-  void connect_boundary_nodes(void);
-  void connect_internal_nodes(void);
-  // Assess whether player "blue" won the game
-  bool did_blue_win(void);
-  // Assess whether player "red" won the game
-  bool did_red_win(void);
+  void connect_corner_nodes(HexTopology *topo_p);
+  void connect_boundary_nodes(HexTopology *topo_p);
+  void connect_internal_nodes(HexTopology *topo_p);
+  // Merge the group of a newly occupied position vid with the groups of
+  // neighbors & sides (if any) of the same player
+  void merge_groups(uint32_t vid, State s);
+  // Assess whether player "blue" won the game: O(log V)
+  inline bool did_blue_win(void) const {
+    return _fm.same_set(get_side_node(Side::WEST), get_side_node(Side::EAST));
+  }
+  // Assess whether player "red" won the game: O(log V)
+  inline bool did_red_win(void) const {
+    return _fm.same_set(get_side_node(Side::NORTH), 
+                        get_side_node(Side::SOUTH));
+  }
+  // Index of the virtual node of the side in the union find
+  inline uint32_t get_side_node(Side side) const {
+    return _dim*_dim + static_cast<uint32_t>(side);
+  }
+  // State of the board position vid: read only access of the graph
+  // (the mutable accessor logs the attribute for restore_state)
+  inline State get_node_state(uint32_t vid) const {
+    return _g.get_vertex_attr(vid);
+  }
   // Given the row and column position, provide the overall vertex index 
   inline uint32_t get_node_pos(const uint32_t row, const uint32_t col) const {
     return (_dim*row + col);
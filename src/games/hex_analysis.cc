@@ -0,0 +1,171 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file hex_analysis.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: win ratio of every open position of a Hex board
+
+// Standard C++ Headers
+#include <algorithm>        // std::find, std::min, std::sort, std::swap
+#include <future>           // std::future
+#include <random>           // std::random_device
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_analysis.h"
+#include "games/hex_bitboard.h"
+#include "utils/confidence.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t HexAnalysis::DEFAULT_NUM_TRIALS;
+// End of Forward Declarations
+
+HexAnalysis::HexAnalysis(const uint32_t dimension,
+                         const bool     auto_test,
+                         const uint32_t num_threads,
+                         WorkStealingPool *pool) :
+    _dimension{dimension}, _auto_test{auto_test},
+    _own_pool{(pool == nullptr) ?
+              new WorkStealingPool(num_threads) : nullptr},
+    _pool{(pool == nullptr) ? _own_pool.get() : pool} {
+  // Private state of every worker
+  for (uint32_t w = 0; w < num_threads; ++w)
+    _workers.emplace_back(new MCWorker(dimension));
+
+  return;
+}
+
+//! @details Worker w owns the cells w, w + # workers, ... of the sorted
+//! open positions: the statistics of a cell are kept by its worker across
+//! rounds & gathered into the heatmap once a round ends.
+HexAnalysis::Heatmap
+HexAnalysis::analyze(const std::vector<uint32_t> &moves,
+                     const uint32_t num_moves,
+                     const uint32_t num_trials,
+                     const TimePoint deadline,
+                     const Callback &callback) {
+  uint32_t num_positions = _dimension*_dimension;
+  assert(moves.size() == num_positions && num_moves < num_positions);
+  std::vector<uint32_t> cells(moves.begin() + num_moves, moves.end());
+  std::sort(cells.begin(), cells.end());
+  Hex::State player = (num_moves % 2 == 0) ?
+                      Hex::State::BLUE : Hex::State::RED;
+
+  // Playouts start from a bitboard of the current position
+  HexBitBoard board(_dimension);
+  board.play_moves(moves.begin(), moves.begin() + num_moves,
+                   Hex::State::BLUE);
+  for (uint32_t w = 0; w < _workers.size(); ++w) {
+    MCWorker &worker = *_workers.at(w);
+    uint32_t seed = (_auto_test == true) ?
+                    FIXED_SEED_FOR_RANDOM_ENGINE + w:
+                    std::random_device{}();
+    worker.rnd_e.seed(seed);
+    worker.open = cells;
+    worker.num_wins.assign(cells.size(), 0);
+    worker.num_trials.assign(cells.size(), 0);
+    worker.batch.set_position(board);
+  }
+
+  Heatmap heatmap(cells.size());
+  for (uint32_t done = 0; done < num_trials; ) {
+    uint32_t round = std::min(num_trials - done, HexBatchEval::NUM_LANES);
+    std::vector<std::future<void>> results;
+    for (uint32_t w = 0; w < _workers.size(); ++w) {
+      results.push_back(_pool->submit(
+          [this, w, &cells, player, round, deadline]() {
+            return play_round(w, cells, player, round, deadline);
+          }));
+    }
+    for (auto &r : results)
+      _pool->get(r);
+    done += round;
+
+    for (uint32_t i = 0; i < cells.size(); ++i) {
+      const MCWorker &worker = *_workers.at(i % _workers.size());
+      Cell &c = heatmap.at(i);
+      c.move = cells.at(i);
+      c.num_trials = worker.num_trials.at(i);
+      c.num_wins = worker.num_wins.at(i);
+      c.win_ratio = (c.num_trials > 0) ?
+                    static_cast<double>(c.num_wins)/c.num_trials : 0;
+      wilson_interval(c.num_wins, c.num_trials, CONFIDENCE_Z,
+                      &c.low, &c.high);
+    }
+    DLOG(INFO) << "HexAnalysis: # moves " << num_moves << ": # trials "
+               << done << "/" << num_trials;
+
+    if ((callback && !callback(heatmap, done)) ||
+        TimeManager::is_expired(deadline))
+      break;
+  }
+
+  return heatmap;
+}
+
+//! @details A playout of a cell occupies the cell for the player due &
+//! the rest of the open positions alternately in a random order: the
+//! playouts of a cell are played in the lanes of a batch & decided
+//! together. The deadline is checked after every cell.
+//! @param[in] w index of the worker
+//! @param[in] cells open positions in increasing order
+//! @param[in] player player due to play
+//! @param[in] num_trials # of playouts of every cell of the worker
+//! @param[in] deadline time by when the round ends
+void HexAnalysis::play_round(uint32_t w, const std::vector<uint32_t> &cells,
+                             Hex::State player, uint32_t num_trials,
+                             TimePoint deadline) {
+  MCWorker &worker = *_workers.at(w);
+  assert(num_trials <= HexBatchEval::NUM_LANES);
+  HexBatchEval::Lanes used = (num_trials < HexBatchEval::NUM_LANES) ?
+      (static_cast<HexBatchEval::Lanes>(1) << num_trials) - 1 :
+      ~static_cast<HexBatchEval::Lanes>(0);
+
+  for (uint32_t i = w; i < cells.size(); i += _workers.size()) {
+    // The cell goes first: the rest follow in a random order per lane
+    auto it = std::find(worker.open.begin(), worker.open.end(), cells.at(i));
+    std::swap(*worker.open.begin(), *it);
+    for (uint32_t lane = 0; lane < num_trials; ++lane) {
+      worker.rnd_e.shuffle(worker.open.begin() + 1, worker.open.end());
+      worker.batch.play_moves(lane, worker.open.begin(), worker.open.end(),
+                              player);
+    }
+    HexBatchEval::Lanes blue_won = worker.batch.get_blue_wins();
+    worker.batch.clear();
+    // On a full board RED won every lane that BLUE did not
+    HexBatchEval::Lanes won = (player == Hex::State::BLUE) ?
+                              (blue_won & used) : (~blue_won & used);
+    worker.num_wins.at(i) += __builtin_popcountll(won);
+    worker.num_trials.at(i) += num_trials;
+
+    if (TimeManager::is_expired(deadline))
+      break;
+  }
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
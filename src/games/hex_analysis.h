@@ -0,0 +1,157 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     hex_analysis.h
+//! @brief    Definition: win ratio of every open position of a Hex board
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _HEX_ANALYSIS_H_
+#define _HEX_ANALYSIS_H_
+// C++ Standard Headers
+#include <functional>       // std::function
+#include <memory>           // std::unique_ptr
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_batch_eval.h"
+#include "games/time_manager.h"
+#include "utils/random.h"
+#include "utils/work_stealing_pool.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    HexAnalysis
+//! @brief    Whole board analysis: win ratio & its confidence interval for
+//!           every open position as the next move of the player due
+//! @details  The analysis proceeds in rounds: every round gives each open
+//!           position a batch of up to HexBatchEval::NUM_LANES random
+//!           playouts with the position as next move. The open positions
+//!           are shared among the workers (root parallel: private moves,
+//!           random stream & board). The heatmap of all positions is
+//!           handed to the callback after every round (on the calling
+//!           thread) so callers display it while it refines. The analysis
+//!           ends once every position has num_trials playouts, the
+//!           deadline passes or the callback returns false. A deadline
+//!           may cut the last round short: positions then differ in # of
+//!           playouts & their intervals show it.
+//!           Confidence interval: Wilson score interval at
+//!           utils::CONFIDENCE_Z.
+//! EXAMPLE USAGE:
+//!   HexAnalysis analysis(11, false, 4);
+//!   HexAnalysis::Heatmap map = analysis.analyze(
+//!       moves, num_moves, 1000, deadline,
+//!       [](const HexAnalysis::Heatmap &m, uint32_t num_trials) {
+//!         display(m); return true;
+//!       });
+class HexAnalysis {
+ public:
+  using TimePoint = TimeManager::TimePoint;
+  //! Default # of playouts of every open position
+  constexpr static uint32_t DEFAULT_NUM_TRIALS = 1000;
+
+  //! Playouts of an open position as next move
+  struct Cell {
+    uint32_t move;       //!< open position
+    uint32_t num_trials; //!< # playouts
+    uint32_t num_wins;   //!< # of those won by the player due
+    double   win_ratio;  //!< num_wins/num_trials: 0 without playouts
+    double   low;        //!< lower bound of the confidence interval
+    double   high;       //!< upper bound of the confidence interval
+  };
+  //! Every open position in increasing order of position
+  using Heatmap = std::vector<Cell>;
+  //! Called after every round with the heatmap so far & the # of playouts
+  //! per position of the rounds completed: false ends the analysis
+  using Callback = std::function<bool(const Heatmap &heatmap,
+                                      uint32_t num_trials)>;
+
+  //! @param[in] dimension # rows/columns used for Hex Game
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_threads # of workers sharing the open positions
+  //! @param[in] pool threads running the workers: nullptr gives the analysis
+  //!            a pool of num_threads threads. A shared pool must outlive
+  //!            the analysis
+  HexAnalysis(const uint32_t dimension,
+              const bool     auto_test,
+              const uint32_t num_threads,
+              utils::WorkStealingPool *pool = nullptr);
+  ~HexAnalysis() = default;
+
+  //! @brief Heatmap of the open positions for the player due to play
+  //! @param[in] moves moves played so far (BLUE first & players alternate)
+  //!            followed by the open positions
+  //! @param[in] num_moves # of moves played so far
+  //! @param[in] num_trials # of playouts of every open position
+  //! @param[in] deadline analysis ends once deadline passes
+  //! @param[in] callback called after every round (if any)
+  //! @return heatmap of the last round
+  Heatmap analyze(const std::vector<uint32_t> &moves,
+                  const uint32_t num_moves,
+                  const uint32_t num_trials,
+                  const TimePoint deadline,
+                  const Callback &callback = Callback());
+
+  HexAnalysis(const HexAnalysis &)    = delete; //!< @brief disallow copy ctor
+  HexAnalysis(HexAnalysis &&)         = delete; //!< @brief disallow move ctor
+  void operator=(const HexAnalysis &) = delete; //!< @brief disallow assignment
+  void operator=(HexAnalysis &&)      = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  //! Fixed seed generates predictable runs when running test SW or debugging
+  const static uint32_t FIXED_SEED_FOR_RANDOM_ENGINE = 13607;
+
+  //! @brief Private state of a worker
+  //! @details playouts of a worker never touch other workers
+  struct MCWorker {
+    explicit MCWorker(uint32_t dimension) : batch(dimension) {}
+    std::vector<uint32_t>      open;      //!< open positions: permuted
+    std::vector<uint32_t>      num_wins;  //!< wins of every cell index
+    std::vector<uint32_t>      num_trials;//!< playouts of every cell index
+    utils::FastRandom          rnd_e;     //!< private random stream
+    HexBatchEval               batch;     //!< private board of playouts
+  };
+
+  const uint32_t        _dimension;
+  const bool            _auto_test;
+  //! pool owned by the analysis: nullptr when the pool is shared
+  std::unique_ptr<utils::WorkStealingPool> _own_pool;
+  //! threads running the workers
+  utils::WorkStealingPool *_pool;
+  std::vector<std::unique_ptr<MCWorker>> _workers;
+
+  //! @brief Worker w plays a round of num_trials playouts of its cells
+  void play_round(uint32_t w, const std::vector<uint32_t> &cells,
+                  Hex::State player, uint32_t num_trials,
+                  TimePoint deadline);
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _HEX_ANALYSIS_H_
@@ -0,0 +1,241 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file hex_analyze.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Whole board analysis of a Hex position: the best positions so
+//! far are printed after every round & the win ratio (%) of every open
+//! position once the analysis ends e.g.
+//! > ./bin/hex_analyze --dimension=11 --moves="F5 E6" --num_trials=2000
+
+// C++ Standard Headers
+#include <algorithm>        // std::min, std::sort
+#include <chrono>           // std::chrono::seconds
+#include <exception>        // std::exception
+#include <iomanip>          // std::setw
+#include <iostream>         // std::cout
+#include <sstream>          // std::stringstream
+#include <string>           // std::string
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cctype>           // std::toupper
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_analysis.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace hexgame::games;
+using namespace std;
+
+// Flag Declarations
+DECLARE_bool(auto_test);
+DECLARE_int32(dimension);
+DECLARE_string(moves);
+DECLARE_int32(num_trials);
+DECLARE_int32(threads);
+DECLARE_int32(time);
+DECLARE_int32(num_best);
+
+// Cells of the heatmap from the best win ratio down
+static std::vector<HexAnalysis::Cell>
+Ranked(const HexAnalysis::Heatmap &heatmap) {
+  std::vector<HexAnalysis::Cell> ranked(heatmap);
+  std::sort(ranked.begin(), ranked.end(),
+            [](const HexAnalysis::Cell &a, const HexAnalysis::Cell &b) {
+              return a.win_ratio > b.win_ratio ||
+                  (a.win_ratio == b.win_ratio && a.move < b.move);
+            });
+  return ranked;
+}
+
+// "F5 57.3% [55.1%, 59.4%]"
+static std::string Str(const Hex &h, const HexAnalysis::Cell &c) {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1)
+     << h.get_str_from_node_pos(c.move) << " " << 100*c.win_ratio
+     << "% [" << 100*c.low << "%, " << 100*c.high << "%]";
+  return ss.str();
+}
+
+// Board laid out as displayed by Hex: stones of BLUE (X) & RED (#) &
+// the win ratio (%) of every open position
+static void PrintHeatmap(const Hex &h, const std::vector<uint32_t> &moves,
+                         uint32_t num_moves,
+                         const HexAnalysis::Heatmap &heatmap) {
+  uint32_t dim = FLAGS_dimension;
+  std::vector<std::string> disp(dim*dim);
+  for (uint32_t i = 0; i < num_moves; ++i)
+    disp.at(moves.at(i)) = (i % 2 == 0) ? "X" : "#";
+  for (const HexAnalysis::Cell &c : heatmap)
+    disp.at(c.move) = std::to_string(
+        static_cast<uint32_t>(100*c.win_ratio + 0.5));
+
+  std::cout << ' ';
+  for (uint32_t ew = 0; ew < dim; ++ew)
+    std::cout << std::left << std::setw(4) << ew;
+  std::cout << std::endl;
+  for (uint32_t ns = 0; ns < dim; ++ns) {
+    std::cout << std::right << std::setw(ns*2 + 1)
+              << static_cast<char>('A' + ns);
+    for (uint32_t ew = 0; ew < dim; ++ew)
+      std::cout << std::right << std::setw(4) << disp.at(ns*dim + ew);
+    std::cout << std::endl;
+  }
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "hex_analyze called: "
+             << "dimension " << FLAGS_dimension
+             << ": moves \"" << FLAGS_moves << "\""
+             << ": num_trials " << FLAGS_num_trials
+             << ": threads " << FLAGS_threads
+             << ": time " << FLAGS_time;
+
+  try {
+    uint32_t dim = FLAGS_dimension;
+    Hex h(dim);
+    std::vector<uint32_t> moves(dim*dim);
+    for (uint32_t i = 0; i < moves.size(); ++i)
+      moves.at(i) = i;
+    uint32_t num_moves = 0;
+    std::string moves_str(FLAGS_moves);
+    for (auto &ch : moves_str)
+      ch = (ch == ',') ? ' ' : std::toupper(ch);
+    std::istringstream iss(moves_str);
+    std::string move_str;
+    while (iss >> move_str) {
+      int32_t vid = h.get_node_pos_from_str(move_str);
+      if (vid < 0)
+        throw "illegal move " + move_str;
+      h.set_next_move(vid);
+      h.assess_positions();
+      std::swap(moves.at(num_moves),
+                *std::find(moves.begin() + num_moves, moves.end(), vid));
+      ++num_moves;
+    }
+    if (h.is_play_over())
+      throw std::string("game over: nothing to analyze");
+
+    std::cout << "Analysis: " << ((num_moves % 2 == 0) ? "BLUE" : "RED")
+              << " to play: " << dim*dim - num_moves << " open positions"
+              << std::endl;
+    HexAnalysis analysis(dim, FLAGS_auto_test, FLAGS_threads);
+    TimeManager::TimePoint deadline =
+        TimeManager::Clock::now() + std::chrono::seconds(FLAGS_time);
+    HexAnalysis::Heatmap heatmap = analysis.analyze(
+        moves, num_moves, FLAGS_num_trials, deadline,
+        [&h](const HexAnalysis::Heatmap &m, uint32_t num_trials) {
+          std::vector<HexAnalysis::Cell> ranked = Ranked(m);
+          std::cout << "# trials " << std::setw(6) << num_trials << ":";
+          uint32_t num_best = std::min<uint32_t>(FLAGS_num_best,
+                                                 ranked.size());
+          for (uint32_t i = 0; i < num_best; ++i)
+            std::cout << " " << Str(h, ranked.at(i));
+          std::cout << std::endl;
+          return true;
+        });
+
+    PrintHeatmap(h, moves, num_moves, heatmap);
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+    return 1;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+DEFINE_bool(auto_test, false,
+            "same seed for random number generation: runs are replayable");
+
+DEFINE_int32(dimension, 11,
+             "# rows/columns of the Hex board");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_string(moves, "",
+              "moves played so far (BLUE first) separated by space or comma "
+              "in rowcol format e.g. \"F5 E6\"");
+
+DEFINE_int32(num_trials, HexAnalysis::DEFAULT_NUM_TRIALS,
+             "# of playouts of every open position");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_int32(threads, 1,
+             "# of threads sharing the open positions");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_int32(time, 60,
+             "max secs of the analysis");
+static bool ValidateTime(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+time_dummy = google::RegisterFlagValidator(&FLAGS_time, &ValidateTime);
+
+DEFINE_int32(num_best, 3,
+             "# of best positions printed after every round");
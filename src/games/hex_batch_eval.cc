@@ -0,0 +1,111 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <iostream>
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_batch_eval.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t HexBatchEval::NUM_LANES;
+constexpr uint32_t HexBatchEval::NUM_NBRS;
+// End of Forward Declarations
+
+HexBatchEval::HexBatchEval(uint32_t dimension) :
+    _dim(dimension), _num_positions(dimension*dimension),
+    _nbrs(_num_positions), _base(_num_positions, 0),
+    _blue(_num_positions, 0), _fill(_num_positions + 1, 0) {
+  if (_dim < Hex::MIN_DIMENSION || _dim > Hex::MAX_DIMENSION) {
+    std::stringstream ss;
+    ss << "HexBatchEval: Game dimension " << _dim
+       << ": accepted-range 26 >= dimension >=3";
+    throw ss.str();
+  }
+  // west, east, north west, north east, south west, south east
+  const int32_t d_ns[NUM_NBRS] = { 0, 0, -1, -1, 1, 1};
+  const int32_t d_ew[NUM_NBRS] = {-1, 1,  0,  1, -1, 0};
+  int32_t dim = _dim;
+  for (int32_t ns = 0; ns < dim; ++ns) {
+    for (int32_t ew = 0; ew < dim; ++ew) {
+      for (uint32_t k = 0; k < NUM_NBRS; ++k) {
+        int32_t ns2 = ns + d_ns[k], ew2 = ew + d_ew[k];
+        bool valid = (ns2 >= 0 && ns2 < dim && ew2 >= 0 && ew2 < dim);
+        _nbrs[ns*dim + ew][k] = valid ? (ns2*dim + ew2) : _num_positions;
+      }
+    }
+  }
+
+  return;
+}
+
+// Position common to all lanes: subsequent batches start from here
+void HexBatchEval::set_position(const HexBitBoard &b) {
+  assert(b.get_dimension() == _dim);
+  for (uint32_t vid = 0; vid < _num_positions; ++vid)
+    _base[vid] = (b.get_state(vid) == State::BLUE) ? 
+                 ~static_cast<Lanes>(0) : 0;
+  clear();
+
+  return;
+}
+
+// Lanes where BLUE connected West to East: RED won the remaining lanes
+HexBatchEval::Lanes HexBatchEval::get_blue_wins(void) {
+  // 1. Seed: BLUE positions on the West side
+  for (uint32_t vid = 0; vid < _num_positions; ++vid)
+    _fill[vid] = (vid % _dim == 0) ? _blue[vid] : 0;
+
+  // 2. Sweep forward & backward until no fill changes: a forward sweep
+  //    carries fills along East & South in one go, a backward sweep along
+  //    West & North
+  uint32_t num_sweeps = 0;
+  for (Lanes changed = ~static_cast<Lanes>(0); changed != 0; ++num_sweeps) {
+    changed = 0;
+    bool forward = (num_sweeps % 2 == 0);
+    for (uint32_t i = 0; i < _num_positions; ++i) {
+      uint32_t vid = forward ? i : _num_positions - 1 - i;
+      const std::array<uint32_t, NUM_NBRS> &n = _nbrs[vid];
+      Lanes reach = _fill[n[0]] | _fill[n[1]] | _fill[n[2]] |
+                    _fill[n[3]] | _fill[n[4]] | _fill[n[5]];
+      Lanes fill = _fill[vid] | (reach & _blue[vid]);
+      changed |= fill ^ _fill[vid];
+      _fill[vid] = fill;
+    }
+  }
+
+  // 3. BLUE won the lanes that reach the East side
+  Lanes won = 0;
+  for (uint32_t ns = 0; ns < _dim; ++ns)
+    won |= _fill[ns*_dim + _dim - 1];
+
+  DLOG(INFO) << "HexBatchEval: # sweeps " << num_sweeps
+             << ": # BLUE wins " << __builtin_popcountll(won);
+
+  return won;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
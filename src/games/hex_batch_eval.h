@@ -0,0 +1,111 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+//
+// Class HexBatchEval:
+// DESCRIPTION:
+//   Decides the winners of NUM_LANES fully occupied Hex boards (playouts)
+//   together. Boards are bit-sliced: one word per position where bit i
+//   (lane i) is set when BLUE occupies the position in playout i. On a
+//   full board RED occupies every other position, so only BLUE positions
+//   are recorded & RED won every lane BLUE did not.
+//   Flood fill: the fill of a position is the set of lanes where BLUE
+//   reaches it from West. Sweeps alternate forward & backward over the
+//   positions, each position ORing the fill of its (up to 6) neighbors
+//   & masking with its BLUE lanes, until no fill changes. Every word
+//   operation advances all NUM_LANES playouts at once.
+// EXAMPLE USAGE:
+//   HexBatchEval eval(11);
+//   eval.set_position(board);   // position common to all the playouts
+//   for (lane...) eval.play_moves(lane, first, last, next_player);
+//   HexBatchEval::Lanes blue_won = eval.get_blue_wins();
+//   eval.clear();               // back to position for the next batch
+
+#ifndef _HEX_BATCH_EVAL_H_
+#define _HEX_BATCH_EVAL_H_
+// C++ Standard Headers
+#include <array>            // std::array
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_bitboard.h"
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+class HexBatchEval {
+ public:
+  using State = Hex::State;
+  using Lanes = uint64_t;
+  constexpr static uint32_t NUM_LANES = 64;
+
+  explicit HexBatchEval(uint32_t dimension = Hex::DEFAULT_DIMENSION);
+  ~HexBatchEval() = default;
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  HexBatchEval(const HexBatchEval &) = delete;
+  HexBatchEval(HexBatchEval &&) = delete; // C++11 only
+  void operator=(const HexBatchEval &) = delete;
+  void operator=(HexBatchEval &&) = delete; // C++11 only
+
+  // Position common to all lanes: subsequent batches start from here
+  void set_position(const HexBitBoard &b);
+
+  // Lanes back to the common position
+  inline void clear(void) { _blue = _base; return; }
+
+  // Occupy positions [first, last) of lane alternately starting with
+  // player s: completes the playout of the lane
+  template <typename InputIt>
+  inline void play_moves(uint32_t lane, InputIt first, InputIt last,
+                         State s) {
+    assert(lane < NUM_LANES);
+    Lanes bit = static_cast<Lanes>(1) << lane;
+    // BLUE occupies every other position starting with the first or second
+    if (s != State::BLUE && first != last)
+      ++first;
+    while (first != last) {
+      assert(*first < _num_positions);
+      _blue[*first] |= bit;
+      if (++first == last)
+        break;
+      ++first;
+    }
+    return;
+  }
+
+  // Lanes where BLUE connected West to East: RED won the remaining lanes
+  Lanes get_blue_wins(void);
+
+ protected:
+ private:
+  constexpr static uint32_t NUM_NBRS = 6;
+  const uint32_t       _dim;
+  const uint32_t       _num_positions;
+  // neighbors of each position: missing neighbors point to the sentinel
+  // position _num_positions whose fill is always empty
+  std::vector<std::array<uint32_t, NUM_NBRS>> _nbrs;
+  std::vector<Lanes>   _base;  // BLUE lanes of the common position
+  std::vector<Lanes>   _blue;  // BLUE lanes of every position
+  std::vector<Lanes>   _fill;  // lanes where BLUE reaches the position
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
+
+#endif // _HEX_BATCH_EVAL_H_
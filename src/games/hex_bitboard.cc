@@ -0,0 +1,143 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <iostream>
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+// Local Headers
+#include "games/hex_bitboard.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t HexBitBoard::MAX_NUM_POSITIONS;
+constexpr uint32_t HexBitBoard::NUM_WORDS;
+// End of Forward Declarations
+
+HexBitBoard::HexBitBoard(uint32_t dimension) :
+    _dim(dimension), _num_words((dimension*dimension + 63)/64),
+    _stones{}, _first_col{}, _last_col{}, _first_row{}, _last_row{} {
+  if (_dim < Hex::MIN_DIMENSION || _dim > Hex::MAX_DIMENSION) {
+    std::stringstream ss;
+    ss << "HexBitBoard: Game dimension " << _dim
+       << ": accepted-range 26 >= dimension >=3";
+    throw ss.str();
+  }
+  for (uint32_t i = 0; i < _dim; ++i) {
+    uint32_t vid;
+    vid = i*_dim;                // (i, 0)
+    _first_col[vid >> 6] |= (1ULL << (vid & 63));
+    vid = i*_dim + _dim - 1;     // (i, _dim-1)
+    _last_col[vid >> 6] |= (1ULL << (vid & 63));
+    vid = i;                     // (0, i)
+    _first_row[vid >> 6] |= (1ULL << (vid & 63));
+    vid = (_dim - 1)*_dim + i;   // (_dim-1, i)
+    _last_row[vid >> 6] |= (1ULL << (vid & 63));
+  }
+
+  return;
+}
+
+// true when stones of player s connect both its sides:
+// BLUE West to East, RED North to South
+bool HexBitBoard::is_connected(State s) const {
+  const Bits &stones = _stones[player(s)];
+  const Bits &first  = (s == State::BLUE) ? _first_col : _first_row;
+  const Bits &last   = (s == State::BLUE) ? _last_col : _last_row;
+  const Bits none{};
+
+  // 1. Seed: stones on the first side
+  Bits fill;
+  uint64_t any = 0;
+  for (uint32_t i = 0; i < _num_words; ++i) {
+    fill[i] = stones[i] & first[i];
+    any |= fill[i];
+  }
+  if (any == 0)
+    return false;
+
+  // 2. Grow the fill by its neighbors that are stones of the player until
+  //    it reaches the last side or stops growing
+  for (;;) {
+    Bits grow = fill;
+    // east & south west: a position on the last (first) col wraps around
+    // to the first (last) col of the next row
+    shift_up(fill, 1, _first_col, &grow);
+    shift_up(fill, _dim - 1, _last_col, &grow);
+    shift_up(fill, _dim, none, &grow);
+    // west & north east: mirror image of the above
+    shift_down(fill, 1, _last_col, &grow);
+    shift_down(fill, _dim - 1, _first_col, &grow);
+    shift_down(fill, _dim, none, &grow);
+
+    uint64_t reached = 0, changed = 0;
+    for (uint32_t i = 0; i < _num_words; ++i) {
+      grow[i] &= stones[i];
+      reached |= grow[i] & last[i];
+      changed |= grow[i] ^ fill[i];
+      fill[i] = grow[i];
+    }
+    if (reached != 0)
+      return true;
+    if (changed == 0)
+      return false;
+  }
+}
+
+void HexBitBoard::shift_up(const Bits &b, uint32_t k, const Bits &mask,
+                           Bits *acc_p) const {
+  assert(k > 0 && k < 64);
+  uint64_t carry = 0;
+  for (uint32_t i = 0; i < _num_words; ++i) {
+    (*acc_p)[i] |= ((b[i] << k) | carry) & ~mask[i];
+    carry = b[i] >> (64 - k);
+  }
+  return;
+}
+
+void HexBitBoard::shift_down(const Bits &b, uint32_t k, const Bits &mask,
+                             Bits *acc_p) const {
+  assert(k > 0 && k < 64);
+  uint64_t carry = 0;
+  for (uint32_t i = _num_words; i-- > 0; ) {
+    (*acc_p)[i] |= ((b[i] >> k) | carry) & ~mask[i];
+    carry = b[i] << (64 - k);
+  }
+  return;
+}
+
+std::ostream& operator << (std::ostream& os, const HexBitBoard &b) {
+  std::array<char, Hex::NUM_STATES> disp_state = {{'.', 'X', '#'}};
+  for (uint32_t ns = 0; ns < b._dim; ++ns) {
+    os << std::string(ns, ' ');
+    for (uint32_t ew = 0; ew < b._dim; ++ew) {
+      Hex::State s = b.get_state(ns*b._dim + ew);
+      os << disp_state.at(static_cast<std::size_t>(s)) << ' ';
+    }
+    os << std::endl;
+  }
+
+  return os;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
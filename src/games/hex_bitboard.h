@@ -0,0 +1,138 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+//
+// Class HexBitBoard:
+// DESCRIPTION:
+//   Hex positions as bitboards: one bit per position (vid = ns*dim + ew,
+//   the same numbering as Hex) & one bitboard per player. Boards up to
+//   MAX_DIMENSION fit in NUM_WORDS 64 bit words: a board is a few hundred
+//   bytes, cheap to copy per playout & resident in L1.
+//   Connectivity: hex adjacency is a fixed stencil. The 6 neighbors of
+//   vid are vid -/+ 1 (west/east), vid - dim, vid - dim + 1 (north west/
+//   north east) & vid + dim - 1, vid + dim (south west/south east). A
+//   flood fill grows the stones of a player connected to its first side
+//   by shifting the fill in all 6 directions at once (masking columns that
+//   wrap around rows) & masking with the stones of the player. The player
+//   has won once the fill reaches its second side.
+// EXAMPLE USAGE:
+//   HexBitBoard b(11);
+//   b.play_moves(moves.begin(), moves.end(), Hex::State::BLUE);
+//   if (b.get_winner() == Hex::State::BLUE) ...
+
+#ifndef _HEX_BITBOARD_H_
+#define _HEX_BITBOARD_H_
+// C++ Standard Headers
+#include <array>            // std::array
+#include <iostream>         // std::cout
+// C Standard Headers
+#include <cassert>
+// Local Headers
+#include "games/hex.h"
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+class HexBitBoard {
+ public:
+  using State = Hex::State;
+  constexpr static uint32_t MAX_NUM_POSITIONS =
+      Hex::MAX_DIMENSION*Hex::MAX_DIMENSION;
+  constexpr static uint32_t NUM_WORDS = (MAX_NUM_POSITIONS + 63)/64;
+  using Bits = std::array<uint64_t, NUM_WORDS>;
+
+  explicit HexBitBoard(uint32_t dimension = Hex::DEFAULT_DIMENSION);
+  ~HexBitBoard() = default;
+
+  // Copy & assignment allowed: a board is a plain value of a few hundred
+  // bytes e.g. copied afresh from the current position for every playout
+  HexBitBoard(const HexBitBoard &) = default;
+  HexBitBoard& operator=(const HexBitBoard &) = default;
+
+  inline uint32_t get_dimension(void) const { return _dim; }
+
+  inline State get_state(uint32_t vid) const {
+    assert(vid < _dim*_dim);
+    if (is_set(_stones[player(State::BLUE)], vid))
+      return State::BLUE;
+    if (is_set(_stones[player(State::RED)], vid))
+      return State::RED;
+    return State::EMPTY;
+  }
+
+  // Occupy an empty position vid by player s
+  inline void set_state(uint32_t vid, State s) {
+    assert(vid < _dim*_dim);
+    assert(s != State::EMPTY && get_state(vid) == State::EMPTY);
+    _stones[player(s)][vid >> 6] |= (1ULL << (vid & 63));
+    return;
+  }
+
+  // Occupy positions [first, last) alternately starting with player s
+  template <typename InputIt>
+  inline void play_moves(InputIt first, InputIt last, State s) {
+    uint32_t p = player(s);
+    for (; first != last; ++first, p ^= 1) {
+      assert(get_state(*first) == State::EMPTY);
+      _stones[p][*first >> 6] |= (1ULL << (*first & 63));
+    }
+    return;
+  }
+
+  // true when stones of player s connect both its sides:
+  // BLUE West to East, RED North to South
+  bool is_connected(State s) const;
+
+  // Winner (EMPTY if none): on a fully occupied board exactly one player
+  // has connected its sides
+  inline State get_winner(void) const {
+    if (is_connected(State::BLUE))
+      return State::BLUE;
+    if (is_connected(State::RED))
+      return State::RED;
+    return State::EMPTY;
+  }
+
+  friend std::ostream& operator << (std::ostream& os, const HexBitBoard &b);
+
+ protected:
+ private:
+  uint32_t _dim;
+  uint32_t _num_words;     // # of words in use: (_dim*_dim + 63)/64
+  Bits     _stones[Hex::NUM_PLAYERS]; // positions occupied by BLUE & RED
+  Bits     _first_col;     // West side
+  Bits     _last_col;      // East side
+  Bits     _first_row;     // North side
+  Bits     _last_row;      // South side
+
+  // index of the bitboard of player s: BLUE 0, RED 1
+  static inline uint32_t player(State s) {
+    assert(s != State::EMPTY);
+    return static_cast<uint32_t>(s) - 1;
+  }
+  static inline bool is_set(const Bits &b, uint32_t vid) {
+    return (b[vid >> 6] >> (vid & 63)) & 1;
+  }
+  // Shifts the positions of b from vid to vid + k (shift_up) or to
+  // vid - k (shift_down) & adds them to acc after clearing mask: 0 < k < 64
+  void shift_up(const Bits &b, uint32_t k, const Bits &mask, Bits *acc_p) const;
+  void shift_down(const Bits &b, uint32_t k, const Bits &mask,
+                  Bits *acc_p) const;
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
+
+#endif // _HEX_BITBOARD_H_
@@ -0,0 +1,255 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file hex_book_gen.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Generates the opening book of MCHex offline: every early position
+//! SW may face is searched deeply & its best move written to a book file.
+
+// C++ Standard Headers
+#include <chrono>           // std::chrono::hours
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <memory>           // std::unique_ptr
+#include <unordered_map>    // std::unordered_map
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>          // assert
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_zobrist.h"
+#include "games/mc_flat.h"
+#include "games/opening_book.h"
+#include "games/time_manager.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace hexgame::games;
+using namespace std;
+
+// Flag Declarations
+DECLARE_bool(auto_test);
+DECLARE_string(output_dir);
+DECLARE_int32(dimension);
+DECLARE_int32(max_moves);
+DECLARE_int32(num_trials);
+DECLARE_int32(threads);
+
+//! Visits every position of up to max_moves moves where SW (either player)
+//! is due to move: SW plays its book move & the opponent every open
+//! position. Positions not yet in the book are searched by strategy.
+//! A Hex board rotated by 180 degrees is the same game (each player keeps
+//! its pair of sides): the rotated position & move enter the book too.
+class BookGenerator {
+ public:
+  using Entry = OpeningBook::Entry;
+  BookGenerator(uint32_t dimension, uint32_t max_moves,
+                MCStrategy *strategy_p) :
+      _dim{dimension}, _max_moves{max_moves}, _strategy_p{strategy_p},
+      _zobrist(dimension), _moves(dimension*dimension), _num_searches{0} {
+    for (uint32_t i = 0; i < _moves.size(); ++i)
+      _moves.at(i) = i;
+  }
+  BookGenerator(void) = delete;
+
+  void generate(void) {
+    expand(0, Hex::State::BLUE);
+    expand(0, Hex::State::RED);
+    return;
+  }
+  std::vector<Entry> get_entries(void) const {
+    std::vector<Entry> entries;
+    for (const auto &kv : _book)
+      entries.push_back(kv.second);
+    return entries;
+  }
+  inline uint32_t get_num_searches(void) const { return _num_searches; }
+
+ private:
+  const uint32_t     _dim;
+  const uint32_t     _max_moves;
+  MCStrategy        *_strategy_p;
+  const HexZobrist   _zobrist;
+  //! _moves[0..num_moves) played & the rest open: as MCHex keeps them
+  std::vector<uint32_t> _moves;
+  std::unordered_map<uint64_t, Entry> _book;
+  uint32_t           _num_searches;
+
+  inline uint32_t rotate(uint32_t vid) const { return _dim*_dim - 1 - vid; }
+
+  // Plays _moves[i] as move # num_moves, expands & takes it back
+  void play_and_expand(uint32_t i, uint32_t num_moves, Hex::State sw) {
+    std::swap(_moves.at(num_moves), _moves.at(i));
+    expand(num_moves + 1, sw);
+    std::swap(_moves.at(num_moves), _moves.at(i));
+    return;
+  }
+
+  void expand(uint32_t num_moves, Hex::State sw) {
+    if (num_moves > _max_moves)
+      return;
+    Hex::State s = (num_moves % 2 == 0) ? Hex::State::BLUE : Hex::State::RED;
+    if (s != sw) {
+      for (uint32_t i = num_moves; i < _moves.size(); ++i)
+        play_and_expand(i, num_moves, sw);
+      return;
+    }
+
+    auto first = _moves.begin(), last = _moves.begin() + num_moves;
+    uint64_t key = _zobrist.get_key(first, last);
+    auto it = _book.find(key);
+    if (it == _book.end()) {
+      // Searched on a copy: the engine permutes the open positions
+      std::vector<uint32_t> moves = _moves;
+      uint32_t move = _strategy_p->get_next_move(
+          &moves, num_moves,
+          TimeManager::Clock::now() + std::chrono::hours(24));
+      ++_num_searches;
+      it = _book.emplace(key, Entry{key, move}).first;
+
+      std::vector<uint32_t> rotated(first, last);
+      for (auto &vid : rotated)
+        vid = rotate(vid);
+      uint64_t rotated_key = _zobrist.get_key(rotated.begin(), rotated.end());
+      _book.emplace(rotated_key, Entry{rotated_key, rotate(move)});
+      DLOG(INFO) << "position of " << num_moves << " moves: key " << key
+                 << ": book move " << move;
+    }
+    uint32_t i = num_moves;
+    while (_moves.at(i) != it->second.move)
+      ++i;
+    play_and_expand(i, num_moves, sw);
+
+    return;
+  }
+};
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  std::string pgm = "/hex_book_gen";
+  std::string output_file_prefix;
+  if (FLAGS_output_dir.empty() == false)
+    output_file_prefix = FLAGS_output_dir + pgm;
+  else
+    output_file_prefix = "." + pgm;
+  std::string book_file = output_file_prefix + "-" +
+      std::to_string(FLAGS_dimension) + ".book";
+
+  DLOG(INFO) << "hex_book_gen called: "
+             << "book_file " << book_file
+             << ": dimension " << FLAGS_dimension
+             << ": max_moves " << FLAGS_max_moves
+             << ": num_trials " << FLAGS_num_trials
+             << ": threads " << FLAGS_threads;
+
+  try {
+    uint32_t dim = FLAGS_dimension;
+    // Searches of the book are never short of trials: no open limit
+    std::unique_ptr<MCStrategy>
+        strategy(new FlatMCStrategy(dim, FLAGS_auto_test, FLAGS_num_trials,
+                                    0, FLAGS_threads));
+    BookGenerator gen(dim, FLAGS_max_moves, strategy.get());
+    TimeManager::TimePoint start = TimeManager::Clock::now();
+    gen.generate();
+    std::vector<OpeningBook::Entry> entries = gen.get_entries();
+    OpeningBook::write(book_file, dim, FLAGS_max_moves, entries);
+    TimeManager::Seconds elapsed = TimeManager::Clock::now() - start;
+
+    std::cout << "book " << book_file << ": # entries " << entries.size()
+              << ": # searches " << gen.get_num_searches()
+              << ": " << elapsed.count() << " secs" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+    return 1;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+DEFINE_bool(auto_test, false,
+            "same seed for random number generation: runs are replayable");
+
+DEFINE_string(output_dir, "",
+              "Output directory of the book file");
+
+DEFINE_int32(dimension, 11,
+             "# rows/columns of the Hex board of the book");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(max_moves, 2,
+             "# moves of the deepest positions in the book");
+static bool ValidateMaxMoves(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 0 || num > 4) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be in [0, 4]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+max_moves_dummy = google::RegisterFlagValidator(&FLAGS_max_moves,
+                                                &ValidateMaxMoves);
+
+DEFINE_int32(num_trials, 1000,
+             "# trials per open position of the search of a book move");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_int32(threads, 1,
+             "# of threads searching for the moves of the book");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
@@ -0,0 +1,142 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file hex_htp.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Headless Hex engine: text protocol commands on stdin & responses
+//! on stdout (logs go to stderr or log_dir). Driven as a subprocess e.g.
+//! > echo -e "boardsize 11\ngenmove blue\nquit" | ./bin/hex_htp --strategy=uct
+
+// C++ Standard Headers
+#include <exception>        // std::exception
+#include <iostream>         // std::cin, std::cout
+// C Standard Headers
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_protocol.h"
+#include "games/mc_hex.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace hexgame::games;
+using namespace std;
+
+// Flag Declarations
+DECLARE_bool(auto_test);
+DECLARE_string(strategy);
+DECLARE_int32(threads);
+DECLARE_int32(num_trials);
+DECLARE_int32(move_time);
+DECLARE_bool(ponder);
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "hex_htp called: "
+             << "strategy " << FLAGS_strategy
+             << ": threads " << FLAGS_threads
+             << ": num_trials " << FLAGS_num_trials
+             << ": move_time " << FLAGS_move_time
+             << ": ponder " << std::boolalpha << FLAGS_ponder;
+
+  try {
+    MCStrategy::Type strategy = (FLAGS_strategy == "uct") ?
+                                MCStrategy::Type::UCT :
+                                MCStrategy::Type::FLAT;
+    HexProtocol htp(std::cin, std::cout, strategy, FLAGS_auto_test,
+                    FLAGS_num_trials, FLAGS_threads, FLAGS_move_time,
+                    FLAGS_ponder);
+    uint32_t num_commands = htp.run();
+    DLOG(INFO) << "hex_htp: # commands " << num_commands;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+    return 1;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+DEFINE_bool(auto_test, false,
+            "same seed for random number generation: moves are replayable");
+
+DEFINE_string(strategy, "uct",
+              "search engine generating the moves: flat or uct");
+static bool ValidateStrategy(const char* flagname, const std::string& value) {
+  std::string s(flagname);
+  if (value != "flat" && value != "uct") {
+    std::cerr << "Invalid value for --" << s << ": " << value
+              << ": should be flat or uct" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+strategy_dummy = google::RegisterFlagValidator(&FLAGS_strategy,
+                                               &ValidateStrategy);
+
+DEFINE_int32(threads, MCHex::DEFAULT_NUM_THREADS,
+             "# of threads searching for a move");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_int32(num_trials, MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED,
+             "# trials per open position allowed for a move");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_int32(move_time, MCHex::DEFAULT_MAX_MOVE_TIME_IN_SECS,
+             "max secs of a move until time_settings says otherwise");
+static bool ValidateMoveTime(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+move_time_dummy = google::RegisterFlagValidator(&FLAGS_move_time,
+                                                &ValidateMoveTime);
+
+DEFINE_bool(ponder, false,
+            "search while the opponent is due to play");
@@ -0,0 +1,354 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file hex_protocol.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: headless text protocol (HTP/GTP style) engine
+
+// Standard C++ Headers
+#include <algorithm>        // std::all_of, std::find
+#include <cctype>           // std::isdigit, std::tolower
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert
+#include <cstdlib>          // std::strtod
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_protocol.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+const uint32_t HexProtocol::PROTOCOL_VERSION;
+// End of Forward Declarations
+
+HexProtocol::HexProtocol(std::istream &is, std::ostream &os,
+                         const MCStrategy::Type strategy,
+                         const bool     auto_test,
+                         const uint32_t num_sim_trials_allowed,
+                         const uint32_t num_threads,
+                         const uint32_t max_move_time_in_secs,
+                         const bool     ponder) :
+    _is(is), _os(os), _strategy_type{strategy}, _auto_test{auto_test},
+    _num_sim_trials_allowed{num_sim_trials_allowed},
+    _num_threads{num_threads}, _ponder{ponder},
+    _default_move_time_in_secs(max_move_time_in_secs),
+    _commands{{"protocol_version", &HexProtocol::protocol_version},
+              {"name",             &HexProtocol::name},
+              {"version",          &HexProtocol::version},
+              {"known_command",    &HexProtocol::known_command},
+              {"list_commands",    &HexProtocol::list_commands},
+              {"quit",             &HexProtocol::quit},
+              {"boardsize",        &HexProtocol::boardsize},
+              {"clear_board",      &HexProtocol::clear_board},
+              {"play",             &HexProtocol::play},
+              {"genmove",          &HexProtocol::genmove},
+              {"undo",             &HexProtocol::undo},
+              {"time_settings",    &HexProtocol::time_settings},
+              {"time_left",        &HexProtocol::time_left},
+              {"winner",           &HexProtocol::winner}},
+    _dimension{0}, _num_moves{0},
+    _max_move_time_in_secs(max_move_time_in_secs),
+    _max_game_time_in_secs{0}, _engine_color{Hex::State::EMPTY},
+    _quit{false} {
+  reset(MCHex::DEFAULT_HEX_DIMENSION);
+
+  return;
+}
+
+HexProtocol::~HexProtocol() {
+  // The engine must not search a board that is going away
+  _strategy->stop_ponder();
+
+  return;
+}
+
+//! @details A line is cleaned up as per GTP: control characters dropped,
+//! tabs turned to spaces & comments cut. An id (if any) precedes the
+//! command & is echoed by its response.
+uint32_t HexProtocol::run(void) {
+  uint32_t num_commands = 0;
+  std::string line;
+  while (!_quit && std::getline(_is, line)) {
+    std::string clean;
+    for (char c : line) {
+      if (c == '#')
+        break;
+      if (c == '\t')
+        clean.push_back(' ');
+      else if (static_cast<unsigned char>(c) >= 32 && c != 127)
+        clean.push_back(c);
+    }
+    std::istringstream iss(clean);
+    Args args;
+    std::string token;
+    while (iss >> token)
+      args.push_back(token);
+    if (args.empty())
+      continue;
+
+    std::string id;
+    if (std::all_of(args.front().begin(), args.front().end(),
+                    [](char c) { return std::isdigit(c); })) {
+      id = args.front();
+      args.erase(args.begin());
+    }
+    // Pondering goes on only until the next command: boards & clocks of
+    // the engine are then free to change
+    _strategy->stop_ponder();
+
+    std::string result;
+    bool success = false;
+    auto it = args.empty() ? _commands.end() : _commands.find(args.front());
+    try {
+      if (it == _commands.end())
+        throw std::string("unknown command");
+      args.erase(args.begin());
+      result = (this->*(it->second))(args);
+      success = true;
+    }
+    catch (const std::string s) {
+      result = s;
+    }
+    DLOG(INFO) << "HexProtocol: " << clean << ": "
+               << (success ? "=" : "?") << " " << result;
+
+    _os << (success ? "=" : "?") << id
+        << (result.empty() ? "" : " ") << result << "\n\n" << std::flush;
+    ++num_commands;
+  }
+
+  return num_commands;
+}
+
+void HexProtocol::reset(uint32_t dimension) {
+  if (_strategy)
+    _strategy->stop_ponder();
+  _dimension = dimension;
+  _moves.resize(dimension*dimension);
+  for (uint32_t i = 0; i < _moves.size(); ++i)
+    _moves.at(i) = i;
+  _num_moves = 0;
+  _h.reset(new Hex(dimension));
+  // New game: nothing searched so far applies
+  _strategy = MCHex::make_strategy(
+      _strategy_type, dimension, _auto_test, _num_sim_trials_allowed,
+      MCHex::factorial_inverse(_num_sim_trials_allowed), _num_threads);
+  _time_manager.reset(new TimeManager(_max_move_time_in_secs,
+                                      _max_game_time_in_secs));
+  _engine_color = Hex::State::EMPTY;
+
+  return;
+}
+
+void HexProtocol::record_move(uint32_t vid) {
+  auto it = std::find(_moves.begin() + _num_moves, _moves.end(), vid);
+  assert(it != _moves.end());
+  std::swap(_moves.at(_num_moves), *it);
+  ++_num_moves;
+  _h->set_next_move(vid);
+  _h->assess_positions();
+
+  return;
+}
+
+Hex::State HexProtocol::next_player(void) const {
+  return (_num_moves % 2 == 0) ? Hex::State::BLUE : Hex::State::RED;
+}
+
+Hex::State HexProtocol::parse_color(const std::string &color) {
+  std::string c(color);
+  for (auto &ch : c)
+    ch = std::tolower(ch);
+  if (c == "b" || c == "black" || c == "blue")
+    return Hex::State::BLUE;
+  if (c == "w" || c == "white" || c == "red")
+    return Hex::State::RED;
+  throw std::string("invalid color ") + color;
+}
+
+std::string HexProtocol::color_name(const Hex::State s) {
+  assert(s != Hex::State::EMPTY);
+  return (s == Hex::State::BLUE) ? "blue" : "red";
+}
+
+void HexProtocol::check_num_args(const Args &args, uint32_t num_args) {
+  if (args.size() != num_args) {
+    std::stringstream ss;
+    ss << "expected " << num_args << " argument(s): got " << args.size();
+    throw ss.str();
+  }
+  return;
+}
+
+std::string HexProtocol::protocol_version(const Args &args) {
+  check_num_args(args, 0);
+  return std::to_string(PROTOCOL_VERSION);
+}
+
+std::string HexProtocol::name(const Args &args) {
+  check_num_args(args, 0);
+  return "mc_hex";
+}
+
+std::string HexProtocol::version(const Args &args) {
+  check_num_args(args, 0);
+  return MCStrategy::str_type(_strategy->get_type());
+}
+
+std::string HexProtocol::known_command(const Args &args) {
+  check_num_args(args, 1);
+  return (_commands.count(args.at(0)) > 0) ? "true" : "false";
+}
+
+std::string HexProtocol::list_commands(const Args &args) {
+  check_num_args(args, 0);
+  std::string result;
+  for (const auto &c : _commands)
+    result += (result.empty() ? "" : "\n") + c.first;
+  return result;
+}
+
+std::string HexProtocol::quit(const Args &args) {
+  check_num_args(args, 0);
+  _quit = true;
+  return "";
+}
+
+std::string HexProtocol::boardsize(const Args &args) {
+  check_num_args(args, 1);
+  char *end;
+  long dim = std::strtol(args.at(0).c_str(), &end, 10);
+  if (*end != '\0' || dim < static_cast<long>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<long>(Hex::MAX_DIMENSION))
+    throw std::string("unacceptable size");
+  reset(static_cast<uint32_t>(dim));
+  return "";
+}
+
+std::string HexProtocol::clear_board(const Args &args) {
+  check_num_args(args, 0);
+  reset(_dimension);
+  return "";
+}
+
+std::string HexProtocol::play(const Args &args) {
+  check_num_args(args, 2);
+  Hex::State s = parse_color(args.at(0));
+  if (_h->is_play_over())
+    throw std::string("game over");
+  if (s != next_player())
+    throw "out of turn: " + color_name(next_player()) + " to play";
+  std::string move_str(args.at(1));
+  for (auto &ch : move_str)
+    ch = std::toupper(ch);
+  int32_t vid = _h->get_node_pos_from_str(move_str);
+  if (vid < 0)
+    throw "illegal move " + args.at(1);
+  record_move(vid);
+  return "";
+}
+
+//! @details The move is searched by the deadline of the time manager &
+//! played. Pondering (if enabled) starts from the new position.
+std::string HexProtocol::genmove(const Args &args) {
+  check_num_args(args, 1);
+  Hex::State s = parse_color(args.at(0));
+  if (_h->is_play_over())
+    throw std::string("game over");
+  if (s != next_player())
+    throw "out of turn: " + color_name(next_player()) + " to play";
+
+  uint32_t num_open = _dimension*_dimension - _num_moves;
+  TimeManager::TimePoint deadline = _time_manager->start_move(num_open);
+  uint32_t vid = _strategy->get_next_move(&_moves, _num_moves, deadline);
+  _time_manager->end_move();
+  record_move(vid);
+  _engine_color = s;
+
+  if (_ponder && !_h->is_play_over())
+    _strategy->start_ponder(_moves, _num_moves);
+
+  return _h->get_str_from_node_pos(vid);
+}
+
+//! @details The position is replayed from the empty board: Hex keeps no
+//! history of the moves played
+std::string HexProtocol::undo(const Args &args) {
+  check_num_args(args, 0);
+  if (_num_moves == 0)
+    throw std::string("cannot undo");
+  --_num_moves;
+  _h.reset(new Hex(_dimension));
+  for (uint32_t i = 0; i < _num_moves; ++i)
+    _h->set_next_move(_moves.at(i));
+  _h->assess_positions();
+  return "";
+}
+
+//! @details GTP: main time is the budget of the game & a byo yomi period
+//! of byo_yomi_time secs for byo_yomi_stones moves caps every move. No
+//! main time & no byo yomi (or byo yomi time for 0 stones) lifts the
+//! limits: the max move time passed at construction & an unbounded game.
+std::string HexProtocol::time_settings(const Args &args) {
+  check_num_args(args, 3);
+  char *end0, *end1, *end2;
+  double main_time = std::strtod(args.at(0).c_str(), &end0);
+  double byo_yomi_time = std::strtod(args.at(1).c_str(), &end1);
+  long byo_yomi_stones = std::strtol(args.at(2).c_str(), &end2, 10);
+  if (*end0 != '\0' || *end1 != '\0' || *end2 != '\0' ||
+      main_time < 0 || byo_yomi_time < 0 || byo_yomi_stones < 0)
+    throw std::string("syntax error");
+
+  bool no_limit = (byo_yomi_time > 0 && byo_yomi_stones == 0) ||
+                  (main_time == 0 && byo_yomi_time == 0);
+  if (no_limit) {
+    _max_move_time_in_secs = _default_move_time_in_secs;
+    _max_game_time_in_secs = 0;
+  } else {
+    _max_move_time_in_secs = (byo_yomi_time > 0) ?
+                             byo_yomi_time/byo_yomi_stones : main_time;
+    _max_game_time_in_secs = main_time;
+  }
+  _time_manager.reset(new TimeManager(_max_move_time_in_secs,
+                                      _max_game_time_in_secs));
+  return "";
+}
+
+//! @details Only the clock of the color the engine plays is tracked
+std::string HexProtocol::time_left(const Args &args) {
+  check_num_args(args, 3);
+  Hex::State s = parse_color(args.at(0));
+  char *end;
+  double secs = std::strtod(args.at(1).c_str(), &end);
+  if (*end != '\0')
+    throw std::string("syntax error");
+  if (_engine_color == Hex::State::EMPTY || _engine_color == s)
+    _time_manager->set_remaining_time(secs);
+  return "";
+}
+
+std::string HexProtocol::winner(const Args &args) {
+  check_num_args(args, 0);
+  return (_h->get_winner() == Hex::State::EMPTY) ? 
+      "none" : color_name(_h->get_winner());
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
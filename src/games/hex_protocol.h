@@ -0,0 +1,169 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     hex_protocol.h
+//! @brief    Definition: headless text protocol (HTP/GTP style) engine
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _HEX_PROTOCOL_H_
+#define _HEX_PROTOCOL_H_
+// C++ Standard Headers
+#include <iostream>         // std::istream, std::ostream
+#include <map>              // std::map
+#include <memory>           // std::unique_ptr
+#include <string>           // std::string
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/mc_hex.h"
+#include "games/mc_strategy.h"
+#include "games/time_manager.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    HexProtocol
+//! @brief    Engine driven by text commands (GTP/HTP conventions) read from
+//!           an input stream: responses only are written to the output
+//! @details  Every command is a line "[id] name [args...]". The response is
+//!           "=[id] result" on success or "?[id] error" on failure followed
+//!           by an empty line, flushed at once. Comments (from '#') &
+//!           empty lines are skipped.
+//!           Colors: b, black or blue (moves first) & w, white or red.
+//!           Moves: rowcol format of Hex (e.g. A0 is row A & column 0).
+//!           Players alternate: a move of the player not due is refused.
+//!           Commands: protocol_version, name, version, known_command,
+//!           list_commands, quit, boardsize, clear_board, play, genmove,
+//!           undo, time_settings, time_left & winner.
+//!           Pondering (when enabled): the engine searches from the end of
+//!           its own move until the next command arrives.
+//! EXAMPLE USAGE:
+//!   HexProtocol htp(std::cin, std::cout, MCStrategy::Type::UCT);
+//!   htp.run();
+//!   > 1 boardsize 11
+//!   =1
+//!   > 2 genmove blue
+//!   =2 F5
+class HexProtocol {
+ public:
+  //! Version of the GTP conventions followed
+  const static uint32_t PROTOCOL_VERSION = 2;
+
+  //! @param[in] is commands read until quit or end of input
+  //! @param[in] os responses
+  //! @param[in] strategy search engine generating the moves
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_sim_trials_allowed max trials allowed for each move
+  //! @param[in] num_threads # of threads searching for a move
+  //! @param[in] max_move_time_in_secs max secs allowed for a move (until
+  //!            time_settings says otherwise)
+  //! @param[in] ponder true: search while the opponent is due to play
+  HexProtocol(std::istream &is, std::ostream &os,
+              const MCStrategy::Type strategy,
+              const bool     auto_test = false,
+              const uint32_t num_sim_trials_allowed = 
+                             MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED,
+              const uint32_t num_threads = MCHex::DEFAULT_NUM_THREADS,
+              const uint32_t max_move_time_in_secs = 
+                             MCHex::DEFAULT_MAX_MOVE_TIME_IN_SECS,
+              const bool     ponder = false);
+  ~HexProtocol();
+
+  //! @brief Executes commands until quit or end of input
+  //! @return # of commands executed
+  uint32_t run(void);
+
+  HexProtocol(const HexProtocol &)    = delete; //!< @brief disallow copy ctor
+  HexProtocol(HexProtocol &&)         = delete; //!< @brief disallow move ctor
+  void operator=(const HexProtocol &) = delete; //!< @brief disallow assignment
+  void operator=(HexProtocol &&)      = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  using Args = std::vector<std::string>;
+  //! Command: returns the result or throws the error as a std::string
+  using Handler = std::string (HexProtocol::*)(const Args &args);
+
+  std::istream                   &_is;
+  std::ostream                   &_os;
+  const MCStrategy::Type          _strategy_type;
+  const bool                      _auto_test;
+  const uint32_t                  _num_sim_trials_allowed;
+  const uint32_t                  _num_threads;
+  const bool                      _ponder;
+  //! max secs of a move without time limits
+  const double                    _default_move_time_in_secs;
+  const std::map<std::string, Handler> _commands;
+  //! # rows/columns of the board
+  uint32_t                        _dimension;
+  //! moves[0..num_moves) played (BLUE first) & the rest open
+  std::vector<uint32_t>           _moves;
+  uint32_t                        _num_moves;
+  std::unique_ptr<Hex>            _h;
+  std::unique_ptr<MCStrategy>     _strategy;
+  //! max secs of a move & of the game as per time_settings
+  double                          _max_move_time_in_secs;
+  double                          _max_game_time_in_secs;
+  std::unique_ptr<TimeManager>    _time_manager;
+  //! color of the last move generated: EMPTY before the first
+  Hex::State                      _engine_color;
+  //! true once quit is executed
+  bool                            _quit;
+
+  //! @brief New empty board of dimension & engine to search it
+  void reset(uint32_t dimension);
+  //! @brief Occupies the open position vid: the winner is assessed
+  void record_move(uint32_t vid);
+  //! @brief Player due to move: BLUE after an even # of moves
+  Hex::State next_player(void) const;
+  //! @brief Player of the color argument: throws when invalid
+  static Hex::State parse_color(const std::string &color);
+  //! @brief Color of a player in responses: blue or red
+  static std::string color_name(const Hex::State s);
+  //! @brief Throws unless args holds exactly num_args arguments
+  static void check_num_args(const Args &args, uint32_t num_args);
+
+  std::string protocol_version(const Args &args);
+  std::string name(const Args &args);
+  std::string version(const Args &args);
+  std::string known_command(const Args &args);
+  std::string list_commands(const Args &args);
+  std::string quit(const Args &args);
+  std::string boardsize(const Args &args);
+  std::string clear_board(const Args &args);
+  std::string play(const Args &args);
+  std::string genmove(const Args &args);
+  std::string undo(const Args &args);
+  std::string time_settings(const Args &args);
+  std::string time_left(const Args &args);
+  std::string winner(const Args &args);
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _HEX_PROTOCOL_H_
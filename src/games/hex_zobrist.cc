@@ -0,0 +1,52 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <sstream>          // std::stringstream
+// Standard C Headers
+// Google Headers
+// Local Headers
+#include "games/hex_zobrist.h"
+#include "utils/random.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint64_t HexZobrist::SEED;
+// End of Forward Declarations
+
+HexZobrist::HexZobrist(uint32_t dimension) :
+    _dim(dimension), _empty_key{0}, _keys(2*dimension*dimension) {
+  if (_dim < Hex::MIN_DIMENSION || _dim > Hex::MAX_DIMENSION) {
+    std::stringstream ss;
+    ss << "HexZobrist: Game dimension " << _dim
+       << ": accepted-range 26 >= dimension >=3";
+    throw ss.str();
+  }
+  // One stream per dimension: boards of different sizes never share keys
+  utils::FastRandom rnd(SEED + _dim);
+  _empty_key = rnd();
+  for (auto &k : _keys)
+    k = rnd();
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
@@ -0,0 +1,88 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+//
+// Class HexZobrist:
+// DESCRIPTION:
+//   Zobrist hashing of Hex positions: a random 64 bit key per (position,
+//   player) & a key per dimension for the empty board. The key of a board
+//   is the xor of the empty board key & the keys of its stones: the same
+//   whatever the order the stones were played in (transpositions share a
+//   key) & updated by a single xor per move.
+//   Keys are drawn from FastRandom with a fixed seed: they are identical
+//   across runs & builds, as required by hashes persisted in files (e.g.
+//   the opening book). Changing SEED invalidates every such file.
+// EXAMPLE USAGE:
+//   HexZobrist z(11);
+//   uint64_t key = z.get_key(moves.begin(), moves.begin() + num_moves);
+//   key ^= z.get_stone_key(pos, Hex::State::RED); // RED occupies pos
+
+#ifndef _HEX_ZOBRIST_H_
+#define _HEX_ZOBRIST_H_
+// C++ Standard Headers
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+#include <cstdint>          // uint64_t
+// Local Headers
+#include "games/hex.h"
+
+namespace hexgame { namespace games {
+//-----------------------------------------------------------------------------
+class HexZobrist {
+ public:
+  using State = Hex::State;
+  //! Seed of the keys: part of the format of every persisted key
+  constexpr static uint64_t SEED = 0x48657842756b6b31ULL;
+
+  explicit HexZobrist(uint32_t dimension = Hex::DEFAULT_DIMENSION);
+  ~HexZobrist() = default;
+
+  // Copy & assignment allowed: keys are plain values
+  HexZobrist(const HexZobrist &) = default;
+  HexZobrist& operator=(const HexZobrist &) = default;
+
+  inline uint32_t get_dimension(void) const { return _dim; }
+
+  // Key of the empty board: differs across dimensions
+  inline uint64_t get_empty_key(void) const { return _empty_key; }
+
+  // Key xor-ed in (or out) when player s occupies (or leaves) vid
+  inline uint64_t get_stone_key(uint32_t vid, State s) const {
+    assert(vid < _dim*_dim);
+    assert(s != State::EMPTY);
+    return _keys[2*vid + ((s == State::BLUE) ? 0 : 1)];
+  }
+
+  // Key of the board after the moves [first, last) starting with BLUE
+  template <typename InputIt>
+  inline uint64_t get_key(InputIt first, InputIt last) const {
+    uint64_t key = _empty_key;
+    for (State s = State::BLUE; first != last; ++first, ++s)
+      key ^= get_stone_key(*first, s);
+    return key;
+  }
+
+ private:
+  uint32_t              _dim;
+  uint64_t              _empty_key;
+  std::vector<uint64_t> _keys; // _keys[2*vid]: BLUE & _keys[2*vid+1]: RED
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
+
+#endif // _HEX_ZOBRIST_H_
@@ -0,0 +1,462 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file mc_flat.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: flat Monte Carlo search for SW moves
+
+// Standard C++ Headers
+#include <algorithm>        // std::find, std::stable_sort, std::swap
+#include <cmath>            // std::sqrt
+#include <future>           // std::future
+#include <iostream>         // std::cout
+#include <random>           // std::random_device
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_bitboard.h"
+#include "games/mc_flat.h"
+#include "utils/confidence.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t FlatMCStrategy::DEFAULT_RAVE_EQUIVALENCE;
+// End of Forward Declarations
+
+FlatMCStrategy::FlatMCStrategy(const uint32_t dimension,
+                               const bool     auto_test,
+                               const uint32_t num_sim_trials_allowed,
+                               const uint32_t num_open_limit,
+                               const uint32_t num_threads,
+                               const uint32_t rave_equivalence,
+                               const bool     successive_halving,
+                               WorkStealingPool *pool) :
+    MCStrategy(dimension, auto_test, num_sim_trials_allowed),
+    _num_open_limit{num_open_limit}, _rave_equivalence{rave_equivalence},
+    _successive_halving{successive_halving},
+    _own_pool{(pool == nullptr) ?
+              new WorkStealingPool(num_threads) : nullptr},
+    _pool{(pool == nullptr) ? _own_pool.get() : pool} {
+  // Private state of every search worker
+  for (uint32_t w = 0; w < num_threads; ++w)
+    _workers.emplace_back(new MCWorker(dimension));
+
+  return;
+}
+
+//! @details SW chooses the next move based on Monte Carlo simulation
+//! 1. The simulation plays random playouts of every open position.
+//! 2. For each next possible move it chooses the next move with 
+//!    best win ratio: direct win ratio blended with AMAF win ratio.
+//! Root parallel: the open positions are shuffled once & worker w of T
+//! explores candidates w, w + T, ... of the permutation on a private copy
+//! of moves, random stream & board. The 
+//! statistics of the workers are summed once all of them are done.
+//! Successive halving applies while every candidate has more permutations
+//! of the open positions than trials: the survivor is played.
+uint32_t FlatMCStrategy::get_next_move(std::vector<uint32_t> *moves_p,
+                                       uint32_t num_moves,
+                                       TimePoint deadline) {
+  // Generating the next_move is bounded by possible open_elements
+  uint32_t num_open_elements = _dimension*_dimension - num_moves;
+  assert(num_open_elements > 0);
+  start_search(moves_p->at(num_moves));
+
+  // Playouts start from a bitboard of the current position: 
+  // moves[0..num_moves) are the moves played so far starting with BLUE
+  HexBitBoard board(_dimension);
+  board.play_moves(moves_p->begin(), moves_p->begin() + num_moves, 
+                   Hex::State::BLUE);
+
+  bool halving = _successive_halving &&
+                 num_open_elements - 1 > _num_open_limit;
+  for (uint32_t w = 0; w < _workers.size(); ++w) {
+    MCWorker &worker = *_workers.at(w);
+    uint32_t seed = (_auto_test == true) ? 
+                    FIXED_SEED_FOR_RANDOM_ENGINE + w:
+                    std::random_device{}();
+    worker.rnd_e.seed(seed);
+    worker.shuffle = *moves_p;
+    worker.batch.set_position(board);
+    std::fill(worker.stats.begin(), worker.stats.end(), MCStats{0, 0, 0, 0});
+  }
+
+  uint32_t best_move;
+  std::vector<MCStats> &stats = _stats;
+  if (halving) {
+    best_move = search_halving(*moves_p, num_moves, deadline);
+    merge_stats(*moves_p, num_moves, &stats);
+  } else {
+    // The open positions are shuffled once & dealt to the workers: each
+    // one is explored by exactly one worker, in a random order should the
+    // deadline cut the search short
+    VectorHexMoves candidates(moves_p->begin() + num_moves, moves_p->end());
+    _workers.at(0)->rnd_e.shuffle(candidates.begin(), candidates.end());
+    std::vector<std::future<void>> results;
+    for (uint32_t w = 0; w < _workers.size(); ++w) {
+      results.push_back(_pool->submit(
+          [this, w, num_moves, &candidates, deadline]() { 
+            return search(w, num_moves, candidates, deadline); 
+          }));
+    }
+    for (auto &r : results)
+      _pool->get(r);
+    merge_stats(*moves_p, num_moves, &stats);
+    best_move = select_move(stats, *moves_p, num_moves);
+  }
+  _best_move.store(best_move);
+  // Worker 0 continues the sequence of moves of the game scratch pad
+  *moves_p = _workers.at(0)->shuffle;
+
+  DLOG(INFO) << "SW Simulated Winner: NextMove " << best_move
+             << ": #Wins " << stats.at(best_move).num_wins 
+             << "/" << stats.at(best_move).num_trials 
+             << ": #AMAF Wins " << stats.at(best_move).num_amaf_wins 
+             << "/" << stats.at(best_move).num_amaf;
+
+  end_search();
+  return best_move;
+}
+
+//! @details Worker w explores the candidates w, w + # workers, ...
+//! a. The candidate is swapped into shuffle[num_moves]: the open
+//! positions after it are permuted by its playouts.
+//! b. Evaluate the win ratio given the current next move.
+//! c. Start the evaluation of its next candidate unless the deadline has
+//!    passed or the search is asked to stop.
+//! @param[in] w index of the worker
+//! @param[in] num_moves # of moves played so far
+//! @param[in] candidates open positions in the order they are explored
+//! @param[in] deadline time by when the search ends
+void FlatMCStrategy::search(uint32_t w, uint32_t num_moves, 
+                            const VectorHexMoves &candidates,
+                            TimePoint deadline) {
+  MCWorker &worker = *_workers.at(w);
+  uint32_t num_open_elements = _dimension*_dimension - num_moves;
+  // next_move pegged: # trials bound by the permutations of the rest
+  uint32_t max_trials = (num_open_elements - 1 > _num_open_limit) ? 
+                        _num_sim_trials_allowed : num_open_elements - 1;
+
+  for (uint32_t i = w; i < candidates.size(); i += _workers.size()) {
+    uint32_t next_move = candidates.at(i);
+    std::swap(worker.shuffle.at(num_moves),
+              *std::find(worker.shuffle.begin() + num_moves,
+                         worker.shuffle.end(), next_move));
+    determine_win_ratio(next_move, num_moves, max_trials, deadline, &worker);
+
+    // Anytime: best move so far is ready should the search be cut short
+    if (w == 0)
+      _best_move.store(select_move(worker.stats, worker.shuffle, num_moves));
+
+    // We have exhausted the time budget: let us take a bet on the winner 
+    // as the next move candidate
+    if (is_done(deadline))
+      break;
+  }
+
+  return;
+}
+
+//! @details Successive halving: the budget of num_sim_trials_allowed
+//! playouts per candidate is spread over ceil(log2(# candidates)) rounds.
+//! Every round gives each surviving candidate an equal share of the
+//! budget of the round: candidates are shared among the workers as in
+//! the flat search & the statistics of the workers are summed once the
+//! round ends. The survivors of a round are the better half of the
+//! candidates less those clearly beaten by the leader (see halve). The
+//! search ends once a single candidate survives or the deadline passes.
+//! The leader is published after every round.
+//! @param[in] moves moves played so far followed by open positions
+//! @param[in] num_moves # of moves played so far
+//! @param[in] deadline time by when the search ends
+//! @return leader of the last round played
+uint32_t FlatMCStrategy::search_halving(const VectorHexMoves &moves,
+                                        uint32_t num_moves,
+                                        TimePoint deadline) {
+  VectorHexMoves candidates(moves.begin() + num_moves, moves.end());
+  uint32_t num_rounds = 0;
+  for (uint32_t n = 1; n < candidates.size(); n *= 2)
+    ++num_rounds;
+  uint64_t budget_per_round = static_cast<uint64_t>(candidates.size())*
+                              _num_sim_trials_allowed/num_rounds;
+  std::vector<MCStats> stats;
+
+  for (uint32_t round = 0; candidates.size() > 1; ++round) {
+    uint32_t num_trials = std::max<uint64_t>(
+        1, budget_per_round/candidates.size());
+    std::vector<std::future<void>> results;
+    for (uint32_t w = 0; w < _workers.size(); ++w) {
+      results.push_back(_pool->submit(
+          [this, w, num_moves, &candidates, num_trials, deadline]() {
+            return search_candidates(w, num_moves, candidates, num_trials,
+                                     deadline);
+          }));
+    }
+    for (auto &r : results)
+      _pool->get(r);
+
+    merge_stats(moves, num_moves, &stats);
+    candidates = halve(stats, candidates);
+    _best_move.store(candidates.front());
+
+    DLOG(INFO) << "SW Halving Num_Moves " << num_moves + 1
+               << ": Round " << round << ": # Trials " << num_trials
+               << ": # Survivors " << candidates.size()
+               << ": Leader " << candidates.front();
+
+    if (is_done(deadline))
+      break;
+  }
+
+  return candidates.front();
+}
+
+//! @details Worker w plays the candidates w, w + # workers, ... in turn:
+//! the candidate is swapped into shuffle[num_moves] & the open positions
+//! after it are permuted by its playouts.
+//! @param[in] w index of the worker
+//! @param[in] num_moves # of moves played so far
+//! @param[in] candidates candidate next moves of the round
+//! @param[in] num_trials # of playouts of every candidate
+//! @param[in] deadline time by when the search ends
+void FlatMCStrategy::search_candidates(uint32_t w, uint32_t num_moves,
+                                       const VectorHexMoves &candidates,
+                                       uint32_t num_trials,
+                                       TimePoint deadline) {
+  MCWorker &worker = *_workers.at(w);
+
+  for (uint32_t i = w; i < candidates.size(); i += _workers.size()) {
+    uint32_t next_move = candidates.at(i);
+    std::swap(worker.shuffle.at(num_moves),
+              *std::find(worker.shuffle.begin() + num_moves,
+                         worker.shuffle.end(), next_move));
+    determine_win_ratio(next_move, num_moves, num_trials, deadline, &worker);
+    if (is_done(deadline))
+      break;
+  }
+
+  return;
+}
+
+//! @details Candidates are ranked by score (on a tie the one listed
+//! first). The better half survives save those whose confidence interval
+//! of the direct win ratio lies entirely below the one of the leader:
+//! such candidates are beaten with high confidence & get no more
+//! playouts. A leader clearly beating every other candidate survives
+//! alone.
+//! @param[in] stats statistics of every position
+//! @param[in] candidates candidate next moves of the round
+//! @return surviving candidates: leader first
+FlatMCStrategy::VectorHexMoves
+FlatMCStrategy::halve(const std::vector<MCStats> &stats,
+                      const VectorHexMoves &candidates) const {
+  VectorHexMoves ranked(candidates);
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [this, &stats](uint32_t a, uint32_t b) {
+                     return get_score(stats.at(a)) > get_score(stats.at(b));
+                   });
+
+  double leader_low, leader_high;
+  const MCStats &ls = stats.at(ranked.front());
+  wilson_interval(ls.num_wins, ls.num_trials, CONFIDENCE_Z,
+                  &leader_low, &leader_high);
+  uint32_t num_kept = (ranked.size() + 1)/2;
+  VectorHexMoves survivors(1, ranked.front());
+  for (uint32_t i = 1; i < num_kept; ++i) {
+    const MCStats &ps = stats.at(ranked.at(i));
+    double low, high;
+    wilson_interval(ps.num_wins, ps.num_trials, CONFIDENCE_Z, &low, &high);
+    if (high >= leader_low)
+      survivors.push_back(ranked.at(i));
+  }
+
+  return survivors;
+}
+
+//! @details: For a given next move we determine the win ratio 
+//! realized as a result of making the specified next move
+//! 2.1. Hold the elements from 0 to _next_move constant - assuming the element in
+//! _next_move index of shuffle array is the next move explored we permute 
+//! remaining elements as a monte carlo simulation step to evaluate the win ratio.
+//! 2.2. Evaluate the win/loss outcome based on the permutation in step (2.1) 
+//! 2.3. Repeat step (2.1) and (2.2) until DEFAULT_MAX_SIM_TRIALS_ALLOWED or until 
+//! when number of permutations pending exceed what is total possible 
+//! The # of trials & wins are added to the statistics of next_move while
+//! every playout also feeds the AMAF statistics of all positions.
+//! @param[in] next_move the next move under consideration
+//! The deadline is checked once every batch of playouts is decided.
+//! @param[in] num_moves # of moves played so far
+//! @param[in] num_trials # of playouts of next_move
+//! @param[in] deadline time by when the search ends
+//! @param[in,out] worker_p private shuffle, random stream, board & 
+//!                statistics of the worker
+void 
+FlatMCStrategy::determine_win_ratio(const uint32_t next_move, 
+                                    const uint32_t num_moves,
+                                    const uint32_t num_trials_allowed,
+                                    const TimePoint &deadline,
+                                    MCWorker *worker_p) {
+  uint32_t num_wins =  0;
+  uint32_t max_trials = num_trials_allowed;
+  // SW: player due to play next_move
+  Hex::State next_player = get_player(num_moves);
+
+  for (uint32_t num_trials = 0; num_trials < max_trials; ++num_trials) {
+    // Permute the remaining elements: a random sequence of moves
+    worker_p->rnd_e.shuffle(worker_p->shuffle.begin() + num_moves + 1, 
+                            worker_p->shuffle.end());
+    
+    // We have now decided all the sequence of moves that is going to unfold
+    // in the game. In order to not mess up the "real" game while we are
+    // playing it in "simulation" we play it in a lane of the batch (on top
+    // of the current position). Winners of a batch are decided together 
+    // once all its lanes are played or trials are over.
+    uint32_t lane = num_trials % HexBatchEval::NUM_LANES;
+    worker_p->batch.play_moves(lane, worker_p->shuffle.begin() + num_moves, 
+                               worker_p->shuffle.end(), next_player);
+    // SW occupies every other position from next_move onwards
+    if (_rave_equivalence > 0) {
+      for (uint32_t i = num_moves; i < worker_p->shuffle.size(); i += 2)
+        worker_p->amaf_lanes.at(worker_p->shuffle.at(i)) |= 
+            (static_cast<HexBatchEval::Lanes>(1) << lane);
+    }
+    if (lane + 1 < HexBatchEval::NUM_LANES && num_trials + 1 < max_trials)
+      continue;
+    HexBatchEval::Lanes blue_won = worker_p->batch.get_blue_wins();
+    worker_p->batch.clear();
+    // SW win count increases if winner is SW: on a full board RED won
+    // every lane that BLUE did not. Lanes left unplayed count for nobody
+    HexBatchEval::Lanes used = (lane + 1 < HexBatchEval::NUM_LANES) ?
+        (static_cast<HexBatchEval::Lanes>(1) << (lane + 1)) - 1 : 
+        ~static_cast<HexBatchEval::Lanes>(0);
+    HexBatchEval::Lanes sw_won = (next_player == Hex::State::BLUE) ? 
+                                 (blue_won & used) : (~blue_won & used);
+    num_wins += __builtin_popcountll(sw_won);
+    if (_rave_equivalence > 0)
+      update_amaf(num_moves, sw_won, worker_p);
+    // Time is up: stats of next_move only count the trials played
+    if (num_trials + 1 < max_trials && is_done(deadline)) {
+      max_trials = num_trials + 1;
+      break;
+    }
+  }
+
+  MCStats &stats = worker_p->stats.at(next_move);
+  stats.num_trials += max_trials;
+  stats.num_wins   += num_wins;
+
+  DLOG(INFO) << "SW Simulated Num_Moves " << num_moves + 1
+             << ": Max Trials " << max_trials 
+             << ": Next Move " << next_move << ": # wins " << num_wins;
+
+  return;
+}
+
+//! @details Lane l of amaf_lanes[pos] is set when SW occupied pos in the
+//! playout of lane l: the AMAF visits & wins of pos are the # of such
+//! lanes & the # of those SW won. The lanes are reset for the next batch.
+//! @param[in] num_moves # of moves played so far
+//! @param[in] won lanes of the batch won by SW
+//! @param[in,out] worker_p private shuffle & statistics of the worker
+void FlatMCStrategy::update_amaf(const uint32_t num_moves, 
+                                 HexBatchEval::Lanes won, 
+                                 MCWorker *worker_p) {
+  for (uint32_t i = num_moves; i < worker_p->shuffle.size(); ++i) {
+    uint32_t pos = worker_p->shuffle.at(i);
+    HexBatchEval::Lanes &lanes = worker_p->amaf_lanes.at(pos);
+    MCStats &stats = worker_p->stats.at(pos);
+    stats.num_amaf      += __builtin_popcountll(lanes);
+    stats.num_amaf_wins += __builtin_popcountll(lanes & won);
+    lanes = 0;
+  }
+
+  return;
+}
+
+//! @param[in] moves moves played so far followed by open positions
+//! @param[in] num_moves # of moves played so far
+//! @param[out] stats_p statistics of every position summed across workers
+void FlatMCStrategy::merge_stats(const VectorHexMoves &moves,
+                                 uint32_t num_moves,
+                                 std::vector<MCStats> *stats_p) const {
+  *stats_p = _workers.at(0)->stats;
+  for (uint32_t w = 1; w < _workers.size(); ++w) {
+    for (uint32_t i = num_moves; i < moves.size(); ++i) {
+      uint32_t pos = moves.at(i);
+      const MCStats &ws = _workers.at(w)->stats.at(pos);
+      stats_p->at(pos).num_trials    += ws.num_trials;
+      stats_p->at(pos).num_wins      += ws.num_wins;
+      stats_p->at(pos).num_amaf      += ws.num_amaf;
+      stats_p->at(pos).num_amaf_wins += ws.num_amaf_wins;
+    }
+  }
+
+  return;
+}
+
+//! @details RAVE: (1 - beta)*direct + beta*AMAF win ratio where 
+//! beta = sqrt(k/(3*n + k)), n: # direct playouts & k: _rave_equivalence.
+//! A position without direct playouts is scored by AMAF alone & a position
+//! without AMAF playouts (or with AMAF disabled) by direct playouts alone.
+//! @param[in] stats statistics of a position with some playouts
+//! @return score of the position: win ratio in [0, 1]
+double FlatMCStrategy::get_score(const MCStats &stats) const {
+  double direct = (stats.num_trials > 0) ? 
+                  static_cast<double>(stats.num_wins)/stats.num_trials : 0;
+  if (_rave_equivalence == 0 || stats.num_amaf == 0)
+    return direct;
+  double amaf = static_cast<double>(stats.num_amaf_wins)/stats.num_amaf;
+  double beta = std::sqrt(static_cast<double>(_rave_equivalence)/
+                          (3.0*stats.num_trials + _rave_equivalence));
+
+  return (1 - beta)*direct + beta*amaf;
+}
+
+//! @param[in] stats statistics of every position
+//! @param[in] moves moves played so far followed by open positions
+//! @param[in] num_moves # of moves played so far
+//! @return open position with the best score: on a tie the one listed 
+//! first & moves[num_moves] when no position has playouts
+uint32_t FlatMCStrategy::select_move(const std::vector<MCStats> &stats,
+                                     const VectorHexMoves &moves, 
+                                     uint32_t num_moves) const {
+  uint32_t best_move = moves.at(num_moves);
+  double   best_score = -1;
+  for (uint32_t i = num_moves; i < moves.size(); ++i) {
+    uint32_t pos = moves.at(i);
+    const MCStats &ps = stats.at(pos);
+    if (ps.num_trials == 0 && (_rave_equivalence == 0 || ps.num_amaf == 0))
+      continue;
+    double score = get_score(ps);
+    if (score > best_score) {
+      best_move = pos;
+      best_score = score;
+    }
+  }
+
+  return best_move;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
@@ -0,0 +1,203 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     mc_flat.h
+//! @brief    Definition: flat Monte Carlo search for SW moves
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _MC_FLAT_H_
+#define _MC_FLAT_H_
+// C++ Standard Headers
+#include <memory>           // std::unique_ptr
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_batch_eval.h"
+#include "games/mc_strategy.h"
+#include "utils/random.h"
+#include "utils/work_stealing_pool.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    FlatMCStrategy
+//! @brief    Flat Monte Carlo: candidate next moves are scored by a fixed
+//!           # of random playouts & the candidate with the best score is
+//!           played. No statistics are kept across moves.
+//! @details  All moves as first (AMAF): every playout also credits its
+//!           result to every position the player due to play occupied in
+//!           it. The AMAF win ratio of a position is blended with its
+//!           direct win ratio (RAVE): the weight of AMAF decays as the
+//!           position gathers direct playouts (Gelly & Silver):
+//!           beta = sqrt(k/(3*n + k)), k: rave_equivalence, n: # direct
+//!           playouts. Positions never explored directly are scored by
+//!           AMAF alone. rave_equivalence 0 disables AMAF.
+//!           Anytime: worker 0 publishes its best move after every
+//!           candidate & the deadline is checked after every batch of
+//!           playouts.
+//!           Root parallel: the open positions are shuffled once & worker
+//!           w of T explores candidates w, w + T, ... of the permutation
+//!           (every open position by exactly one worker) on a private
+//!           copy of the moves, random stream & board. The statistics of the workers are summed
+//!           once all of them are done. The workers run on a pool of the
+//!           strategy or on a pool shared by the strategies of many games.
+//!           Successive halving (optional): the choice of the next move is
+//!           a best arm identification. The same total # of playouts is
+//!           spread over rounds: every round gives the surviving
+//!           candidates an equal share & keeps the better half of them.
+//!           Candidates whose confidence interval lies below the one of
+//!           the leader are dropped at once: the search ends as soon as
+//!           the leader alone survives.
+class FlatMCStrategy : public MCStrategy {
+ public:
+  //! Default # of direct playouts at which direct & AMAF weigh the same
+  constexpr static uint32_t DEFAULT_RAVE_EQUIVALENCE = 250;
+
+  //! Playout statistics of a position as next move of the player to play
+  struct MCStats {
+    uint32_t num_trials;    //!< # playouts with the position as next move
+    uint32_t num_wins;      //!< # of those won
+    uint32_t num_amaf;      //!< # playouts the player occupied the position
+    uint32_t num_amaf_wins; //!< # of those won
+  };
+
+  //! @param[in] dimension # rows/columns used for Hex Game
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_sim_trials_allowed max trials SW allowed for each next move
+  //! @param[in] num_open_limit # open positions below which # trials is bound
+  //!            by # of permutations of the open positions
+  //! @param[in] num_threads # of threads searching for the next move
+  //! @param[in] rave_equivalence # of direct playouts at which direct & AMAF
+  //!            win ratios weigh the same: 0 disables AMAF
+  //! @param[in] successive_halving true: playouts go to the candidates still
+  //!            in contention: num_sim_trials_allowed is then the average
+  //!            # of playouts of a candidate
+  //! @param[in] pool threads running the workers: nullptr gives the strategy
+  //!            a pool of num_threads threads. A shared pool must outlive
+  //!            the strategy: num_threads is then the # of workers
+  FlatMCStrategy(const uint32_t dimension,
+                 const bool     auto_test,
+                 const uint32_t num_sim_trials_allowed,
+                 const uint32_t num_open_limit,
+                 const uint32_t num_threads,
+                 const uint32_t rave_equivalence = DEFAULT_RAVE_EQUIVALENCE,
+                 const bool     successive_halving = false,
+                 utils::WorkStealingPool *pool = nullptr);
+  ~FlatMCStrategy() = default;
+
+  inline Type get_type(void) const override { return Type::FLAT; }
+
+  //! @brief Best next move for the player due to play
+  //! @details Worker 0 leaves its permutation of the open positions in moves
+  uint32_t get_next_move(std::vector<uint32_t> *moves_p,
+                         uint32_t num_moves,
+                         TimePoint deadline) override;
+
+  //! @brief Statistics of every position (indexed by position) summed
+  //! across the workers by the last search
+  inline const std::vector<MCStats>& get_stats(void) const { return _stats; }
+
+  //! @brief RAVE score: direct win ratio blended with AMAF win ratio
+  double get_score(const MCStats &stats) const;
+
+  //! @brief Candidates kept for the next round of successive halving
+  std::vector<uint32_t> halve(const std::vector<MCStats> &stats,
+                              const std::vector<uint32_t> &candidates) const;
+
+ protected:
+ private:
+  using VectorHexMoves = std::vector<uint32_t>;
+  //! @brief Private state of a search worker
+  //! @details playouts of a worker never touch the game or other workers
+  struct MCWorker {
+    explicit MCWorker(uint32_t dimension) :
+        shuffle(dimension*dimension), batch(dimension),
+        amaf_lanes(dimension*dimension, 0), stats(dimension*dimension) {}
+    VectorHexMoves             shuffle; //!< private copy of the moves
+    utils::FastRandom          rnd_e;   //!< private random stream
+    HexBatchEval               batch;   //!< private board of playouts
+    //! lanes of batch where the player to play occupies the position
+    std::vector<HexBatchEval::Lanes> amaf_lanes;
+    std::vector<MCStats>       stats;   //!< statistics of every position
+  };
+
+  //! @brief # open positions where we simulate < _num_sim_trails_allowed
+  //! @details This value is used to save some time towards the end of
+  //! the game when total pending permutations possible is lower than # of
+  //! trials allowed
+  const uint32_t        _num_open_limit;
+  //! # of direct playouts at which direct & AMAF win ratios weigh the same
+  const uint32_t        _rave_equivalence;
+  //! true: playouts are allocated to candidates by successive halving
+  const bool            _successive_halving;
+  //! pool owned by the strategy: nullptr when the pool is shared
+  std::unique_ptr<utils::WorkStealingPool> _own_pool;
+  //! threads searching for the next move of SW
+  utils::WorkStealingPool *_pool;
+  //! private state of each search worker
+  std::vector<std::unique_ptr<MCWorker>> _workers;
+  //! statistics of the last search summed across the workers
+  std::vector<MCStats> _stats;
+
+  //! @brief Worker w searches its share of candidate next moves
+  void search(uint32_t w, uint32_t num_moves,
+              const VectorHexMoves &candidates, TimePoint deadline);
+
+  //! @brief Rounds of successive halving of the candidate next moves
+  //! @return candidate surviving the rounds played
+  uint32_t search_halving(const VectorHexMoves &moves, uint32_t num_moves,
+                          TimePoint deadline);
+
+  //! @brief Worker w plays num_trials playouts of its share of candidates
+  void search_candidates(uint32_t w, uint32_t num_moves,
+                         const VectorHexMoves &candidates,
+                         uint32_t num_trials, TimePoint deadline);
+
+  //! @brief Determine the win ratio based on the generated next move
+  void determine_win_ratio(const uint32_t next_move,
+                           const uint32_t num_moves,
+                           const uint32_t num_trials,
+                           const TimePoint &deadline,
+                           MCWorker *worker_p);
+
+  //! @brief Sum of the statistics of every open position across workers
+  void merge_stats(const VectorHexMoves &moves, uint32_t num_moves,
+                   std::vector<MCStats> *stats_p) const;
+
+  //! @brief Credit the batch of playouts to the AMAF statistics
+  void update_amaf(const uint32_t num_moves, HexBatchEval::Lanes won,
+                   MCWorker *worker_p);
+
+  //! @brief Open position with the best score
+  uint32_t select_move(const std::vector<MCStats> &stats,
+                       const VectorHexMoves &moves, uint32_t num_moves) const;
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _MC_FLAT_H_
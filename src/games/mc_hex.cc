@@ -18,10 +18,7 @@
 
 // Standard C++ Headers
 #include <algorithm>        // std::max, std::random_shuffle, std::find
-#include <chrono>           // std::chrono::...
-#include <functional>       // std::bind
 #include <iostream>         // std::cout
-#include <random>           // std::distribution, random engine, ...
 #include <sstream>          // std::stringstream
 #include <vector>           // std::vector
 // Standard C Headers
@@ -30,12 +27,13 @@
 // Google Headers
 #include <glog/logging.h>   // Daemon Log function
 // Local Headers
+#include "games/mc_flat.h"
 #include "games/mc_hex.h"
+#include "games/mc_uct.h"
 
 using namespace hexgame;
 using namespace hexgame::utils;
 using namespace std;
-using namespace std::placeholders;
 
 namespace hexgame { namespace games {
 
@@ -46,14 +44,22 @@ MCHex::MCHex(const std::string& op_file,
              const uint32_t     max_moves,
              const bool         auto_test,
              const uint32_t     max_move_time_in_secs,
-             const uint32_t     num_sim_trials_allowed) :
+             const uint32_t     num_sim_trials_allowed,
+             const uint32_t     num_threads,
+             const MCStrategy::Type strategy,
+             const uint32_t     max_game_time_in_secs,
+             const bool         ponder,
+             const std::string& book_file,
+             const bool         successive_halving) :
   _op_file{op_file}, _dimension{dimension}, 
   _human_position_choice{human_position_choice}, 
   _max_moves{max_moves}, _auto_test{auto_test},
   _max_move_time_in_secs((auto_test)?1:max_move_time_in_secs), 
   _num_sim_trials_allowed((auto_test)?10:num_sim_trials_allowed), 
   _num_open_limit{MCHex::factorial_inverse(num_sim_trials_allowed)},
-  _num_moves{0}, _shuffle(dimension*dimension),  _h{dimension} 
+  _num_moves{0}, _shuffle(dimension*dimension),  _h{dimension},
+  _time_manager(_max_move_time_in_secs, max_game_time_in_secs),
+  _ponder{ponder}, _num_book_moves{0}
 {
   _ofp.open(_op_file, std::ios::out);
   if (!_ofp) {
@@ -67,9 +73,46 @@ MCHex::MCHex(const std::string& op_file,
   for (uint32_t i=0; i<dimension*dimension; i++)
     _shuffle.at(i) = i;
 
+  if (!book_file.empty())
+    _book.reset(new OpeningBook(book_file, dimension));
+
+  _strategy = make_strategy(strategy, dimension, _auto_test,
+                            _num_sim_trials_allowed, _num_open_limit,
+                            num_threads, nullptr,
+                            UCTStrategy::DEFAULT_NUM_TT_ENTRIES,
+                            successive_halving);
+
   return;
 }
 
+std::unique_ptr<MCStrategy> MCHex::make_strategy(
+    const MCStrategy::Type strategy,
+    const uint32_t     dimension,
+    const bool         auto_test,
+    const uint32_t     num_sim_trials_allowed,
+    const uint32_t     num_open_limit,
+    const uint32_t     num_threads,
+    WorkStealingPool  *pool,
+    const uint32_t     num_tt_entries,
+    const bool         successive_halving) {
+  std::unique_ptr<MCStrategy> strategy_p;
+  switch (strategy) {
+    case MCStrategy::Type::FLAT:
+      strategy_p.reset(new FlatMCStrategy(
+          dimension, auto_test, num_sim_trials_allowed, num_open_limit,
+          num_threads, FlatMCStrategy::DEFAULT_RAVE_EQUIVALENCE,
+          successive_halving, pool));
+      break;
+    case MCStrategy::Type::UCT:
+      strategy_p.reset(new UCTStrategy(dimension, auto_test, 
+                                       num_sim_trials_allowed, num_threads,
+                                       num_tt_entries, pool));
+      break;
+  }
+
+  return strategy_p;
+}
+
 MCHex::~MCHex(void) {
   _ofp.close();
   return;
@@ -87,7 +130,10 @@ Hex::State MCHex::run(void) {
              << Hex::str_state(_human_position_choice) << std::endl 
              << ": max_moves " << max_moves 
              << ": max_move_time_in_secs " << _max_move_time_in_secs
-             << ": num_sim_trials_allowed " << _num_sim_trials_allowed;
+             << ": num_sim_trials_allowed " << _num_sim_trials_allowed
+             << ": strategy " << _strategy->get_type()
+             << ": ponder " << std::boolalpha << _ponder
+             << ": book " << (_book ? _book->get_num_entries() : 0);
 
   try {
     DLOG(INFO) << "************************" << std::endl
@@ -106,8 +152,13 @@ Hex::State MCHex::run(void) {
     for (uint32_t move = 0; move < max_moves; ++move, ++s) {
       assert(_num_moves < max_moves);
       if (_human_position_choice == s) {
-        // Human Generated move: validate and process input
+        // Human Generated move: validate and process input. SW keeps 
+        // searching on the time of the human until the move is in
+        if (_ponder)
+          _strategy->start_ponder(_shuffle, _num_moves);
         query_and_process_human_move();
+        if (_ponder)
+          _strategy->stop_ponder();
       } else {
         // SW generated move based on Monte carlo simulation
         sw_play_next_move();
@@ -168,126 +219,36 @@ void MCHex::query_and_process_human_move(void) {
   return;
 }
 
-//! @details SW chooses the next move based on Monte Carlo simulation
-//! 1. The simulation generates as many next random move as possible.
-//! 2. For each next possible move it chooses the next move with 
-//!    best win ratio.
+//! @details SW plays the move of the opening book when the position is in
+//! the book. Otherwise SW chooses the next move via the search engine
+//! (strategy) chosen at construction by the deadline of the time manager.
+//! The engine may permute the open positions of _shuffle: all elements
+//! from index _num_moves onwards remain open.
 void MCHex::sw_play_next_move(void) {
-  // Objective: Identify the next move with the best # of win ratio 
-  // - note that since the number of trials is fixed, the # of wins 
-  // is equivalent to win_ratio.
-  uint32_t next_move, num_win, max_num_win, max_next_move;
-  uint32_t seed = (_auto_test == true) ? 
-                  MCHex::FIXED_SEED_FOR_RANDOM_ENGINE:
-                  std::random_device{}();
-  std::default_random_engine rnd_e{seed};
-
-  // a. We randomly permute all elements that are open positions
-  // to see what is the next possible move. Given that all elements from 
-  // index _next_move onwards in _shuffle are open positions we just permute _shuffle
-  // array from _next_move onwards. This gives us the candidate next_move.
-  // b. Evaluate the win ratio given the current next move.
-  // c. Start the evaluation for another possible next_move unless total time
-  //    budgeted to SW has exceeded.
-  // d. Play the move with the maximum number of wins
-
-  // Generating the next_move is bounded by possible open_elements
-  uint32_t num_open_elements = _dimension*_dimension - _num_moves;
-  assert(num_open_elements > 0);
-
-  std::chrono::time_point<std::chrono::system_clock> start, now;
-  std::chrono::duration<double> elapsed_seconds;
-  start = std::chrono::system_clock::now();
-
-  for (uint32_t num_next_moves_explored = 0; 
-       num_next_moves_explored < num_open_elements;
-       ++num_next_moves_explored) {
-
-    // Initialize the appropriate random generator class to permute the _shuffle array
-    std::shuffle(_shuffle.begin() + _num_moves, _shuffle.end(), rnd_e);
-
-    // Next Move Candidate Identified: now evaluate its win ratio
-    next_move = _shuffle.at(_num_moves);
-    num_win = sw_determine_win_ratio(next_move, rnd_e);
-
-    if (num_next_moves_explored == 0 || 
-        num_win > max_num_win) {
-      max_num_win = num_win;
-      max_next_move = next_move;
-    }
-
-    assert(max_next_move < _shuffle.size());
-
-    now = std::chrono::system_clock::now();
-    elapsed_seconds = start - now;
-    
-    // We have exhausted the time budget: let us take a bet on the winner 
-    // as the next move candidate
-    if (elapsed_seconds.count() > _max_move_time_in_secs)
-      break;
+  uint32_t book_move;
+  // A book move must be open: guards against a collision of keys
+  if (_book && _num_moves <= _book->get_max_moves() &&
+      _book->lookup(_h.get_key(), &book_move) &&
+      std::find(_shuffle.begin() + _num_moves, _shuffle.end(), book_move) !=
+      _shuffle.end()) {
+    DLOG(INFO) << "MCHex: book move " << book_move;
+    ++_num_book_moves;
+    record_next_move(book_move);
+    return;
   }
 
-  DLOG(INFO) << "SW Simulated Winner: NextMove " << max_next_move
-             << ": #Wins " << max_num_win;
+  uint32_t num_open = _dimension*_dimension - _num_moves;
+  TimeManager::TimePoint deadline = _time_manager.start_move(num_open);
+  uint32_t next_move = _strategy->get_next_move(&_shuffle, _num_moves, 
+                                                deadline);
+  _time_manager.end_move();
+  assert(next_move < _shuffle.size());
 
-  record_next_move(max_next_move);
+  record_next_move(next_move);
 
   return;
 }
 
-//! @details: For a given next move we determine the win ratio 
-//! realized as a result of making the specified next move
-//! 2.1. Hold the elements from 0 to _next_move constant - assuming the element in
-//! _next_move index of _shuffle array is the next move explored we permute 
-//! remaining elements as a monte carlo simulation step to evaluate the win ratio.
-//! 2.2. Evaluate the win/loss outcome based on the permutation in step (2.1) 
-//! 2.3. Repeat step (2.1) and (2.2) until DEFAULT_MAX_SIM_TRIALS_ALLOWED or until 
-//! when number of permutations pending exceed what is total possible 
-//! @param[in] next_move the next move under consideration
-//! @return win-ratio i.e. # of wins realized by returned next move
-uint32_t 
-MCHex::sw_determine_win_ratio(const uint32_t next_move,
-                              std::default_random_engine& rnd_e) {
-  uint32_t num_wins =  0;
-  // next_move already pegged: num_moves & pending moves adjusted accordingly
-  uint32_t num_moves = _num_moves + 1; 
-  uint32_t num_open_elements = _dimension*_dimension - _num_moves - 1;
-  uint32_t max_trials = (num_open_elements > _num_open_limit) ? 
-                        _num_sim_trials_allowed : num_open_elements;
-
-  for (uint32_t num_trials = 0; num_trials < max_trials; ++num_trials) {
-    // for the first trial we can just assume the current state of 
-    // _shuffle to reflect a possible sequence of moves - otherwise
-    // we permute the remaining elements
-    if (num_trials > 0) 
-      std::shuffle(_shuffle.begin() + num_moves, _shuffle.end(), rnd_e);
-    
-    // We have now decided all the sequence of moves that is going to unfold
-    // in the game. Let us determine the outsome for this sequence by actually
-    // playing it out. In order to not mess up the "real" game while we 
-    // are playing it in "simulation" we will save and restore the state of Hex
-    _h.save_state();
-
-    // Bind arguments to allow execution of _h.set_next_move 
-    // on each _shuffle member from num_moves onwards
-    for_each(_shuffle.begin() + _num_moves, _shuffle.end(), 
-             std::bind(&Hex::set_next_move, &_h, _1));
-    _h.assess_positions();
-    // Sanity check: game was played to the very end: we must have a winner
-    assert(_h.is_play_over() == true);
-    // SW win count increases if winner is NOT human
-    if (_h.get_winner() != _human_position_choice)
-      ++num_wins;
-    _h.restore_state();
-  }
-
-  DLOG(INFO) << "SW Simulated Num_Moves " << num_moves 
-             << ": Max Trials " << max_trials 
-             << ": Next Move " << next_move << ": # wins " << num_wins;
-
-  return num_wins;
-}
-
 //! @details Record move in the _shuffle array where we keep all the moves
 //! made so far such that _shuffle[0..i..(num_moves-1)] specifies position 
 //! occupied by each player for move # i. All unoccupied positions appear
@@ -21,13 +21,18 @@
 #define _MC_HEX_H_
 // C++ Standard Headers
 #include <iostream>         // std::cout
-#include <random>           // std::default_random_engine
+#include <memory>           // std::unique_ptr
 #include <vector>           // std::vector
 // C Standard Headers
 #include <cassert>
 // Google Headers
 // Local Headers
 #include "games/hex.h"
+#include "games/mc_strategy.h"
+#include "games/mc_uct.h"
+#include "games/opening_book.h"
+#include "games/time_manager.h"
+#include "utils/work_stealing_pool.h"
 
 namespace hexgame { 
 
@@ -48,6 +53,13 @@ class MCHex {
   const static Hex::State DEFAULT_POSITION_CHOICE = Hex::State::RED;
   //! Default time SW is allowed (in secs) by when to make a move
   const static uint32_t DEFAULT_MAX_MOVE_TIME_IN_SECS = 60; 
+  //! Default time SW is allowed (in secs) for all its moves: 0 => unbounded
+  const static uint32_t DEFAULT_MAX_GAME_TIME_IN_SECS = 0; 
+  //! Default: SW does not search while the human thinks i.e. runs are
+  //! replayable (as the front ends HexProtocol & mc_hex_test default to)
+  const static bool     DEFAULT_PONDER = false;
+  //! Default: every candidate next move of flat MC gets the same playouts
+  const static bool     DEFAULT_SUCCESSIVE_HALVING = false;
   //! @brief Default Max # of random moves allowed by SW to compute next move
   //! @details SW is allowed upto move_time (secs) to compute next move
   //! via monte carlo simulation. For each random next move there could
@@ -58,6 +70,10 @@ class MCHex {
   const static uint32_t DEFAULT_MAX_SIM_TRIALS_ALLOWED = 100;
   //! Default bound on # of moves run in game: 0 implies play till terminates
   const static uint32_t DEFAULT_MAX_MOVES = 0;
+  //! Default # of threads searching for the next move of SW
+  const static uint32_t DEFAULT_NUM_THREADS = 1;
+  //! Default search engine generating the moves of SW
+  const static MCStrategy::Type DEFAULT_STRATEGY = MCStrategy::Type::FLAT;
 
   //! @brief Ctor builds MCHex Class used to run SW against Human
   //! @param[in] op_file      file_name used to output hex state
@@ -70,6 +86,17 @@ class MCHex {
   //!            In that case: generate random moves on behalf
   //!            of human & use the same seed for random number generation 
   //!            to replay the exact set of moves
+  //! @param[in] num_threads # of threads searching for the next move of SW
+  //! @param[in] strategy search engine generating the moves of SW
+  //! @param[in] max_game_time_in_secs max secs SW is allowed for all its
+  //!            moves: each move is budgeted a share of the time left
+  //! @param[in] ponder true: SW searches while waiting for the human move 
+  //!            (when the strategy supports it). Moves of SW then depend
+  //!            on how long the human thinks i.e. runs are not replayable
+  //! @param[in] book_file opening book (see OpeningBook) consulted before
+  //!            searching for a move: empty => no book
+  //! @param[in] successive_halving true: flat MC spends its playouts on
+  //!            the candidate next moves still in contention
   explicit MCHex(
       const std::string& op_file,
       const uint32_t     dimension = DEFAULT_HEX_DIMENSION, 
@@ -77,7 +104,13 @@ class MCHex {
       const uint32_t     max_moves = DEFAULT_MAX_MOVES, 
       const bool         auto_test = false,
       const uint32_t     max_move_time_in_secs = DEFAULT_MAX_MOVE_TIME_IN_SECS,
-      const uint32_t     num_sim_trials_allowed = DEFAULT_MAX_SIM_TRIALS_ALLOWED);
+      const uint32_t     num_sim_trials_allowed = DEFAULT_MAX_SIM_TRIALS_ALLOWED,
+      const uint32_t     num_threads = DEFAULT_NUM_THREADS,
+      const MCStrategy::Type strategy = DEFAULT_STRATEGY,
+      const uint32_t     max_game_time_in_secs = DEFAULT_MAX_GAME_TIME_IN_SECS,
+      const bool         ponder = DEFAULT_PONDER,
+      const std::string& book_file = "",
+      const bool         successive_halving = DEFAULT_SUCCESSIVE_HALVING);
   ~MCHex(void);
 
   //! @brief Runs Hex game for upto num_moves or until either Human or SW wins
@@ -92,8 +125,49 @@ class MCHex {
   //! @returns Winner of the hex_game (if any) after num_moves
   Hex::State run(void);
   
+  //! @brief Search engine of the given type for the moves of SW
+  //! @param[in] num_open_limit # open positions below which # trials is
+  //!            bound by # of permutations (see factorial_inverse)
+  //! @param[in] pool threads shared by the strategies of many games:
+  //!            nullptr gives the strategy a pool of num_threads threads
+  //! @param[in] num_tt_entries # of entries of the transposition table of
+  //!            UCT: 0 disables it
+  //! @param[in] successive_halving true: flat MC allocates its playouts to
+  //!            candidates by successive halving
+  static std::unique_ptr<MCStrategy> make_strategy(
+      const MCStrategy::Type strategy,
+      const uint32_t     dimension,
+      const bool         auto_test,
+      const uint32_t     num_sim_trials_allowed,
+      const uint32_t     num_open_limit,
+      const uint32_t     num_threads,
+      utils::WorkStealingPool *pool = nullptr,
+      const uint32_t     num_tt_entries =
+                         UCTStrategy::DEFAULT_NUM_TT_ENTRIES,
+      const bool         successive_halving = DEFAULT_SUCCESSIVE_HALVING);
+
+  //! @brief Returns i the factorial inverse ceiling of a num: f(i) <= num < f(i+1)
+  //! @param[in] num number for which we are computing factorial inverse
+  //! @return floor(factorial_inverse(num))
+  static inline uint32_t factorial_inverse(uint32_t num) {
+    assert(num >= 1);
+    uint32_t fac = 1;
+    for (uint32_t i=1; i<= num; ++i) {
+      fac = fac * i;
+      if (fac == num)
+        return i;
+      if (fac > num)
+        return i-1;
+    }
+    // we should never reach this point of the function
+    assert(false);
+    return 0;
+  }
+
   inline Hex::State get_last_player(void) {return _h.get_last_player();}
   inline uint32_t get_num_moves(void) {return _num_moves;}
+  //! # of moves of SW played from the opening book
+  inline uint32_t get_num_book_moves(void) {return _num_book_moves;}
 
   MCHex(const MCHex &)          = delete; //!< @brief disallow copy ctor  
   MCHex(MCHex &&)               = delete; //!< @brief disallow move ctor
@@ -102,8 +176,6 @@ class MCHex {
 
  protected:
  private:
-  //! Fixed seed generates predictable MC runs when running test SW or debugging
-  const static uint32_t FIXED_SEED_FOR_RANDOM_ENGINE = 13607; 
   using VectorHexMoves = std::vector<uint32_t>; 
   const std::string     _op_file; //!< output file used to save hex game state
   const uint32_t        _dimension; //!< #row/cols for Hex game
@@ -129,6 +201,16 @@ class MCHex {
   //! _shuffle[2*i] & _shuffle[2*i+1]: i(th) move positions by BLUE & RED
   VectorHexMoves        _shuffle;  //!< scratch pad used to generate random moves
   Hex                   _h; //!< Hex Class: Container Object
+  //! search engine generating the next move of SW
+  std::unique_ptr<MCStrategy> _strategy;
+  //! deadline of every move of SW
+  TimeManager           _time_manager;
+  //! true: SW searches while waiting for the human move
+  const bool            _ponder;
+  //! opening moves computed offline: nullptr when no book is used
+  std::unique_ptr<OpeningBook> _book;
+  //! # of moves of SW played from _book
+  uint32_t              _num_book_moves;
   std::ofstream         _ofp;
 
   //! Valiate human input, accept the position (if validate), and assess winner
@@ -137,30 +219,9 @@ class MCHex {
   //! @brief SW plays the next move based on Monte Carlo Simulation
   void sw_play_next_move();
 
-  //! @brief Determine the win ratio based on the generated next move 
-  uint32_t sw_determine_win_ratio(const uint32_t next_move,
-                                  std::default_random_engine& rnd_e);
-
   //! @brief Record move and assess winner
   void record_next_move(uint32_t next_move);
 
-  //! @brief Returns i the factorial inverse ceiling of a num: f(i) <= num < f(i+1)
-  //! @param[in] num number for which we are computing factorial inverse
-  //! @return floor(factorial_inverse(num))
-  static inline uint32_t factorial_inverse(uint32_t num) {
-    assert(num >= 1);
-    uint32_t fac = 1;
-    for (uint32_t i=1; i<= num; ++i) {
-      fac = fac * i;
-      if (fac == num)
-        return i;
-      if (fac > num)
-        return i-1;
-    }
-    // we should never reach this point of the function
-    assert(false);
-    return 0;
-  }
 };
 //-----------------------------------------------------------------------------
 } // namespace games 
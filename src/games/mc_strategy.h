@@ -0,0 +1,174 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     mc_strategy.h
+//! @brief    Definition: interface of the search engines generating SW moves
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _MC_STRATEGY_H_
+#define _MC_STRATEGY_H_
+// C++ Standard Headers
+#include <array>            // std::array
+#include <atomic>           // std::atomic
+#include <iostream>         // std::cout
+#include <string>           // std::string
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/time_manager.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    MCStrategy
+//! @brief    Search engine used by MCHex to generate the next move of SW
+//! @details  The position is passed as a sequence of moves:
+//! moves[0..num_moves) are the positions occupied so far (BLUE first &
+//! players alternate) & moves[num_moves..) are the open positions.
+//! Engines evaluate moves for the player due to play next.
+//! Anytime: the best move found so far is available (from any thread)
+//! while the search is in progress & the search ends by its deadline or
+//! as soon as it is asked to stop.
+//! Pondering: engines that keep statistics across moves may search in the
+//! background while the opponent thinks & reuse the statistics that apply
+//! once the move of the opponent is known.
+class MCStrategy {
+ public:
+  //! Search engines available
+  enum class Type {FLAT=0, UCT};
+  constexpr static uint32_t NUM_TYPES = 2;
+
+  //! Display String: Type Enumerator
+  static inline const std::string& str_type(const Type& t) {
+    static std::array<std::string, NUM_TYPES>
+        TypeStr = {{"flat", "uct"}};
+    return TypeStr.at(static_cast<std::size_t>(t));
+  }
+
+  virtual ~MCStrategy() = default;
+
+  //! Search engine implemented by the strategy
+  virtual Type get_type(void) const = 0;
+
+  //! @brief Best next move for the player due to play
+  //! @param[in,out] moves_p moves played so far followed by open positions:
+  //!                the engine may permute the open positions
+  //! @param[in] num_moves # of moves played so far
+  //! @param[in] deadline search ends once deadline passes
+  //! @return position of the next move
+  virtual uint32_t get_next_move(std::vector<uint32_t> *moves_p,
+                                 uint32_t num_moves,
+                                 TimeManager::TimePoint deadline) = 0;
+
+  //! @brief Best move found so far by the search in progress (or by the
+  //! last search once it is over): safe to call from any thread
+  inline uint32_t get_best_move(void) const { return _best_move.load(); }
+
+  //! @brief Ends the search in progress as soon as possible: the search
+  //! still returns the best move found so far. Sticky: a stop requested
+  //! before get_next_move starts (e.g. while it ends the pondering) ends
+  //! that search at once. The request is cleared once a search ends.
+  inline void stop(void) { _stop.store(true); return; }
+
+  //! @brief Starts searching in the background the position where the
+  //! opponent is due to play: returns at once. Default: no pondering
+  //! @param[in] moves moves played so far followed by open positions:
+  //!            copied before the call returns
+  //! @param[in] num_moves # of moves played so far
+  virtual void start_ponder(const std::vector<uint32_t> &moves,
+                            uint32_t num_moves) { return; }
+
+  //! @brief Ends the background search (if any) & waits for it to end
+  virtual void stop_ponder(void) { return; }
+
+  MCStrategy(const MCStrategy &)     = delete; //!< @brief disallow copy ctor
+  MCStrategy(MCStrategy &&)          = delete; //!< @brief disallow move ctor
+  void operator=(const MCStrategy &) = delete; //!< @brief disallow assignment
+  void operator=(MCStrategy &&)      = delete; //!< @brief disallow move assignment
+
+ protected:
+  using TimePoint = TimeManager::TimePoint;
+  //! @param[in] dimension # rows/columns used for Hex Game
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_sim_trials_allowed max trials SW allowed for each next move
+  MCStrategy(const uint32_t dimension,
+             const bool     auto_test,
+             const uint32_t num_sim_trials_allowed) :
+      _dimension{dimension}, _auto_test{auto_test},
+      _num_sim_trials_allowed{num_sim_trials_allowed},
+      _best_move{0}, _stop{false}, _stop_background{false} {}
+
+  //! Fixed seed generates predictable MC runs when running test SW or debugging
+  const static uint32_t FIXED_SEED_FOR_RANDOM_ENGINE = 13607;
+  const uint32_t        _dimension; //!< #row/cols for Hex game
+  //! Flag is true when the MC class is run from an automated test class
+  const bool            _auto_test;
+  //! Max # of simulation trials allowed for SW for each candidate next move
+  const uint32_t        _num_sim_trials_allowed;
+  //! best move found so far: published by the search in progress
+  std::atomic<uint32_t> _best_move;
+  //! true once a stop is requested: until the search it applies to ends
+  std::atomic<bool>     _stop;
+  //! true while the strategy ends its own background search: never
+  //! touches the stop requested by the caller
+  std::atomic<bool>     _stop_background;
+
+  //! Search begins: nothing explored yet. A stop already requested applies
+  inline void start_search(uint32_t first_open) {
+    _best_move.store(first_open);
+    return;
+  }
+
+  //! Search of get_next_move ended: the stop requested (if any) is served
+  inline void end_search(void) {
+    _stop.store(false);
+    return;
+  }
+
+  //! true when the search should end: deadline passed or stop requested
+  inline bool is_done(const TimePoint &deadline) const {
+    return _stop.load(std::memory_order_relaxed) ||
+        _stop_background.load(std::memory_order_relaxed) ||
+        TimeManager::is_expired(deadline);
+  }
+
+  //! Player due to play after num_moves: BLUE plays the even moves
+  static inline Hex::State get_player(uint32_t num_moves) {
+    return (num_moves % 2 == 0) ? Hex::State::BLUE : Hex::State::RED;
+  }
+};
+
+inline std::ostream& operator << (std::ostream& os,
+                                  const MCStrategy::Type& t) {
+  os << MCStrategy::str_type(t);
+  return os;
+}
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _MC_STRATEGY_H_
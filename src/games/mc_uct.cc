@@ -0,0 +1,452 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file mc_uct.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: UCT Monte Carlo tree search for SW moves
+
+// Standard C++ Headers
+#include <algorithm>        // std::copy, std::equal, std::find, std::min
+#include <cmath>            // std::log, std::sqrt
+#include <future>           // std::future
+#include <iostream>         // std::cout
+#include <random>           // std::random_device
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/mc_uct.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr double              UCTStrategy::UCB1_EXPLORATION;
+constexpr uint32_t            UCTStrategy::CHECK_INTERVAL;
+constexpr uint32_t            UCTStrategy::MAX_RESERVED_NODES;
+constexpr uint32_t            UCTStrategy::MAX_PONDER_ITERATIONS;
+constexpr uint32_t            UCTStrategy::DEFAULT_NUM_TT_ENTRIES;
+constexpr uint32_t            UCTStrategy::MAX_TT_PRIOR;
+constexpr UCTStrategy::NodeId UCTStrategy::NIL;
+// End of Forward Declarations
+
+UCTStrategy::UCTStrategy(const uint32_t dimension,
+                         const bool     auto_test,
+                         const uint32_t num_sim_trials_allowed,
+                         const uint32_t num_threads,
+                         const uint32_t num_tt_entries,
+                         WorkStealingPool *pool) :
+    MCStrategy(dimension, auto_test, num_sim_trials_allowed),
+    _own_pool{(pool == nullptr) ?
+              new WorkStealingPool(num_threads) : nullptr},
+    _pool{(pool == nullptr) ? _own_pool.get() : pool},
+    _zobrist(dimension), _has_trees{false} {
+  if (num_tt_entries > 0)
+    _tt.reset(new TranspositionTable(num_tt_entries));
+  // Private state of every search worker
+  for (uint32_t w = 0; w < num_threads; ++w)
+    _workers.emplace_back(new MCWorker(dimension));
+
+  return;
+}
+
+UCTStrategy::~UCTStrategy() {
+  // Workers must not outlive the trees they grow
+  stop_ponder();
+
+  return;
+}
+
+//! @details Every worker grows its tree rooted at the current position
+//! for its share of the iterations: _num_sim_trials_allowed per open
+//! position. The statistics of the root children are summed across workers
+//! & the most visited move (robust child) is returned: ties are broken by
+//! the # of wins & then by the lower position.
+uint32_t UCTStrategy::get_next_move(std::vector<uint32_t> *moves_p,
+                                    uint32_t num_moves,
+                                    TimePoint deadline) {
+  uint32_t num_positions = _dimension*_dimension;
+  uint32_t num_open_elements = num_positions - num_moves;
+  assert(num_open_elements > 0);
+  // Trees grown while pondering are reused from here on
+  stop_ponder();
+  start_search(moves_p->at(num_moves));
+  prepare_workers(*moves_p, num_moves);
+
+  uint32_t num_workers = _workers.size();
+  uint32_t num_iterations = _num_sim_trials_allowed*num_open_elements;
+  std::vector<std::future<std::vector<MCResult>>> results;
+  for (uint32_t w = 0; w < num_workers; ++w) {
+    uint32_t share = num_iterations/num_workers +
+                     ((w < num_iterations % num_workers) ? 1 : 0);
+    results.push_back(_pool->submit([this, w, num_moves, share, deadline]() {
+          return search(w, num_moves, share, deadline);
+        }));
+  }
+
+  // Merge: sum the statistics of every root child across the workers
+  std::vector<uint32_t> visits(num_positions, 0), wins(num_positions, 0);
+  for (auto &r : results) {
+    for (const MCResult &c : _pool->get(r)) {
+      visits.at(c.move) += c.visits;
+      wins.at(c.move)   += c.wins;
+    }
+  }
+  uint32_t best = num_positions;
+  for (uint32_t move = 0; move < num_positions; ++move) {
+    if (visits.at(move) == 0)
+      continue;
+    if (best == num_positions || visits.at(move) > visits.at(best) ||
+        (visits.at(move) == visits.at(best) && wins.at(move) > wins.at(best)))
+      best = move;
+  }
+  assert(best < num_positions);
+  _best_move.store(best);
+
+  DLOG(INFO) << "SW UCT Winner: NextMove " << best
+             << ": #Visits " << visits.at(best) << ": #Wins " << wins.at(best);
+
+  end_search();
+  return best;
+}
+
+//! @details The search continues on the trees of the workers (re-rooted at
+//! the position of the opponent) until stop_ponder. Its results are
+//! dropped: the trees are what the next get_next_move reuses.
+//! @param[in] moves moves played so far followed by open positions
+//! @param[in] num_moves # of moves played so far
+void UCTStrategy::start_ponder(const std::vector<uint32_t> &moves,
+                               uint32_t num_moves) {
+  uint32_t num_open_elements = _dimension*_dimension - num_moves;
+  if (num_open_elements == 0)
+    return;
+  stop_ponder();
+  start_search(moves.at(num_moves));
+  prepare_workers(moves, num_moves);
+
+  uint32_t num_workers = _workers.size();
+  TimePoint never = TimePoint::max();
+  for (uint32_t w = 0; w < num_workers; ++w) {
+    uint32_t share = MAX_PONDER_ITERATIONS/num_workers;
+    _ponder_results.push_back(
+        _pool->submit([this, w, num_moves, share, never]() {
+            return search(w, num_moves, share, never);
+          }));
+  }
+
+  DLOG(INFO) << "SW UCT Pondering: # Moves " << num_moves;
+
+  return;
+}
+
+void UCTStrategy::stop_ponder(void) {
+  if (_ponder_results.empty())
+    return;
+  // A stop requested by the caller meanwhile applies to the next search
+  _stop_background.store(true);
+  for (auto &r : _ponder_results)
+    _pool->get(r);
+  _ponder_results.clear();
+  _stop_background.store(false);
+
+  return;
+}
+
+//! @details The trees of the workers are reused when they are rooted at a
+//! position the moves played so far lead from: every tree is re-rooted at
+//! the node reached by those moves. A tree that never explored those moves
+//! (or no tree at all) is replaced by a fresh root whose children are 
+//! expanded in a random order of the open positions.
+//! @param[in] moves moves played so far followed by open positions
+//! @param[in] num_moves # of moves played so far
+void UCTStrategy::prepare_workers(const std::vector<uint32_t> &moves,
+                                  uint32_t num_moves) {
+  uint32_t num_open_elements = _dimension*_dimension - num_moves;
+  bool reuse = _has_trees && _root_moves.size() <= num_moves &&
+      std::equal(_root_moves.begin(), _root_moves.end(), moves.begin());
+
+  // moves[0..num_moves) are the moves played so far starting with BLUE
+  HexBitBoard board(_dimension);
+  board.play_moves(moves.begin(), moves.begin() + num_moves,
+                   Hex::State::BLUE);
+  uint64_t root_key = _zobrist.get_key(moves.begin(),
+                                       moves.begin() + num_moves);
+
+  uint32_t num_reused = 0;
+  for (uint32_t w = 0; w < _workers.size(); ++w) {
+    MCWorker &worker = *_workers.at(w);
+    uint32_t seed = (_auto_test == true) ?
+                    FIXED_SEED_FOR_RANDOM_ENGINE + w:
+                    std::random_device{}();
+    worker.rnd_e.seed(seed);
+    if (reuse && reroot(moves.begin() + _root_moves.size(),
+                        moves.begin() + num_moves, &worker)) {
+      ++num_reused;
+    } else {
+      // Order in which a worker expands the children of the root
+      worker.root_open.assign(moves.begin() + num_moves, moves.end());
+      worker.rnd_e.shuffle(worker.root_open.begin(), worker.root_open.end());
+      worker.tree.clear();
+      worker.tree.push_back(Node{0, NIL, NIL, 0, 0, 0});
+    }
+    assert(worker.root_open.size() == num_open_elements);
+    worker.open.resize(num_open_elements);
+    worker.board = board;
+    worker.root_key = root_key;
+  }
+  _root_moves.assign(moves.begin(), moves.begin() + num_moves);
+  _has_trees = true;
+
+  DLOG(INFO) << "SW UCT # Moves " << num_moves << ": trees reused "
+             << num_reused << "/" << _workers.size()
+             << ": root visits " << _workers.at(0)->tree.at(0).visits;
+
+  return;
+}
+
+//! @details Descends from the root along the moves of [first, last): the
+//! k(th) step plays its move at the front of the open positions exactly as
+//! iterations do, so root_open keeps the expansion order of the subtree.
+//! The subtree is copied (breadth first, child order kept) into a fresh
+//! tree & the rest of the nodes dropped.
+//! @param[in] first first move played since the root of the tree
+//! @param[in] last end of the moves played since the root of the tree
+//! @param[in,out] worker_p tree & root_open of the worker
+//! @return false when the tree never explored the moves: worker unchanged
+bool UCTStrategy::reroot(std::vector<uint32_t>::const_iterator first,
+                         std::vector<uint32_t>::const_iterator last,
+                         MCWorker *worker_p) {
+  std::vector<Node> &tree = worker_p->tree;
+  NodeId node = 0;
+  for (auto it = first; it != last; ++it) {
+    NodeId c = tree.at(node).child;
+    while (c != NIL && tree.at(c).move != *it)
+      c = tree.at(c).sibling;
+    if (c == NIL)
+      return false;
+    node = c;
+  }
+  if (node == 0)
+    return true;
+
+  std::vector<uint32_t> &root_open = worker_p->root_open;
+  for (auto it = first; it != last; ++it) {
+    auto pos = std::find(root_open.begin(), root_open.end(), *it);
+    assert(pos != root_open.end());
+    std::swap(*root_open.begin(), *pos);
+    root_open.erase(root_open.begin());
+  }
+
+  // sub[i] is the copy of tree[old_ids[i]]
+  std::vector<Node>   sub{tree.at(node)};
+  std::vector<NodeId> old_ids{node};
+  sub.at(0).sibling = NIL;
+  for (NodeId i = 0; i < sub.size(); ++i) {
+    NodeId prev = NIL;
+    NodeId c = tree.at(old_ids.at(i)).child;
+    sub.at(i).child = NIL;
+    for (; c != NIL; c = tree.at(c).sibling) {
+      NodeId copy = sub.size();
+      sub.push_back(tree.at(c));
+      old_ids.push_back(c);
+      sub.at(copy).sibling = NIL;
+      if (prev == NIL)
+        sub.at(i).child = copy;
+      else
+        sub.at(prev).sibling = copy;
+      prev = copy;
+    }
+  }
+  tree.swap(sub);
+
+  return true;
+}
+
+//! @details Worker w runs num_iterations iterations on its private tree
+//! unless the deadline passes or the search is asked to stop earlier.
+//! @param[in] w index of the worker
+//! @param[in] num_moves # of moves played so far
+//! @param[in] num_iterations # of iterations allotted to the worker
+//! @param[in] deadline time by when the search ends
+//! @return statistics of the children of the root
+std::vector<UCTStrategy::MCResult>
+UCTStrategy::search(uint32_t w, uint32_t num_moves,
+                    uint32_t num_iterations, TimePoint deadline) {
+  MCWorker &worker = *_workers.at(w);
+  // Every iteration adds at most one node: the root is tree[0]
+  uint32_t num_nodes = worker.tree.size() + num_iterations;
+  worker.tree.reserve(std::min(num_nodes, MAX_RESERVED_NODES));
+
+  for (uint32_t i = 0; i < num_iterations; ++i) {
+    iterate(&worker, num_moves);
+
+    // Reading the clock costs more than an iteration on small boards
+    if (i % CHECK_INTERVAL != CHECK_INTERVAL - 1)
+      continue;
+    // Anytime: best move so far is ready should the search be cut short
+    if (w == 0)
+      _best_move.store(worker.tree.at(most_visited_child(worker.tree, 0)).move);
+    if (is_done(deadline))
+      break;
+  }
+
+  std::vector<MCResult> results;
+  for (NodeId c = worker.tree.at(0).child; c != NIL;
+       c = worker.tree.at(c).sibling) {
+    const Node &n = worker.tree.at(c);
+    results.push_back(MCResult{n.move, n.visits, n.wins});
+  }
+
+  return results;
+}
+
+//! @details
+//! 1. Select: starting at the root descend to the child with the best UCB1
+//!    score while every open position of a node is already its child.
+//! 2. Expand: add the next open position of the node as its new child.
+//!    The open positions of a node are ordered identically on every visit
+//!    as every iteration replays the moves of its path on the open
+//!    positions of the root: its k(th) child is open[depth + k]. The new
+//!    child starts from the statistics of its position in the
+//!    transposition table (if any).
+//! 3. Playout: randomly permute the remaining open positions & play them
+//!    alternately on a copy of the current position.
+//! 4. Back up: every node on the path (& its position in the transposition
+//!    table) counts the visit & the win when the player who made its move
+//!    won the playout.
+//! @param[in,out] worker_p private tree, random stream & board of the worker
+//! @param[in] num_moves # of moves played so far
+void UCTStrategy::iterate(MCWorker *worker_p, uint32_t num_moves) {
+  std::vector<Node>     &tree = worker_p->tree;
+  std::vector<uint32_t> &open = worker_p->open;
+  std::vector<uint32_t> &where = worker_p->where;
+  uint32_t num_open_elements = open.size();
+
+  std::copy(worker_p->root_open.begin(), worker_p->root_open.end(),
+            open.begin());
+  for (uint32_t i = 0; i < num_open_elements; ++i)
+    where.at(open.at(i)) = i;
+
+  worker_p->path.clear();
+  worker_p->path.push_back(0);
+  worker_p->keys.clear();
+  worker_p->keys.push_back(worker_p->root_key);
+  NodeId node = 0;
+  for (uint32_t depth = 0; depth < num_open_elements; ++depth) {
+    bool expanded = tree.at(node).num_children < num_open_elements - depth;
+    if (expanded) {
+      // Expand: link the new child at the head of the list of children
+      NodeId child = tree.size();
+      uint32_t move = open.at(depth + tree.at(node).num_children);
+      tree.push_back(Node{move, NIL, tree.at(node).child, 0, 0, 0});
+      tree.at(node).child = child;
+      ++tree.at(node).num_children;
+      node = child;
+    } else {
+      node = select_child(tree, node);
+    }
+    worker_p->path.push_back(node);
+    // Move of node occupies open[depth]
+    uint32_t move = tree.at(node).move;
+    uint32_t i = where.at(move);
+    std::swap(open.at(depth), open.at(i));
+    where.at(open.at(i)) = i;
+    where.at(move) = depth;
+    uint64_t key = worker_p->keys.back() ^
+        _zobrist.get_stone_key(move, get_player(num_moves + depth));
+    worker_p->keys.push_back(key);
+    if (expanded) {
+      TranspositionTable::Stats st;
+      if (_tt && _tt->lookup(key, &st) && st.visits > 0) {
+        // Wins scaled down with the visits: the win ratio is kept
+        Node &n = tree.at(node);
+        n.visits = std::min(st.visits, MAX_TT_PRIOR);
+        n.wins = static_cast<uint32_t>(
+            static_cast<uint64_t>(st.wins)*n.visits/st.visits);
+      }
+      // Node just expanded: the rest of the game is played out at random
+      worker_p->rnd_e.shuffle(open.begin() + depth + 1, open.end());
+      break;
+    }
+  }
+
+  HexBitBoard board = worker_p->board;
+  board.play_moves(open.begin(), open.end(), get_player(num_moves));
+  Hex::State winner = board.get_winner();
+  assert(winner != Hex::State::EMPTY);
+
+  // Node at depth d of the path holds move # num_moves + d - 1
+  ++tree.at(0).visits;
+  for (uint32_t d = 1; d < worker_p->path.size(); ++d) {
+    Node &n = tree.at(worker_p->path.at(d));
+    bool win = (get_player(num_moves + d - 1) == winner);
+    ++n.visits;
+    if (win)
+      ++n.wins;
+    if (_tt)
+      _tt->update(worker_p->keys.at(d), win);
+  }
+
+  return;
+}
+
+//! @details UCB1: wins/visits + C*sqrt(ln(parent visits)/visits). Every
+//! child has been visited once when it was expanded.
+//! @param[in] tree nodes of the tree of a worker
+//! @param[in] node parent whose children are all expanded
+//! @return child with the best score: first in the list on ties
+UCTStrategy::NodeId
+UCTStrategy::select_child(const std::vector<Node> &tree, NodeId node) {
+  double log_visits = std::log(static_cast<double>(tree.at(node).visits));
+  NodeId best = NIL;
+  double best_score = 0;
+  for (NodeId c = tree.at(node).child; c != NIL; c = tree.at(c).sibling) {
+    const Node &n = tree.at(c);
+    assert(n.visits > 0);
+    double score = static_cast<double>(n.wins)/n.visits +
+                   UCB1_EXPLORATION*std::sqrt(log_visits/n.visits);
+    if (best == NIL || score > best_score) {
+      best = c;
+      best_score = score;
+    }
+  }
+  assert(best != NIL);
+
+  return best;
+}
+
+//! @param[in] tree nodes of the tree of a worker
+//! @param[in] node parent with at least one child
+//! @return child with the most visits: first in the list on ties
+UCTStrategy::NodeId
+UCTStrategy::most_visited_child(const std::vector<Node> &tree, NodeId node) {
+  NodeId best = tree.at(node).child;
+  assert(best != NIL);
+  for (NodeId c = tree.at(best).sibling; c != NIL; c = tree.at(c).sibling) {
+    if (tree.at(c).visits > tree.at(best).visits)
+      best = c;
+  }
+
+  return best;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
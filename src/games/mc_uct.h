@@ -0,0 +1,208 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     mc_uct.h
+//! @brief    Definition: UCT Monte Carlo tree search for SW moves
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _MC_UCT_H_
+#define _MC_UCT_H_
+// C++ Standard Headers
+#include <memory>           // std::unique_ptr
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_bitboard.h"
+#include "games/hex_zobrist.h"
+#include "games/mc_strategy.h"
+#include "games/transposition_table.h"
+#include "utils/random.h"
+#include "utils/work_stealing_pool.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    UCTStrategy
+//! @brief    UCT: Monte Carlo tree search selecting children by UCB1
+//! @details  Every iteration descends the tree from the current position
+//!           choosing the child with the best UCB1 score, expands one new
+//!           child (lazily: a node grows one child per visit until all open
+//!           positions are children), plays the rest of the game out at
+//!           random & backs the winner up the path. Each node keeps the
+//!           # of visits & the # of wins of the player who made its move.
+//!           Root parallel: every worker grows a private tree with a private
+//!           random stream. The visits of the root children are summed
+//!           across workers & the most visited move is played.
+//!           Anytime: worker 0 publishes the most visited child of its
+//!           root & checks the deadline every CHECK_INTERVAL iterations.
+//!           Trees are kept across moves: the next search re-roots every
+//!           tree at the node reached by the moves played since (subtree
+//!           copied & the rest dropped) or starts afresh when the moves
+//!           leave the tree. Pondering grows the trees in the background
+//!           while the opponent is due to play.
+//!           Transpositions: every playout is also counted in a table of
+//!           statistics keyed by the Zobrist key of the positions on its
+//!           path, shared by all workers. A node expanded at a position
+//!           already searched (via another order of moves or by another
+//!           worker) starts from those statistics (up to MAX_TT_PRIOR
+//!           visits) instead of a single playout. Runs of more than one
+//!           worker then depend on the timing of the threads.
+//!           The workers run on a pool of the strategy or on a pool shared
+//!           by the strategies of many games: pondering holds threads of
+//!           the pool until stop_ponder.
+class UCTStrategy : public MCStrategy {
+ public:
+  //! Exploration constant of UCB1: wins/visits + C*sqrt(ln(N)/visits)
+  constexpr static double UCB1_EXPLORATION = 0.7;
+  //! # of iterations between checks of the deadline
+  constexpr static uint32_t CHECK_INTERVAL = 64;
+  //! Cap of nodes reserved upfront: a deadline may end the search early
+  constexpr static uint32_t MAX_RESERVED_NODES = 1 << 20;
+  //! Cap of iterations of pondering: bounds the memory of the trees
+  constexpr static uint32_t MAX_PONDER_ITERATIONS = 1 << 22;
+  //! Default # of entries of the transposition table: off. It left the
+  //! strength unchanged & made iterations ~14% costlier (16 bytes each)
+  constexpr static uint32_t DEFAULT_NUM_TT_ENTRIES = 0;
+  //! Cap of visits a node expanded takes from the transposition table
+  constexpr static uint32_t MAX_TT_PRIOR = 32;
+
+  //! @param[in] dimension # rows/columns used for Hex Game
+  //! @param[in] auto_test true: use the same seed for random number generation
+  //! @param[in] num_sim_trials_allowed # iterations allowed for SW for each
+  //!            open position i.e. budget is trials * # open positions
+  //! @param[in] num_threads # of threads (trees) searching for the next move
+  //! @param[in] num_tt_entries # of entries of the transposition table:
+  //!            0 disables it
+  //! @param[in] pool threads running the workers: nullptr gives the strategy
+  //!            a pool of num_threads threads. A shared pool must outlive
+  //!            the strategy: num_threads is then the # of workers
+  UCTStrategy(const uint32_t dimension,
+              const bool     auto_test,
+              const uint32_t num_sim_trials_allowed,
+              const uint32_t num_threads,
+              const uint32_t num_tt_entries = DEFAULT_NUM_TT_ENTRIES,
+              utils::WorkStealingPool *pool = nullptr);
+  ~UCTStrategy();
+
+  inline Type get_type(void) const override { return Type::UCT; }
+
+  //! @brief Best next move for the player due to play
+  //! @details moves is left unchanged: ends pondering (if any) first
+  uint32_t get_next_move(std::vector<uint32_t> *moves_p,
+                         uint32_t num_moves,
+                         TimePoint deadline) override;
+
+  //! @brief Grows the trees in the background until stop_ponder
+  void start_ponder(const std::vector<uint32_t> &moves,
+                    uint32_t num_moves) override;
+
+  void stop_ponder(void) override;
+
+ protected:
+ private:
+  //! Index of a node in the tree of a worker: NIL marks no node
+  using NodeId = uint32_t;
+  constexpr static NodeId NIL = static_cast<NodeId>(-1);
+  //! @brief Node of the search tree: one per position explored
+  //! @details children form a singly linked list via sibling
+  struct Node {
+    uint32_t move;         //!< position occupied by the move into the node
+    NodeId   child;        //!< most recently expanded child
+    NodeId   sibling;      //!< next child of the parent
+    uint32_t num_children; //!< # of children expanded so far
+    uint32_t visits;       //!< # of iterations through the node
+    uint32_t wins;         //!< # of those won by the player of move
+  };
+  //! @brief Private state of a search worker
+  //! @details iterations of a worker never touch the game or other workers
+  struct MCWorker {
+    explicit MCWorker(uint32_t dimension) :
+        open(dimension*dimension), where(dimension*dimension),
+        root_open(dimension*dimension), board(dimension) {}
+    std::vector<Node>          tree;      //!< tree[0] is the root
+    //! open[0..depth) are the moves of the path & open[depth..) are open
+    std::vector<uint32_t>      open;
+    std::vector<uint32_t>      where;     //!< index of a position in open
+    std::vector<uint32_t>      root_open; //!< open positions at the root
+    std::vector<NodeId>        path;      //!< nodes visited by an iteration
+    std::vector<uint64_t>      keys;      //!< keys of the positions of path
+    uint64_t                   root_key;  //!< key of the root position
+    utils::FastRandom          rnd_e;     //!< private random stream
+    HexBitBoard                board;     //!< current position
+  };
+  //! Statistics of a root child found by a worker
+  struct MCResult {
+    uint32_t move;         //!< candidate position
+    uint32_t visits;       //!< # iterations through the candidate
+    uint32_t wins;         //!< # of those won by SW
+  };
+
+  //! pool owned by the strategy: nullptr when the pool is shared
+  std::unique_ptr<utils::WorkStealingPool> _own_pool;
+  //! threads searching for the next move of SW
+  utils::WorkStealingPool *_pool;
+  //! keys of the positions searched
+  const HexZobrist      _zobrist;
+  //! statistics of positions shared by the workers: nullptr when disabled
+  std::unique_ptr<TranspositionTable> _tt;
+  //! private state of each search worker: one per thread of the search
+  std::vector<std::unique_ptr<MCWorker>> _workers;
+  //! moves played at the root of the trees of the workers
+  std::vector<uint32_t> _root_moves;
+  //! true when the trees of the workers are rooted at _root_moves
+  bool                  _has_trees;
+  //! searches of the workers pondering in the background
+  std::vector<std::future<std::vector<MCResult>>> _ponder_results;
+
+  //! @brief Roots the tree of every worker at moves[0..num_moves)
+  void prepare_workers(const std::vector<uint32_t> &moves, 
+                       uint32_t num_moves);
+
+  //! @brief Re-roots the tree of a worker at the node reached by path
+  static bool reroot(std::vector<uint32_t>::const_iterator first,
+                     std::vector<uint32_t>::const_iterator last,
+                     MCWorker *worker_p);
+
+  //! @brief Worker w grows its tree for num_iterations or until time is up
+  std::vector<MCResult> search(uint32_t w, uint32_t num_moves,
+                               uint32_t num_iterations, TimePoint deadline);
+
+  //! @brief Single iteration: select, expand, playout & back up
+  void iterate(MCWorker *worker_p, uint32_t num_moves);
+
+  //! @brief Child of node with the best UCB1 score
+  static NodeId select_child(const std::vector<Node> &tree, NodeId node);
+
+  //! @brief Child of node with the most visits
+  static NodeId most_visited_child(const std::vector<Node> &tree, 
+                                   NodeId node);
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _MC_UCT_H_
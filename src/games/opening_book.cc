@@ -0,0 +1,171 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file opening_book.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: memory mapped book of Hex opening moves
+
+// Standard C++ Headers
+#include <cstdio>           // std::rename
+#include <fstream>          // std::ofstream
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // close
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/opening_book.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint64_t OpeningBook::MAGIC;
+constexpr uint32_t OpeningBook::VERSION;
+constexpr uint32_t OpeningBook::EMPTY_SLOT;
+// End of Forward Declarations
+
+OpeningBook::OpeningBook(const std::string &file_name,
+                         const uint32_t dimension) :
+    _zobrist(dimension), _addr{nullptr}, _size{0},
+    _header_p{nullptr}, _slots_p{nullptr} {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::stringstream ss;
+    ss << "OpeningBook: can't open book file " << file_name;
+    throw ss.str();
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    std::stringstream ss;
+    ss << "OpeningBook: " << file_name << ": too short for a book";
+    throw ss.str();
+  }
+  _size = st.st_size;
+  _addr = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping holds the file open
+  close(fd);
+  if (_addr == MAP_FAILED) {
+    std::stringstream ss;
+    ss << "OpeningBook: can't map book file " << file_name;
+    throw ss.str();
+  }
+  _header_p = static_cast<const Header *>(_addr);
+  _slots_p  = reinterpret_cast<const Entry *>(_header_p + 1);
+
+  const Header &h = *_header_p;
+  std::stringstream ss;
+  if (h.magic != MAGIC || h.version != VERSION)
+    ss << "not a book of version " << VERSION;
+  else if (h.dimension != dimension)
+    ss << "book of dimension " << h.dimension << " used for " << dimension;
+  else if (h.zobrist_key != _zobrist.get_empty_key())
+    ss << "book hashed by other Zobrist keys";
+  else if (h.num_slots == 0 || (h.num_slots & (h.num_slots - 1)) != 0 ||
+           h.num_entries >= h.num_slots ||
+           _size != sizeof(Header) + h.num_slots*sizeof(Entry))
+    ss << "corrupt table: # slots " << h.num_slots
+       << ": # entries " << h.num_entries << ": file size " << _size;
+  if (!ss.str().empty()) {
+    munmap(_addr, _size);
+    throw "OpeningBook: " + file_name + ": " + ss.str();
+  }
+
+  DLOG(INFO) << "OpeningBook: " << file_name
+             << ": # entries " << h.num_entries
+             << ": # slots " << h.num_slots
+             << ": max moves " << h.max_moves;
+
+  return;
+}
+
+OpeningBook::~OpeningBook() {
+  munmap(_addr, _size);
+  return;
+}
+
+//! @details the table always has an empty slot: the probe terminates
+bool OpeningBook::lookup(uint64_t key, uint32_t *move_p) const {
+  const uint64_t mask = _header_p->num_slots - 1;
+  for (uint64_t i = key & mask; ; i = (i + 1) & mask) {
+    const Entry &e = _slots_p[i];
+    if (e.move == EMPTY_SLOT)
+      return false;
+    if (e.key == key) {
+      *move_p = e.move;
+      return true;
+    }
+  }
+}
+
+void OpeningBook::write(const std::string &file_name,
+                        const uint32_t dimension,
+                        const uint32_t max_moves,
+                        const std::vector<Entry> &entries) {
+  HexZobrist zobrist(dimension);
+  // At most half full: probes stay short & the table has an empty slot
+  uint64_t num_slots = 1;
+  while (num_slots < 2*entries.size() + 1)
+    num_slots <<= 1;
+  std::vector<Entry> slots(num_slots, Entry{0, EMPTY_SLOT});
+  for (const Entry &e : entries) {
+    if (e.move >= dimension*dimension) {
+      std::stringstream ss;
+      ss << "OpeningBook: key " << e.key << ": move " << e.move
+         << " off a board of dimension " << dimension;
+      throw ss.str();
+    }
+    uint64_t i = e.key & (num_slots - 1);
+    for (; slots.at(i).move != EMPTY_SLOT; i = (i + 1) & (num_slots - 1)) {
+      if (slots.at(i).key == e.key) {
+        std::stringstream ss;
+        ss << "OpeningBook: key " << e.key << " entered twice";
+        throw ss.str();
+      }
+    }
+    slots.at(i) = e;
+  }
+
+  Header h{MAGIC, VERSION, dimension, zobrist.get_empty_key(), num_slots,
+           static_cast<uint32_t>(entries.size()), max_moves};
+  std::string tmp_file_name = file_name + ".tmp";
+  std::ofstream ofs(tmp_file_name, std::ios::out | std::ios::binary);
+  ofs.write(reinterpret_cast<const char *>(&h), sizeof(h));
+  ofs.write(reinterpret_cast<const char *>(slots.data()),
+            slots.size()*sizeof(Entry));
+  ofs.close();
+  if (!ofs || std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+    std::stringstream ss;
+    ss << "OpeningBook: can't write book file " << file_name;
+    throw ss.str();
+  }
+
+  DLOG(INFO) << "OpeningBook: wrote " << file_name
+             << ": # entries " << entries.size()
+             << ": # slots " << num_slots;
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
@@ -0,0 +1,136 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     opening_book.h
+//! @brief    Definition: memory mapped book of Hex opening moves
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _OPENING_BOOK_H_
+#define _OPENING_BOOK_H_
+// C++ Standard Headers
+#include <string>           // std::string
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>
+#include <cstddef>          // std::size_t
+#include <cstdint>          // uint64_t
+// Google Headers
+// Local Headers
+#include "games/hex_zobrist.h"
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    OpeningBook
+//! @brief    Best moves of early positions computed offline: looked up by
+//!           the Zobrist key of the position
+//! @details  The book file is a Header followed by an open addressing hash
+//!           table of num_slots (a power of 2) Entry slots probed linearly
+//!           from key & (num_slots - 1): an empty slot ends the probe. The
+//!           table is at most half full. The file is mapped read only &
+//!           shared: every game (& process) on a host reads the same pages
+//!           of the page cache & a lookup touches one or two cache lines.
+//!           Numbers are stored in the byte order of the host writing the
+//!           book: a book is generated where it is used.
+//! EXAMPLE USAGE:
+//!   OpeningBook::write("hex11.book", 11, 2, entries);  // offline
+//!   OpeningBook book("hex11.book", 11);
+//!   uint32_t move;
+//!   if (book.lookup(moves, num_moves, &move)) ...play move...
+class OpeningBook {
+ public:
+  //! Identifies a book file: first bytes of the file
+  constexpr static uint64_t MAGIC = 0x314b4f4f42584548ULL; // "HEXBOOK1"
+  //! Version of the layout of the file
+  constexpr static uint32_t VERSION = 2;
+  //! Move of a slot holding no entry
+  constexpr static uint32_t EMPTY_SLOT = static_cast<uint32_t>(-1);
+
+  //! @brief Layout of the start of the file
+  struct Header {
+    uint64_t magic;        //!< MAGIC
+    uint32_t version;      //!< VERSION
+    uint32_t dimension;    //!< # rows/columns of the boards in the book
+    uint64_t zobrist_key;  //!< empty board key: detects a change of keys
+    uint64_t num_slots;    //!< # slots of the table: a power of 2
+    uint32_t num_entries;  //!< # slots holding an entry
+    uint32_t max_moves;    //!< # moves of the deepest position in the book
+  };
+  //! @brief Slot of the table: best move of a position
+  struct Entry {
+    uint64_t key;          //!< Zobrist key of the position
+    uint32_t move;         //!< best move: EMPTY_SLOT when the slot is free
+  };
+
+  //! @brief Maps a book file read only
+  //! @param[in] file_name book written by write
+  //! @param[in] dimension # rows/columns of the games the book is used in
+  OpeningBook(const std::string &file_name, const uint32_t dimension);
+  ~OpeningBook();
+
+  //! @brief Best move of the position with the key (if in the book)
+  //! @param[out] move_p best move when found
+  //! @return true when the position is in the book
+  bool lookup(uint64_t key, uint32_t *move_p) const;
+
+  //! @brief Best move after moves[0..num_moves) starting with BLUE
+  inline bool lookup(const std::vector<uint32_t> &moves,
+                     uint32_t num_moves, uint32_t *move_p) const {
+    assert(num_moves <= moves.size());
+    if (num_moves > _header_p->max_moves)
+      return false;
+    return lookup(_zobrist.get_key(moves.begin(), moves.begin() + num_moves),
+                  move_p);
+  }
+
+  inline uint32_t get_num_entries(void) const {
+    return _header_p->num_entries;
+  }
+  inline uint32_t get_max_moves(void) const { return _header_p->max_moves; }
+
+  //! @brief Writes a book of entries (keys unique) replacing file_name
+  //! @details written aside & renamed over file_name: games mapping the
+  //! old book keep reading it until they map the book again
+  static void write(const std::string &file_name, const uint32_t dimension,
+                    const uint32_t max_moves,
+                    const std::vector<Entry> &entries);
+
+  OpeningBook(const OpeningBook &)    = delete; //!< @brief disallow copy ctor
+  OpeningBook(OpeningBook &&)         = delete; //!< @brief disallow move ctor
+  void operator=(const OpeningBook &) = delete; //!< @brief disallow assignment
+  void operator=(OpeningBook &&)      = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  const HexZobrist _zobrist;   //!< keys of the positions of the book
+  void            *_addr;      //!< start of the mapping
+  std::size_t      _size;      //!< # bytes mapped
+  const Header    *_header_p;  //!< start of the file
+  const Entry     *_slots_p;   //!< table following the header
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _OPENING_BOOK_H_
@@ -0,0 +1,291 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <chrono>           // std::chrono::milliseconds
+#include <exception>        // std::exception
+#include <future>           // std::future
+#include <iostream>         // std::cout
+#include <string>           // std::string
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/game_service.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_string(strategy);
+DECLARE_int32(threads);
+DECLARE_int32(num_games);
+DECLARE_int32(num_trials);
+DECLARE_bool(auto_test);
+
+using Clock = TimeManager::Clock;
+using std::chrono::milliseconds;
+
+static MCStrategy::Type GetStrategy(void) {
+  return (FLAGS_strategy == "uct") ?
+      MCStrategy::Type::UCT : MCStrategy::Type::FLAT;
+}
+
+// true when func throws a std::string containing what
+template <typename Func>
+static bool Throws(Func func, const std::string &what) {
+  try {
+    func();
+  }
+  catch (const std::string s) {
+    return s.find(what) != std::string::npos;
+  }
+  return false;
+}
+
+// Games & requests beyond capacity are refused: so are requests & moves
+// of a game with a move in progress
+static void AdmissionTest(void) {
+  // Trials outlast the deadlines: every search runs until its deadline
+  GameService service(GetStrategy(), 1, 3, 1, true, 1 << 20);
+  GameService::GameId g0 = service.open_game(5);
+  GameService::GameId g1 = service.open_game(5);
+  GameService::GameId g2 = service.open_game(5);
+  CHECK(Throws([&service]() { service.open_game(5); }, "at capacity"));
+  CHECK(Throws([&service]() { service.open_game(2); }, "dimension"));
+  CHECK_EQ(service.get_num_games(), 3);
+
+  CHECK(Throws([&service, g0]() { service.play_move(g0, 25); },
+               "illegal move"));
+  service.play_move(g0, 12);
+  CHECK(Throws([&service, g0]() { service.play_move(g0, 12); },
+               "illegal move"));
+  CHECK(Throws([&service, g0]() {
+        service.request_move(g0, Clock::now() - milliseconds(1));
+      }, "overloaded")) << "expired deadline admitted";
+
+  // g0 runs on the only thread: g1 waits & g2 finds the queue full
+  std::future<uint32_t> m0 =
+      service.request_move(g0, Clock::now() + milliseconds(200));
+  std::future<uint32_t> m1 =
+      service.request_move(g1, Clock::now() + milliseconds(400));
+  CHECK_EQ(service.get_num_queued(), 1);
+  CHECK(Throws([&service, g2]() {
+        service.request_move(g2, Clock::now() + milliseconds(400));
+      }, "overloaded"));
+  CHECK(Throws([&service, g0]() { service.play_move(g0, 0); },
+               "in progress"));
+  CHECK(Throws([&service, g1]() { service.close_game(g1); },
+               "in progress"));
+  CHECK(Throws([&service]() { service.close_game(99); }, "unknown"));
+  CHECK_EQ(service.get_num_rejected(), 3);
+
+  uint32_t v0 = m0.get();
+  CHECK_NE(v0, 12) << "occupied position played";
+  CHECK_LT(v0, 25);
+  CHECK_LT(m1.get(), 25);
+  CHECK_EQ(service.get_num_moves(g0), 2);
+  CHECK_EQ(service.get_num_moves(g1), 1);
+  service.close_game(g1);
+  CHECK_EQ(service.get_num_games(), 2);
+
+  // Requests still waiting at destruction are dropped
+  std::future<uint32_t> m2 =
+      service.request_move(g2, Clock::now() + milliseconds(2000));
+
+  return;
+}
+
+// Requests waiting for a thread are served earliest deadline first
+static void FairnessTest(void) {
+  GameService service(GetStrategy(), 1, 3, 3, true, 1 << 20);
+  std::vector<GameService::GameId> g;
+  for (uint32_t i = 0; i < 3; ++i)
+    g.push_back(service.open_game(5));
+
+  Clock::time_point start = Clock::now();
+  std::future<uint32_t> m0 =
+      service.request_move(g.at(0), start + milliseconds(200));
+  // Arrives first but is due last
+  std::future<uint32_t> m1 =
+      service.request_move(g.at(1), start + milliseconds(2000));
+  std::future<uint32_t> m2 =
+      service.request_move(g.at(2), start + milliseconds(500));
+  m2.get();
+  CHECK(m1.wait_for(milliseconds(0)) != std::future_status::ready)
+      << "later deadline served first";
+  m1.get();
+  m0.get();
+
+  return;
+}
+
+// Many games played to the end on a few threads: the engine plays both
+// sides of every game
+static void ManyGamesTest(uint32_t num_games, uint32_t num_threads,
+                          uint32_t num_trials) {
+  const uint32_t dim = 5;
+  GameService service(GetStrategy(), num_threads, num_games, num_games,
+                      FLAGS_auto_test, num_trials);
+  std::vector<GameService::GameId> games;
+  for (uint32_t i = 0; i < num_games; ++i)
+    games.push_back(service.open_game(dim));
+
+  Clock::time_point start = Clock::now();
+  uint32_t num_moves = 0, num_late = 0;
+  std::vector<GameService::GameId> live(games);
+  while (!live.empty()) {
+    Clock::time_point deadline = Clock::now() + milliseconds(2000);
+    std::vector<std::future<uint32_t>> moves;
+    for (GameService::GameId id : live)
+      moves.push_back(service.request_move(id, deadline));
+    for (auto &m : moves) {
+      CHECK_LT(m.get(), dim*dim);
+      ++num_moves;
+    }
+    if (Clock::now() > deadline)
+      ++num_late;
+    std::vector<GameService::GameId> next;
+    for (GameService::GameId id : live) {
+      if (service.get_winner(id) == Hex::State::EMPTY)
+        next.push_back(id);
+    }
+    live.swap(next);
+  }
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  for (GameService::GameId id : games) {
+    CHECK_NE(service.get_winner(id), Hex::State::EMPTY);
+    // Shortest game: 2*dim - 1 moves
+    CHECK_GE(service.get_num_moves(id), 2*dim - 1);
+    CHECK_LE(service.get_num_moves(id), dim*dim);
+    CHECK(Throws([&service, id]() {
+          service.request_move(id, Clock::now() + milliseconds(100));
+        }, "game over"));
+    service.close_game(id);
+  }
+  CHECK_EQ(service.get_num_games(), 0);
+
+  DLOG(INFO) << num_games << " games: " << num_threads << " threads: "
+             << num_moves << " moves in " << elapsed.count() << " secs: "
+             << num_late << " rounds late";
+  if (!FLAGS_auto_test)
+    std::cout << num_games << " games: " << num_threads << " threads: "
+              << num_moves << " moves in " << elapsed.count() << " secs: "
+              << num_moves/elapsed.count() << " moves/sec: "
+              << num_late << " rounds late" << std::endl;
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "game_service_test called: "
+             << "strategy " << FLAGS_strategy
+             << ": threads " << FLAGS_threads
+             << ": num_games " << FLAGS_num_games
+             << ": num_trials " << FLAGS_num_trials;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    AdmissionTest();
+    FairnessTest();
+    ManyGamesTest(FLAGS_num_games, FLAGS_threads, FLAGS_num_trials);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_string(strategy, "uct",
+              "search engine of every game: flat or uct");
+static bool ValidateStrategy(const char* flagname, const std::string& value) {
+  std::string s(flagname);
+  if (value != "flat" && value != "uct") {
+    std::cerr << "Invalid value for --" << s << ": " << value
+              << ": should be flat or uct" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+strategy_dummy = google::RegisterFlagValidator(&FLAGS_strategy,
+                                               &ValidateStrategy);
+
+DEFINE_int32(threads, 4,
+             "# of threads shared by the games");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_int32(num_games, 64,
+             "# of games played concurrently");
+static bool ValidateNumGames(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_games_dummy = google::RegisterFlagValidator(&FLAGS_num_games,
+                                                &ValidateNumGames);
+
+DEFINE_int32(num_trials, 20,
+             "# trials per open position allowed for a move");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
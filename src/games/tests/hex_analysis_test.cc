@@ -0,0 +1,253 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>        // std::find, std::max_element
+#include <chrono>           // std::chrono::seconds
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_analysis.h"
+#include "utils/confidence.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(dimension);
+DECLARE_int32(num_trials);
+DECLARE_int32(threads);
+DECLARE_bool(auto_test);
+
+using Clock = TimeManager::Clock;
+
+// moves[0..num_moves) played as listed followed by the open positions
+static std::vector<uint32_t> Moves(uint32_t dim,
+                                   const std::vector<uint32_t> &played) {
+  std::vector<uint32_t> moves(played);
+  for (uint32_t i = 0; i < dim*dim; ++i) {
+    if (std::find(played.begin(), played.end(), i) == played.end())
+      moves.push_back(i);
+  }
+  return moves;
+}
+
+// Wilson intervals: within [0, 1], around the win ratio & narrowing
+static void IntervalTest(void) {
+  double low, high;
+  wilson_interval(0, 0, CONFIDENCE_Z, &low, &high);
+  CHECK_EQ(low, 0);
+  CHECK_EQ(high, 1);
+  wilson_interval(0, 10, CONFIDENCE_Z, &low, &high);
+  CHECK_EQ(low, 0);
+  CHECK_NEAR(high, 0.2775, 1e-4);
+  wilson_interval(10, 10, CONFIDENCE_Z, &low, &high);
+  CHECK_NEAR(low, 0.7225, 1e-4);
+  CHECK_EQ(high, 1);
+  wilson_interval(50, 100, CONFIDENCE_Z, &low, &high);
+  CHECK_NEAR(0.5 - low, high - 0.5, 1e-9);
+  double wide = high - low;
+  wilson_interval(500, 1000, CONFIDENCE_Z, &low, &high);
+  CHECK_LT(high - low, wide) << "interval not narrowing with trials";
+
+  return;
+}
+
+// Every open position is analyzed round after round: the heatmap of each
+// round is streamed to the callback
+static void HeatmapTest(uint32_t dim, uint32_t num_trials,
+                        uint32_t num_threads) {
+  HexAnalysis analysis(dim, true, num_threads);
+  std::vector<uint32_t> moves = Moves(dim, {});
+  std::vector<uint32_t> rounds;
+  TimeManager::TimePoint never = TimeManager::TimePoint::max();
+  HexAnalysis::Heatmap heatmap = analysis.analyze(
+      moves, 0, num_trials, never,
+      [&rounds](const HexAnalysis::Heatmap &m, uint32_t n) {
+        rounds.push_back(n);
+        for (const HexAnalysis::Cell &c : m)
+          CHECK_EQ(c.num_trials, n) << "round not played by every cell";
+        return true;
+      });
+
+  uint32_t num_rounds = (num_trials + HexBatchEval::NUM_LANES - 1)/
+                        HexBatchEval::NUM_LANES;
+  CHECK_EQ(rounds.size(), num_rounds);
+  CHECK_EQ(rounds.back(), num_trials);
+  CHECK_EQ(heatmap.size(), dim*dim);
+  for (uint32_t i = 0; i < heatmap.size(); ++i) {
+    const HexAnalysis::Cell &c = heatmap.at(i);
+    CHECK_EQ(c.move, i) << "heatmap not in order of position";
+    CHECK_EQ(c.num_trials, num_trials);
+    CHECK_LE(c.low, c.win_ratio);
+    CHECK_LE(c.win_ratio, c.high);
+  }
+  // The acute corners (2 neighbors) of the empty board are clearly beaten
+  // once the intervals are narrow enough
+  const HexAnalysis::Cell &best = *std::max_element(
+      heatmap.begin(), heatmap.end(),
+      [](const HexAnalysis::Cell &a, const HexAnalysis::Cell &b) {
+        return a.win_ratio < b.win_ratio;
+      });
+  if (num_trials >= HexAnalysis::DEFAULT_NUM_TRIALS/2) {
+    CHECK_GT(best.low, heatmap.at(0).high);
+    CHECK_GT(best.low, heatmap.at(dim*dim - 1).high);
+  }
+
+  // Replayable: same seeds, same heatmap whatever the timing of threads
+  HexAnalysis::Heatmap again = analysis.analyze(moves, 0, num_trials, never);
+  for (uint32_t i = 0; i < heatmap.size(); ++i)
+    CHECK_EQ(again.at(i).num_wins, heatmap.at(i).num_wins);
+
+  if (!FLAGS_auto_test) {
+    for (uint32_t i = 0; i < heatmap.size(); ++i) {
+      std::cout << static_cast<uint32_t>(100*heatmap.at(i).win_ratio + 0.5)
+                << ((i % dim == dim - 1) ? "\n" : "\t");
+    }
+  }
+
+  return;
+}
+
+// Winning positions win every playout & the callback or the deadline end
+// the analysis early
+static void PositionTest(uint32_t num_threads) {
+  const uint32_t dim = 3;
+  HexAnalysis analysis(dim, true, num_threads);
+  // BLUE: A0 & A1: A2 connects West to East
+  std::vector<uint32_t> moves = Moves(dim, {0, 3, 1, 4});
+  TimeManager::TimePoint never = TimeManager::TimePoint::max();
+  HexAnalysis::Heatmap heatmap = analysis.analyze(moves, 4, 100, never);
+  CHECK_EQ(heatmap.size(), 5);
+  for (const HexAnalysis::Cell &c : heatmap) {
+    if (c.move == 2) {
+      CHECK_EQ(c.num_wins, c.num_trials) << "winning move lost a playout";
+    } else {
+      CHECK_LT(c.win_ratio, 1);
+    }
+  }
+
+  // Callback ends the analysis after the first round
+  heatmap = analysis.analyze(
+      moves, 4, 1000, never,
+      [](const HexAnalysis::Heatmap &m, uint32_t n) { return false; });
+  for (const HexAnalysis::Cell &c : heatmap)
+    CHECK_EQ(c.num_trials, HexBatchEval::NUM_LANES);
+
+  // Deadline passed: at most a cell per worker is analyzed
+  heatmap = analysis.analyze(moves, 4, 1000,
+                             Clock::now() - std::chrono::seconds(1));
+  uint32_t num_analyzed = 0;
+  for (const HexAnalysis::Cell &c : heatmap) {
+    if (c.num_trials == 0) {
+      CHECK_EQ(c.low, 0);
+      CHECK_EQ(c.high, 1);
+    } else {
+      ++num_analyzed;
+    }
+  }
+  CHECK_LE(num_analyzed, num_threads);
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "hex_analysis_test called: "
+             << "dimension " << FLAGS_dimension
+             << ": num_trials " << FLAGS_num_trials
+             << ": threads " << FLAGS_threads;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    IntervalTest();
+    HeatmapTest(FLAGS_dimension, FLAGS_num_trials, FLAGS_threads);
+    PositionTest(FLAGS_threads);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(dimension, 5,
+             "# rows/columns of the Hex board analyzed");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(num_trials, 500,
+             "# of playouts of every open position");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_int32(threads, 4,
+             "# of threads sharing the open positions");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
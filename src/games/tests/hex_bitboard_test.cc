@@ -0,0 +1,171 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>        // std::shuffle
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <random>           // std::default_random_engine
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_batch_eval.h"
+#include "games/hex_bitboard.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(dimension);
+DECLARE_int32(num_games);
+DECLARE_bool(auto_test);
+
+// Plays the moves one at a time on Hex & the bitboard: the winner (if any)
+// must match after every move. Returns the winner.
+static Hex::State PlayGame(uint32_t dim, const vector<uint32_t> &moves) {
+  Hex h(dim);
+  HexBitBoard b(dim);
+  Hex::State s = Hex::State::BLUE;
+  for (auto vid : moves) {
+    h.set_next_move(vid);
+    h.assess_positions();
+    b.set_state(vid, s);
+    CHECK_EQ(b.get_state(vid), s) << "vid " << vid << ": state mismatch";
+    CHECK_EQ(b.get_winner(), h.get_winner())
+        << "vid " << vid << ": winner mismatch" << std::endl << b;
+    if (h.is_play_over())
+      break;
+    ++s;
+  }
+  CHECK(h.is_play_over()) << "game not over after all moves";
+
+  // Full board: play the game to the end in one go
+  HexBitBoard full(dim);
+  full.play_moves(moves.begin(), moves.end(), Hex::State::BLUE);
+  CHECK_EQ(full.get_winner(), h.get_winner())
+      << "full board: winner mismatch" << std::endl << full;
+
+  return h.get_winner();
+}
+
+// Plays a batch of playouts from a random position (num_played moves)
+// in the lanes of HexBatchEval: winner of every lane must match the 
+// winner of the playout on a bitboard
+static void PlayBatch(uint32_t dim, uint32_t num_played, 
+                      vector<uint32_t> *moves_p,
+                      std::default_random_engine *rnd_e_p) {
+  HexBitBoard position(dim);
+  position.play_moves(moves_p->begin(), moves_p->begin() + num_played,
+                      Hex::State::BLUE);
+  Hex::State next = (num_played % 2 == 0) ? 
+                    Hex::State::BLUE : Hex::State::RED;
+  HexBatchEval eval(dim);
+  eval.set_position(position);
+  // Batches twice over the same position: eval reusable after clear
+  for (uint32_t batch = 0; batch < 2; ++batch) {
+    HexBatchEval::Lanes expected = 0;
+    for (uint32_t lane = 0; lane < HexBatchEval::NUM_LANES; ++lane) {
+      std::shuffle(moves_p->begin() + num_played, moves_p->end(), *rnd_e_p);
+      eval.play_moves(lane, moves_p->begin() + num_played, moves_p->end(),
+                      next);
+      HexBitBoard playout(position);
+      playout.play_moves(moves_p->begin() + num_played, moves_p->end(), next);
+      if (playout.get_winner() == Hex::State::BLUE)
+        expected |= static_cast<HexBatchEval::Lanes>(1) << lane;
+    }
+    CHECK_EQ(eval.get_blue_wins(), expected)
+        << "dim " << dim << ": # moves played " << num_played
+        << ": batch winners mismatch";
+    eval.clear();
+  }
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "hex_bitboard_test called: "
+             << "dimension " << FLAGS_dimension
+             << ": num_games " << FLAGS_num_games;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    // Random games: fixed seed when run from automated test scripts
+    uint32_t seed = FLAGS_auto_test ? 2014 : std::random_device{}();
+    std::default_random_engine rnd_e{seed};
+    uint32_t num_blue_wins = 0;
+    for (uint32_t dim = Hex::MIN_DIMENSION;
+         dim <= static_cast<uint32_t>(FLAGS_dimension); ++dim) {
+      vector<uint32_t> moves(dim*dim);
+      for (uint32_t i = 0; i < moves.size(); ++i)
+        moves.at(i) = i;
+      for (int32_t game = 0; game < FLAGS_num_games; ++game) {
+        std::shuffle(moves.begin(), moves.end(), rnd_e);
+        if (PlayGame(dim, moves) == Hex::State::BLUE)
+          ++num_blue_wins;
+      }
+      for (uint32_t num_played = 0; num_played < dim*dim; num_played += dim)
+        PlayBatch(dim, num_played, &moves, &rnd_e);
+    }
+
+    DLOG(INFO) << "# blue wins " << num_blue_wins;
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(dimension, 11,
+             "games are played on all dimensions from 3 upto dimension");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if ((static_cast<uint32_t>(dim) < Hex::MIN_DIMENSION) ||
+      (static_cast<uint32_t>(dim) > Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be [" << Hex::MIN_DIMENSION
+              << "," << Hex::MAX_DIMENSION
+              << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dim_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                          &ValidateDimension);
+
+DEFINE_int32(num_games, 100,
+             "# of random games played on each dimension");
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
@@ -0,0 +1,234 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <chrono>           // std::chrono::steady_clock
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <sstream>          // std::istringstream, std::ostringstream
+#include <string>           // std::string
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_protocol.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_string(strategy);
+DECLARE_bool(auto_test);
+
+// Responses to the commands of script: one per command. The engine has
+// num_trials per open position & 1 sec per move without time limits
+static std::vector<std::string> Run(const std::string &script,
+                                    uint32_t num_trials = 10) {
+  MCStrategy::Type strategy = (FLAGS_strategy == "uct") ?
+                              MCStrategy::Type::UCT : MCStrategy::Type::FLAT;
+  std::istringstream is(script);
+  std::ostringstream os;
+  HexProtocol htp(is, os, strategy, true, num_trials, 1, 1, true);
+  uint32_t num_commands = htp.run();
+
+  // Responses end with an empty line
+  std::vector<std::string> responses;
+  std::string out = os.str();
+  for (std::size_t pos = 0, end; pos < out.size(); pos = end + 2) {
+    end = out.find("\n\n", pos);
+    CHECK_NE(end, std::string::npos) << "response not terminated: " << out;
+    responses.push_back(out.substr(pos, end - pos));
+  }
+  CHECK_EQ(responses.size(), num_commands) << out;
+  if (!FLAGS_auto_test)
+    std::cout << out;
+
+  return responses;
+}
+
+// Administrative commands, ids, comments & errors
+static void SessionTest(void) {
+  std::vector<std::string> r = Run(
+      "# comment line\n"
+      "1 protocol_version\n"
+      "\n"
+      "2 name   # trailing comment\n"
+      "3 known_command genmove\n"
+      "known_command showboard\n"
+      "4 boardsize 2\n"
+      "5 no_such_command\n"
+      "6 play blue\n"
+      "7 boardsize 5\n"
+      "8 winner\n"
+      "9 quit\n"
+      "10 name\n");
+  std::vector<std::string> expected = {
+    "=1 2", "=2 mc_hex", "=3 true", "= false", "?4 unacceptable size",
+    "?5 unknown command", "?6 expected 2 argument(s): got 1", "=7",
+    "=8 none", "=9"};
+  CHECK_EQ(r.size(), expected.size()) << "commands after quit executed";
+  for (std::size_t i = 0; i < r.size(); ++i)
+    CHECK_EQ(r.at(i), expected.at(i));
+
+  return;
+}
+
+// Moves: legality, turns, undo & game end
+static void PlayTest(void) {
+  // BLUE connects the west & east sides along row A
+  std::vector<std::string> r = Run(
+      "boardsize 3\n"
+      "play red A0\n"
+      "play blue A0\n"
+      "play red A0\n"
+      "play red B9\n"
+      "play red B0\n"
+      "undo\n"
+      "play white b0\n"
+      "play b A1\n"
+      "play w C0\n"
+      "play black A2\n"
+      "winner\n"
+      "play red C1\n"
+      "genmove red\n"
+      "undo\n"
+      "winner\n"
+      "genmove blue\n"
+      "undo\n"
+      "undo\n"
+      "undo\n"
+      "undo\n"
+      "undo\n"
+      "undo\n");
+  std::vector<std::string> expected = {
+    "=", "? out of turn: blue to play", "=", "? illegal move A0",
+    "? illegal move B9", "=", "=", "=", "=", "=", "=", "= blue",
+    "? game over", "? game over", "=", "= none"};
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    CHECK_EQ(r.at(i), expected.at(i)) << "response " << i;
+  // genmove: an open position
+  CHECK_EQ(r.at(16).substr(0, 2), "= ") << r.at(16);
+  for (auto taken : {"= A0", "= B0", "= A1", "= C0"})
+    CHECK_NE(r.at(16), taken);
+  // 5 moves on the board: 5 undo then nothing to undo
+  for (std::size_t i = 17; i < 22; ++i)
+    CHECK_EQ(r.at(i), "=") << "response " << i;
+  CHECK_EQ(r.at(22), "? cannot undo");
+
+  return;
+}
+
+// Engine plays both sides under time settings until the game ends
+static void SelfPlayTest(void) {
+  std::string script = "boardsize 5\ntime_settings 10 0 0\n";
+  for (uint32_t i = 0; i < 25; ++i)
+    script += (i % 2 == 0) ? "genmove blue\n" : "genmove red\n";
+  script += "winner\ntime_settings 0 1 2\ntime_left blue 9 0\n"
+            "time_settings x 0 0\n";
+  std::vector<std::string> r = Run(script);
+
+  uint32_t num_moves = 0;
+  for (std::size_t i = 2; i < 27 && r.at(i) != "? game over"; ++i)
+    ++num_moves;
+  // Shortest game: 2*5 - 1 moves
+  CHECK_GE(num_moves, 9) << "game ended early";
+  CHECK_LE(num_moves, 25);
+  CHECK(r.at(27) == "= blue" || r.at(27) == "= red") << r.at(27);
+  CHECK_EQ(r.at(28), "=");
+  CHECK_EQ(r.at(29), "=");
+  CHECK_EQ(r.at(30), "? syntax error");
+
+  return;
+}
+
+// Secs taken by a genmove of the engine bound by time alone
+static double MoveTime(const std::string &time_settings) {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  std::vector<std::string> r = Run("boardsize 5\n" + time_settings +
+                                   "genmove blue\n", 1 << 24);
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  CHECK_EQ(r.back().substr(0, 2), "= ") << r.back();
+  return elapsed.count();
+}
+
+// A byo yomi period bounds every move: no main time & no byo yomi or byo
+// yomi for 0 stones lift the limits back to the 1 sec of the engine
+static void TimeLimitTest(void) {
+  double bounded = MoveTime("time_settings 0 0.2 1\n");
+  CHECK_LT(bounded, 0.6) << "byo yomi of 0.2 secs ignored";
+  double no_time = MoveTime("time_settings 0 0.2 1\ntime_settings 0 0 0\n");
+  CHECK_GE(no_time, 0.9) << "time_settings 0 0 0 kept the byo yomi";
+  double no_stones = MoveTime("time_settings 0 0.2 1\n"
+                              "time_settings 10 0.2 0\n");
+  CHECK_GE(no_stones, 0.9) << "byo yomi of 0 stones bounded the move";
+
+  DLOG(INFO) << "move secs: byo yomi " << bounded << ": no time "
+             << no_time << ": no stones " << no_stones;
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "hex_protocol_test called: strategy " << FLAGS_strategy;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    SessionTest();
+    PlayTest();
+    SelfPlayTest();
+    TimeLimitTest();
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_string(strategy, "uct",
+              "search engine generating the moves: flat or uct");
+static bool ValidateStrategy(const char* flagname, const std::string& value) {
+  std::string s(flagname);
+  if (value != "flat" && value != "uct") {
+    std::cerr << "Invalid value for --" << s << ": " << value
+              << ": should be flat or uct" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+strategy_dummy = google::RegisterFlagValidator(&FLAGS_strategy,
+                                               &ValidateStrategy);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
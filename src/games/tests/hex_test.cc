@@ -67,6 +67,7 @@ class HexTester {
   HexTester(void) = delete;
   void RunTillNMovesTest(const uint32_t num_moves,
                          const bool     auto_test);
+  void CopyTest(void);
  private:
   std::string       _op_file;
   uint32_t          _dimension;
@@ -127,6 +128,32 @@ void HexTester::RunTillNMovesTest(const uint32_t num_moves,
   return;
 }
 
+// A copy shares the board topology but plays on its own positions
+void HexTester::CopyTest(void) {
+  Hex copy(_hex);
+  ostringstream oss_hex, oss_copy;
+  oss_hex << _hex;
+  oss_copy << copy;
+  CHECK_EQ(oss_hex.str(), oss_copy.str());
+
+  if (copy.is_play_over())
+    return;
+  // play the first empty position (row-alphabet followed by col) on copy
+  bool played = false;
+  for (uint32_t row = 0; row < _dimension && !played; ++row) {
+    for (uint32_t col = 0; col < _dimension && !played; ++col) {
+      std::string move_str = std::string(1, 'A' + row) + std::to_string(col);
+      played = copy.play_next_move(move_str);
+    }
+  }
+  CHECK(played);
+  ostringstream oss_hex2;
+  oss_hex2 << _hex;
+  CHECK_EQ(oss_hex.str(), oss_hex2.str());
+
+  return;
+}
+
 int main(int argc, char **argv) {
   Init::InitEnv(&argc, &argv);
 
@@ -155,6 +182,7 @@ int main(int argc, char **argv) {
   HexTester tester(file_name, FLAGS_dimension);
 
   tester.RunTillNMovesTest(FLAGS_num_moves, FLAGS_auto_test);
+  tester.CopyTest();
   
   DLOG(INFO) << "Test Program Ends: ..." << std::endl
              << "************************"; 
@@ -0,0 +1,322 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>        // std::find, std::max
+#include <chrono>           // std::chrono::minutes
+#include <cmath>            // std::sqrt
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/mc_flat.h"
+#include "games/time_manager.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(dimension);
+DECLARE_int32(num_trials);
+DECLARE_int32(threads);
+DECLARE_bool(auto_test);
+
+using MCStats = FlatMCStrategy::MCStats;
+
+// Positions 0 .. dim*dim-1 in order: the first num_moves are played
+static std::vector<uint32_t> Moves(uint32_t dim) {
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  return moves;
+}
+
+// Deadline far enough for every candidate to get all its playouts
+static TimeManager::TimePoint Deadline(void) {
+  return TimeManager::Clock::now() + std::chrono::minutes(10);
+}
+
+static double Ratio(uint32_t num_wins, uint32_t num_trials) {
+  return (num_trials > 0) ? static_cast<double>(num_wins)/num_trials : 0;
+}
+
+// Blend: (1 - beta)*direct + beta*AMAF with beta = sqrt(k/(3n + k))
+static void ScoreTest(void) {
+  const uint32_t k = FlatMCStrategy::DEFAULT_RAVE_EQUIVALENCE;
+  FlatMCStrategy rave(3, true, 1, 3, 1, k);
+  // No direct playouts: AMAF alone
+  CHECK_NEAR(rave.get_score(MCStats{0, 0, 10, 7}), 0.7, 1e-9);
+  // No AMAF playouts: direct alone
+  CHECK_NEAR(rave.get_score(MCStats{10, 3, 0, 0}), 0.3, 1e-9);
+  // n = k: beta = 1/2
+  CHECK_NEAR(rave.get_score(MCStats{k, k*2/5, 1000, 800}), 0.6, 1e-9);
+  for (uint32_t n : {1U, 10U, 100U, 1000U, 100000U}) {
+    MCStats s{n, n/4, 4*n, 3*n};
+    double beta = std::sqrt(static_cast<double>(k)/(3.0*n + k));
+    double direct = Ratio(s.num_wins, s.num_trials);
+    double amaf = Ratio(s.num_amaf_wins, s.num_amaf);
+    CHECK_NEAR(rave.get_score(s), (1 - beta)*direct + beta*amaf, 1e-9)
+        << "# direct playouts " << n;
+  }
+  // AMAF fades as direct playouts pile up
+  CHECK_LT(rave.get_score(MCStats{100000, 0, 100000, 100000}), 0.05);
+
+  // rave_equivalence 0: direct alone whatever the AMAF statistics
+  FlatMCStrategy direct(3, true, 1, 3, 1, 0);
+  CHECK_NEAR(direct.get_score(MCStats{10, 3, 1000, 900}), 0.3, 1e-9);
+
+  return;
+}
+
+// rave_equivalence 0: no AMAF statistics & the best direct win ratio is
+// played. Every open position gets its playouts whatever # of threads
+static void DirectTest(uint32_t dim, uint32_t num_trials,
+                       uint32_t num_threads) {
+  FlatMCStrategy strategy(dim, true, num_trials, 3, num_threads, 0);
+  for (uint32_t num_moves : {0U, 3U}) {
+    std::vector<uint32_t> moves = Moves(dim);
+    uint32_t move = strategy.get_next_move(&moves, num_moves, Deadline());
+    const std::vector<MCStats> &stats = strategy.get_stats();
+    const MCStats &best = stats.at(move);
+    CHECK_GE(move, num_moves) << "occupied position played";
+    for (uint32_t pos = num_moves; pos < dim*dim; ++pos) {
+      const MCStats &ps = stats.at(pos);
+      // Workers split the open positions: each explored exactly once
+      CHECK_EQ(ps.num_trials, num_trials) << "position " << pos;
+      CHECK_EQ(ps.num_amaf, 0) << "AMAF statistics with AMAF disabled";
+      CHECK_GE(Ratio(best.num_wins, best.num_trials),
+               Ratio(ps.num_wins, ps.num_trials))
+          << "move " << move << " beaten by position " << pos;
+    }
+  }
+
+  return;
+}
+
+// Every playout credits AMAF to the positions SW occupied in it: SW makes
+// every other move from the candidate onwards i.e. ceil(# open/2) moves
+static void AmafTest(uint32_t dim, uint32_t num_trials,
+                     uint32_t num_threads) {
+  FlatMCStrategy strategy(dim, true, num_trials, 3, num_threads);
+  for (uint32_t num_moves : {0U, 3U}) {
+    std::vector<uint32_t> moves = Moves(dim);
+    strategy.get_next_move(&moves, num_moves, Deadline());
+    const std::vector<MCStats> &stats = strategy.get_stats();
+    uint32_t num_open = dim*dim - num_moves;
+    uint64_t num_playouts = 0, num_amaf = 0;
+    for (uint32_t pos = num_moves; pos < dim*dim; ++pos) {
+      const MCStats &ps = stats.at(pos);
+      num_playouts += ps.num_trials;
+      num_amaf += ps.num_amaf;
+      // SW occupies the candidate in every one of its playouts & lanes
+      // left unplayed by a batch count no win
+      CHECK_GE(ps.num_amaf, ps.num_trials) << "position " << pos;
+      CHECK_LE(ps.num_wins, ps.num_trials) << "position " << pos;
+      CHECK_LE(ps.num_amaf_wins, ps.num_amaf) << "position " << pos;
+      CHECK_LE(ps.num_amaf_wins - ps.num_wins, ps.num_amaf - ps.num_trials)
+          << "position " << pos << ": AMAF wins beyond AMAF playouts";
+    }
+    CHECK_EQ(num_playouts, static_cast<uint64_t>(num_open)*num_trials);
+    CHECK_EQ(num_amaf, num_playouts*((num_open + 1)/2))
+        << "AMAF playouts != # playouts x # positions of SW";
+  }
+
+  return;
+}
+
+// Halving keeps the better half (leader first) less the candidates whose
+// confidence interval lies below the one of the leader
+static void HalveTest(void) {
+  FlatMCStrategy strategy(5, true, 1000, 3, 1, 0, true);
+  std::vector<MCStats> stats(25, MCStats{0, 0, 0, 0});
+  std::vector<uint32_t> candidates{6, 5, 4, 3, 2, 1, 0};
+  // Position i won 60, 58, 55, 50, 45, 40 & 10 of 100: intervals overlap
+  uint32_t wins[] = {60, 58, 55, 50, 45, 40, 10};
+  for (uint32_t i = 0; i < candidates.size(); ++i)
+    stats.at(i) = MCStats{100, wins[i], 0, 0};
+  std::vector<uint32_t> survivors = strategy.halve(stats, candidates);
+  CHECK_EQ(survivors.size(), (candidates.size() + 1)/2);
+  for (uint32_t i = 0; i < survivors.size(); ++i)
+    CHECK_EQ(survivors.at(i), i) << "survivors not ranked by win ratio";
+
+  // Position 2 won 500 of 1000: clearly beaten by 900 of 1000
+  uint32_t many_wins[] = {900, 890, 500, 100, 50, 0};
+  candidates = {0, 1, 2, 3, 4, 5};
+  for (uint32_t i = 0; i < candidates.size(); ++i)
+    stats.at(i) = MCStats{1000, many_wins[i], 0, 0};
+  survivors = strategy.halve(stats, candidates);
+  CHECK_EQ(survivors.size(), 2) << "beaten candidate survived";
+  CHECK_EQ(survivors.at(0), 0);
+  CHECK_EQ(survivors.at(1), 1);
+
+  // Every other candidate clearly beaten: the leader survives alone
+  stats.at(1) = MCStats{1000, 500, 0, 0};
+  survivors = strategy.halve(stats, candidates);
+  CHECK_EQ(survivors.size(), 1);
+  CHECK_EQ(survivors.at(0), 0);
+
+  return;
+}
+
+// BLUE to play on 5x5: BLUE holds row 0 & RED column 2 but for position
+// 2. Whoever takes 2 wins: it wins every playout & the others about half.
+static std::vector<uint32_t> ForcedWin(uint32_t *num_moves_p) {
+  std::vector<uint32_t> played{0, 7, 1, 12, 3, 17, 4, 22};
+  std::vector<uint32_t> moves(played);
+  for (uint32_t i = 0; i < 25; ++i) {
+    if (std::find(played.begin(), played.end(), i) == played.end())
+      moves.push_back(i);
+  }
+  *num_moves_p = played.size();
+  return moves;
+}
+
+static uint64_t NumPlayouts(const FlatMCStrategy &strategy) {
+  uint64_t num_playouts = 0;
+  for (const MCStats &ps : strategy.get_stats())
+    num_playouts += ps.num_trials;
+  return num_playouts;
+}
+
+// Halving finds the winning position with fewer playouts than the uniform
+// sweep: every other candidate is dropped after the first round & the
+// search ends with the leader alone
+static void HalvingTest(uint32_t num_trials, uint32_t num_threads) {
+  uint32_t num_moves;
+  std::vector<uint32_t> moves = ForcedWin(&num_moves);
+  uint32_t num_open = moves.size() - num_moves;
+
+  FlatMCStrategy uniform(5, true, num_trials, 3, num_threads, 0);
+  std::vector<uint32_t> uniform_moves = moves;
+  CHECK_EQ(uniform.get_next_move(&uniform_moves, num_moves, Deadline()), 2);
+  uint64_t uniform_playouts = NumPlayouts(uniform);
+  CHECK_EQ(uniform_playouts, static_cast<uint64_t>(num_open)*num_trials);
+
+  FlatMCStrategy halving(5, true, num_trials, 3, num_threads, 0, true);
+  std::vector<uint32_t> halving_moves = moves;
+  CHECK_EQ(halving.get_next_move(&halving_moves, num_moves, Deadline()), 2);
+  uint64_t halving_playouts = NumPlayouts(halving);
+  CHECK_LT(halving_playouts, uniform_playouts);
+
+  // Budget of a round: # open*num_trials spread over ceil(log2(# open))
+  uint32_t num_rounds = 0;
+  for (uint32_t n = 1; n < num_open; n *= 2)
+    ++num_rounds;
+  uint64_t round_trials = std::max<uint64_t>(
+      1, static_cast<uint64_t>(num_open)*num_trials/num_rounds/num_open);
+  // 40 playouts separate the interval of position 2 from the rest: the
+  // search ends after the first round
+  if (round_trials >= 40)
+    CHECK_EQ(halving_playouts, round_trials*num_open)
+        << "search went on after the leader alone survived";
+
+  DLOG(INFO) << "forced win: # playouts uniform " << uniform_playouts
+             << ": halving " << halving_playouts;
+  if (!FLAGS_auto_test)
+    std::cout << "forced win: # playouts uniform " << uniform_playouts
+              << ": halving " << halving_playouts << std::endl;
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "mc_flat_test called: "
+             << "dimension " << FLAGS_dimension
+             << ": num_trials " << FLAGS_num_trials
+             << ": threads " << FLAGS_threads;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    ScoreTest();
+    DirectTest(FLAGS_dimension, FLAGS_num_trials, FLAGS_threads);
+    AmafTest(FLAGS_dimension, FLAGS_num_trials, FLAGS_threads);
+    HalveTest();
+    HalvingTest(FLAGS_num_trials, FLAGS_threads);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(dimension, 5,
+             "# rows/columns of the Hex board searched");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(num_trials, 200,
+             "# of playouts of every candidate next move");
+static bool ValidateNumTrials(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_trials_dummy = google::RegisterFlagValidator(&FLAGS_num_trials,
+                                                 &ValidateNumTrials);
+
+DEFINE_int32(threads, 2,
+             "# of threads searching for the next move");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
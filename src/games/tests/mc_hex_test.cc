@@ -36,18 +36,36 @@ using namespace std;
 // Flag Declarations
 DECLARE_bool(auto_test);
 DECLARE_string(output_dir);
+DECLARE_int32(threads);
+DECLARE_string(strategy);
+DECLARE_bool(ponder);
+DECLARE_string(book_file);
+DECLARE_bool(halving);
 
 class MCHexTester {
  public:
   MCHexTester(const bool         auto_test,
               const std::string& file_name, 
-              const std::string& sm_file_name) : 
+              const std::string& sm_file_name,
+              const uint32_t     num_threads,
+              const MCStrategy::Type strategy,
+              const bool         ponder,
+              const std::string& book_file,
+              const bool         halving) : 
     _auto_test{auto_test},
     _mc_hex(file_name, 11, Hex::State::RED, 
-            (auto_test)?1:0, auto_test), // if manual test play till end
+            (auto_test)?1:0, auto_test, // if manual test play till end
+            MCHex::DEFAULT_MAX_MOVE_TIME_IN_SECS, 
+            MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED, num_threads, strategy,
+            MCHex::DEFAULT_MAX_GAME_TIME_IN_SECS, ponder, book_file,
+            halving),
     // first mover advantage easily leveraged in small hex boards
     _mc_hex_small(sm_file_name, 3, Hex::State::BLUE, 
-                  0, auto_test) {};     
+                  0, auto_test, 
+                  MCHex::DEFAULT_MAX_MOVE_TIME_IN_SECS, 
+                  MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED, num_threads, 
+                  strategy, MCHex::DEFAULT_MAX_GAME_TIME_IN_SECS, 
+                  ponder, "", halving) {};     
   MCHexTester(void) = delete;
   void BigHexTest(void);
   void SmallHexTest(void);
@@ -103,10 +121,20 @@ int main(int argc, char **argv) {
              << ": output_dir " << FLAGS_output_dir 
              << ": op_file " << file_name << ": sm_op_file " << sm_file_name
              << ": auto_test " << std::boolalpha << FLAGS_auto_test
+             << ": threads " << FLAGS_threads
+             << ": strategy " << FLAGS_strategy
+             << ": ponder " << FLAGS_ponder
+             << ": book_file " << FLAGS_book_file
+             << ": halving " << FLAGS_halving
              << "------------------------";
     
   try {
-    MCHexTester tester(FLAGS_auto_test, file_name, sm_file_name);
+    MCStrategy::Type strategy = (FLAGS_strategy == "uct") ? 
+                                MCStrategy::Type::UCT : 
+                                MCStrategy::Type::FLAT;
+    MCHexTester tester(FLAGS_auto_test, file_name, sm_file_name, 
+                       FLAGS_threads, strategy, FLAGS_ponder,
+                       FLAGS_book_file, FLAGS_halving);
     tester.BigHexTest();
     tester.SmallHexTest();
   }
@@ -128,3 +156,45 @@ DEFINE_bool(auto_test, false,
 
 DEFINE_string(output_dir, "",
               "Output directory to store game status");
+
+DEFINE_int32(threads, 1,
+             "# of threads searching for the next move of SW");
+static bool ValidateThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+threads_dummy = google::RegisterFlagValidator(&FLAGS_threads,
+                                              &ValidateThreads);
+
+DEFINE_string(strategy, "flat",
+              "search engine generating the moves of SW: flat or uct");
+static bool ValidateStrategy(const char* flagname, const std::string& value) {
+  std::string s(flagname);
+  if (value != "flat" && value != "uct") {
+    std::cerr << "Invalid value for --" << s << ": " << value
+              << ": should be flat or uct" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+strategy_dummy = google::RegisterFlagValidator(&FLAGS_strategy,
+                                               &ValidateStrategy);
+
+DEFINE_bool(ponder, false,
+            "SW searches while waiting for the human move: runs with "
+            "auto_test are then not replayable");
+
+DEFINE_string(book_file, "",
+              "opening book of the 11x11 game (see hex_book_gen): empty => "
+              "no book");
+
+DEFINE_bool(halving, false,
+            "flat MC spends its playouts on the candidate next moves still "
+            "in contention (successive halving)");
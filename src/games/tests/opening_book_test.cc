@@ -0,0 +1,254 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>        // std::min_element
+#include <exception>        // std::exception
+#include <fstream>          // std::ofstream
+#include <iostream>         // std::cout
+#include <unordered_map>    // std::unordered_map
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex_zobrist.h"
+#include "games/mc_hex.h"
+#include "games/opening_book.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_bool(auto_test);
+DECLARE_string(output_dir);
+DECLARE_int32(dimension);
+DECLARE_int32(max_moves);
+
+using Entry = OpeningBook::Entry;
+
+// Book of BLUE up to max_moves: BLUE plays the lowest open position &
+// RED any open position. The move depends on the position alone: the
+// same position reached by other move orders gets the same entry.
+static void Expand(const HexZobrist &zobrist, uint32_t max_moves,
+                   std::vector<uint32_t> *moves_p, uint32_t num_moves,
+                   std::unordered_map<uint64_t, Entry> *book_p) {
+  std::vector<uint32_t> &moves = *moves_p;
+  if (num_moves > max_moves)
+    return;
+  auto first = moves.begin() + num_moves;
+  if (num_moves % 2 == 0) {
+    auto it = std::min_element(first, moves.end());
+    std::swap(*first, *it);
+    uint64_t key = zobrist.get_key(moves.begin(), first);
+    book_p->emplace(key, Entry{key, *first});
+    Expand(zobrist, max_moves, moves_p, num_moves + 1, book_p);
+    std::swap(*first, *it);
+    return;
+  }
+  for (uint32_t i = num_moves; i < moves.size(); ++i) {
+    std::swap(moves.at(num_moves), moves.at(i));
+    Expand(zobrist, max_moves, moves_p, num_moves + 1, book_p);
+    std::swap(moves.at(num_moves), moves.at(i));
+  }
+
+  return;
+}
+
+static std::vector<Entry> Entries(uint32_t dim, uint32_t max_moves) {
+  HexZobrist zobrist(dim);
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  std::unordered_map<uint64_t, Entry> book;
+  Expand(zobrist, max_moves, &moves, 0, &book);
+  std::vector<Entry> entries;
+  for (const auto &kv : book)
+    entries.push_back(kv.second);
+  return entries;
+}
+
+static bool Refused(const std::string &book_file, uint32_t dim) {
+  try {
+    OpeningBook book(book_file, dim);
+  } catch (const std::string s) {
+    return true;
+  }
+  return false;
+}
+
+// Every entry written is found in the mapped book: nothing else is
+static void RoundTripTest(const std::string &book_file, uint32_t dim,
+                          uint32_t max_moves) {
+  std::vector<Entry> entries = Entries(dim, max_moves);
+  OpeningBook::write(book_file, dim, max_moves, entries);
+  OpeningBook book(book_file, dim);
+  CHECK_EQ(book.get_num_entries(), entries.size());
+  CHECK_EQ(book.get_max_moves(), max_moves);
+  for (const auto &e : entries) {
+    uint32_t move = OpeningBook::EMPTY_SLOT;
+    CHECK(book.lookup(e.key, &move)) << "key " << e.key << " not in book";
+    CHECK_EQ(move, e.move) << "key " << e.key;
+  }
+
+  // Deeper than the book: never looked up
+  HexZobrist zobrist(dim);
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  uint32_t move;
+  CHECK(book.lookup(moves, 0, &move));
+  CHECK_EQ(move, 0);
+  CHECK(!book.lookup(moves, max_moves + 1, &move));
+  CHECK(!book.lookup(zobrist.get_key(moves.begin(),
+                                     moves.begin() + max_moves + 1), &move))
+      << "position of " << max_moves + 1 << " moves in book";
+
+  // A book of another dimension is refused
+  CHECK(Refused(book_file, dim + 1))
+      << "book of dimension " << dim << " accepted for " << dim + 1;
+
+  return;
+}
+
+// Bad entries are not written & files that are not books not mapped
+static void ErrorTest(const std::string &book_file, uint32_t dim) {
+  bool thrown = false;
+  try {
+    OpeningBook::write(book_file, dim, 0, {Entry{1, 0}, Entry{1, 1}});
+  } catch (const std::string s) {
+    thrown = true;
+  }
+  CHECK(thrown) << "key entered twice written";
+
+  thrown = false;
+  try {
+    OpeningBook::write(book_file, dim, 0, {Entry{1, dim*dim}});
+  } catch (const std::string s) {
+    thrown = true;
+  }
+  CHECK(thrown) << "move off the board written";
+
+  std::string other_file = book_file + ".other";
+  std::ofstream ofs(other_file, std::ios::out | std::ios::binary);
+  ofs << "not a book";
+  ofs.close();
+  CHECK(Refused(other_file, dim)) << "file too short for a book mapped";
+  CHECK(Refused(book_file + ".missing", dim)) << "missing book mapped";
+
+  return;
+}
+
+// SW plays BLUE: every move of SW up to max_moves is a book move
+static void GameTest(const std::string &book_file,
+                     const std::string &op_file, uint32_t dim,
+                     uint32_t max_moves) {
+  OpeningBook::write(book_file, dim, max_moves, Entries(dim, max_moves));
+  MCHex mc_hex(op_file, dim, Hex::State::RED, max_moves + 1, true,
+               MCHex::DEFAULT_MAX_MOVE_TIME_IN_SECS,
+               MCHex::DEFAULT_MAX_SIM_TRIALS_ALLOWED,
+               MCHex::DEFAULT_NUM_THREADS, MCStrategy::Type::FLAT,
+               MCHex::DEFAULT_MAX_GAME_TIME_IN_SECS, false, book_file);
+  mc_hex.run();
+  CHECK_EQ(mc_hex.get_num_book_moves(), max_moves/2 + 1)
+      << "SW searched positions of the book";
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  std::string pgm = "/opening_book_test";
+  std::string output_file_prefix;
+  if (FLAGS_output_dir.empty() == false)
+    output_file_prefix = FLAGS_output_dir + pgm;
+  else if (FLAGS_auto_test == true)
+    output_file_prefix = std::string(argv[0]);
+  else
+    output_file_prefix = "." + pgm;
+  std::string book_file = output_file_prefix + "-" +
+      std::to_string(FLAGS_dimension) + ".book";
+  std::string op_file = output_file_prefix + "-op.txt";
+
+  DLOG(INFO) << "opening_book_test called: "
+             << "book_file " << book_file
+             << ": dimension " << FLAGS_dimension
+             << ": max_moves " << FLAGS_max_moves;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    RoundTripTest(book_file, FLAGS_dimension, FLAGS_max_moves);
+    ErrorTest(book_file, FLAGS_dimension);
+    GameTest(book_file, op_file, FLAGS_dimension, FLAGS_max_moves);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
+
+DEFINE_string(output_dir, "",
+              "Output directory of the book & game files");
+
+DEFINE_int32(dimension, 5,
+             "# rows/columns of the Hex board of the book");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(max_moves, 2,
+             "# moves of the deepest positions in the book");
+static bool ValidateMaxMoves(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 0 || num > 4) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be in [0, 4]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+max_moves_dummy = google::RegisterFlagValidator(&FLAGS_max_moves,
+                                                &ValidateMaxMoves);
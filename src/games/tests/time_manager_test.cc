@@ -0,0 +1,204 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <chrono>           // std::chrono::milliseconds
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <memory>           // std::unique_ptr
+#include <thread>           // std::this_thread::sleep_for
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/mc_flat.h"
+#include "games/mc_strategy.h"
+#include "games/mc_uct.h"
+#include "games/time_manager.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(dimension);
+DECLARE_int32(deadline_ms);
+DECLARE_bool(auto_test);
+
+using Seconds = TimeManager::Seconds;
+
+// Budget of a move: capped by the move time & a share of the game time
+static void BudgetTest(void) {
+  TimeManager unbounded(2);
+  CHECK(!unbounded.is_game_bounded());
+  TimeManager::TimePoint deadline = unbounded.start_move(121);
+  CHECK_NEAR(unbounded.get_move_budget(), 2*(1 - TimeManager::SAFETY_MARGIN),
+             1e-9);
+  CHECK(!TimeManager::is_expired(deadline)) << "deadline expired early";
+  unbounded.end_move();
+
+  // 11 open positions: SW is due to make 6 of those moves
+  TimeManager bounded(2, 6);
+  bounded.start_move(11);
+  CHECK_NEAR(bounded.get_move_budget(), 1*(1 - TimeManager::SAFETY_MARGIN),
+             1e-9);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  bounded.end_move();
+  CHECK_LT(bounded.get_remaining_time(), 6 - 0.05 + 1e-3)
+      << "move time not charged to the game";
+  CHECK_GT(bounded.get_remaining_time(), 5) << "move overcharged";
+
+  // Plenty of game time left: move time is the cap
+  bounded.start_move(2);
+  CHECK_NEAR(bounded.get_move_budget(), 2*(1 - TimeManager::SAFETY_MARGIN),
+             1e-9);
+  bounded.end_move();
+
+  // Overspent game: the move has no time at all
+  TimeManager spent(1, 0.01);
+  spent.start_move(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  spent.end_move();
+  CHECK_LT(spent.get_remaining_time(), 0);
+  deadline = spent.start_move(1);
+  CHECK_EQ(spent.get_move_budget(), 0);
+  CHECK(TimeManager::is_expired(deadline)) << "deadline should have passed";
+  spent.end_move();
+
+  return;
+}
+
+// Engine with a budget of trials far beyond the deadline: the search ends
+// by the deadline (or as soon as it is stopped) with a legal move
+static void DeadlineTest(MCStrategy *strategy_p, uint32_t dim) {
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  // Slack for the batch or iterations under way when time is up
+  Seconds slack(0.25);
+
+  Seconds budget(FLAGS_deadline_ms/1000.0);
+  TimeManager::TimePoint start = TimeManager::Clock::now();
+  TimeManager::TimePoint deadline = start +
+      std::chrono::duration_cast<TimeManager::Clock::duration>(budget);
+  uint32_t move = strategy_p->get_next_move(&moves, 0, deadline);
+  Seconds elapsed = TimeManager::Clock::now() - start;
+  CHECK_LT(move, dim*dim) << strategy_p->get_type() << ": illegal move";
+  CHECK_EQ(move, strategy_p->get_best_move());
+  CHECK_LT(elapsed.count(), (budget + slack).count())
+      << strategy_p->get_type() << ": deadline missed";
+
+  // Anytime: stopped from another thread long before its deadline. The
+  // deadline is bounded: a lost stop fails the test instead of hanging it
+  deadline = TimeManager::Clock::now() + std::chrono::seconds(10);
+  start = TimeManager::Clock::now();
+  std::thread stopper([strategy_p, dim]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      CHECK_LT(strategy_p->get_best_move(), dim*dim);
+      strategy_p->stop();
+    });
+  move = strategy_p->get_next_move(&moves, 1, deadline);
+  stopper.join();
+  elapsed = TimeManager::Clock::now() - start;
+  CHECK_LT(move, dim*dim) << strategy_p->get_type() << ": illegal move";
+  CHECK_NE(move, moves.at(0)) << "occupied position played";
+  CHECK_LT(elapsed.count(), (Seconds(0.02) + slack).count())
+      << strategy_p->get_type() << ": stop ignored";
+
+  // Sticky: a stop requested before the search starts ends it at once
+  strategy_p->stop();
+  start = TimeManager::Clock::now();
+  move = strategy_p->get_next_move(&moves, 2,
+                                   start + std::chrono::seconds(10));
+  elapsed = TimeManager::Clock::now() - start;
+  CHECK_LT(move, dim*dim) << strategy_p->get_type() << ": illegal move";
+  CHECK_LT(elapsed.count(), slack.count())
+      << strategy_p->get_type() << ": stop requested upfront lost";
+
+  // Served: the stop does not carry over to the search after
+  start = TimeManager::Clock::now();
+  deadline = start +
+      std::chrono::duration_cast<TimeManager::Clock::duration>(budget);
+  strategy_p->get_next_move(&moves, 3, deadline);
+  elapsed = TimeManager::Clock::now() - start;
+  CHECK_GE(elapsed.count(), budget.count())
+      << strategy_p->get_type() << ": stop carried over";
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "time_manager_test called: "
+             << "dimension " << FLAGS_dimension
+             << ": deadline_ms " << FLAGS_deadline_ms;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    BudgetTest();
+
+    uint32_t dim = FLAGS_dimension;
+    uint32_t num_trials = 1000000;
+    std::unique_ptr<MCStrategy>
+        flat(new FlatMCStrategy(dim, FLAGS_auto_test, num_trials, 3, 2));
+    DeadlineTest(flat.get(), dim);
+    std::unique_ptr<MCStrategy>
+        uct(new UCTStrategy(dim, FLAGS_auto_test, num_trials, 2));
+    DeadlineTest(uct.get(), dim);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(dimension, 11,
+             "# rows/columns of the Hex board searched");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim > static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(deadline_ms, 200,
+             "deadline (millisecs) of the search of a move");
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
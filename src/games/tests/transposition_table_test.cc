@@ -0,0 +1,306 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <chrono>           // std::chrono::steady_clock
+#include <exception>        // std::exception
+#include <iostream>         // std::cout
+#include <thread>           // std::thread
+#include <vector>           // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/hex.h"
+#include "games/hex_zobrist.h"
+#include "games/mc_uct.h"
+#include "games/time_manager.h"
+#include "games/transposition_table.h"
+#include "utils/init.h"
+#include "utils/random.h"
+
+using namespace hexgame;
+using namespace hexgame::games;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(dimension);
+DECLARE_int32(num_threads);
+DECLARE_int32(num_updates);
+DECLARE_bool(auto_test);
+
+// Key of Hex follows every move, is restored with the state & is the same
+// for any order of the same moves
+static void ZobristTest(uint32_t dim) {
+  HexZobrist zobrist(dim);
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  FastRandom rnd(5);
+  rnd.shuffle(moves.begin(), moves.end());
+
+  Hex h(dim);
+  CHECK_EQ(h.get_key(), zobrist.get_empty_key());
+  uint32_t num_moves = dim*dim/2;
+  for (uint32_t i = 0; i < num_moves; ++i) {
+    h.set_next_move(moves.at(i));
+    CHECK_EQ(h.get_key(),
+             zobrist.get_key(moves.begin(), moves.begin() + i + 1))
+        << "move " << i << ": key not updated";
+  }
+  uint64_t key = h.get_key();
+
+  h.save_state();
+  h.set_next_move(moves.at(num_moves));
+  CHECK_NE(h.get_key(), key);
+  h.restore_state();
+  CHECK_EQ(h.get_key(), key) << "key not restored";
+
+  // Nested saves: each restore brings back the board, the state & the
+  // groups of its own save. On 3x3 BLUE wins with row 0: 0, 1 & 2.
+  Hex g(3);
+  g.save_state();
+  for (uint32_t vid : {0U, 3U, 1U}) {
+    g.set_next_move(vid);
+    g.assess_positions();
+  }
+  uint64_t inner_key = g.get_key();
+  g.save_state();
+  for (uint32_t pass = 0; pass < 2; ++pass) {
+    for (uint32_t vid : {4U, 2U}) {
+      g.set_next_move(vid);
+      g.assess_positions();
+    }
+    CHECK(g.is_play_over()) << "pass " << pass << ": BLUE win missed";
+    CHECK(g.get_winner() == Hex::State::BLUE) << "pass " << pass;
+    g.restore_state();
+    CHECK(!g.is_play_over()) << "pass " << pass << ": win not restored";
+    CHECK(g.get_last_player() == Hex::State::BLUE) << "pass " << pass;
+    CHECK_EQ(g.get_key(), inner_key) << "pass " << pass;
+    // Groups of 0 & 1 survive the inner restore: 2 wins again
+    if (pass == 0)
+      g.save_state();
+  }
+  g.restore_state();
+  CHECK(g.get_last_player() == Hex::State::EMPTY) << "outer save lost";
+  CHECK_EQ(g.get_key(), HexZobrist(3).get_empty_key());
+  g.set_next_move(2);
+  g.assess_positions();
+  CHECK(!g.is_play_over()) << "groups of the inner save left behind";
+
+  // Transposition: BLUE moves (& RED moves) in another order
+  std::vector<uint32_t> other(moves.begin(), moves.begin() + num_moves);
+  uint32_t last_blue = (num_moves - 1) & ~1U;
+  std::swap(other.at(0), other.at(last_blue));
+  if (num_moves > 3)
+    std::swap(other.at(1), other.at(3));
+  CHECK_EQ(zobrist.get_key(other.begin(), other.end()), key)
+      << "transposition keyed apart";
+  // Same stones of the other player: another position
+  std::swap(other.at(0), other.at(1));
+  CHECK_NE(zobrist.get_key(other.begin(), other.end()), key);
+
+  // Boards of other dimensions: other keys
+  CHECK_NE(HexZobrist(dim + 1).get_empty_key(), zobrist.get_empty_key());
+
+  return;
+}
+
+// Counts of a single thread are exact: the hottest entries of a bucket
+// survive replacement
+static void TableTest(void) {
+  TranspositionTable tt(1000);
+  CHECK_EQ(tt.get_num_entries(), 1024);
+  TranspositionTable::Stats st;
+  CHECK(!tt.lookup(42, &st));
+  for (uint32_t i = 0; i < 10; ++i)
+    tt.update(42, i % 2 == 0);
+  CHECK(tt.lookup(42, &st));
+  CHECK_EQ(st.visits, 10);
+  CHECK_EQ(st.wins, 5);
+
+  // Key 0 is a position like any other
+  tt.update(0, true);
+  CHECK(tt.lookup(0, &st));
+  CHECK_EQ(st.visits, 1);
+
+  // Keys of one bucket: the least visited is replaced by a new key
+  uint64_t stride = tt.get_num_entries();
+  uint64_t base = 8;
+  for (uint64_t k = 0; k < TranspositionTable::BUCKET_SIZE; ++k) {
+    for (uint64_t v = 0; v <= k + 1; ++v)
+      tt.update(base + k*stride, false);
+  }
+  uint64_t new_key = base + TranspositionTable::BUCKET_SIZE*stride;
+  tt.update(new_key, true);
+  CHECK(tt.lookup(new_key, &st));
+  CHECK_EQ(st.visits, 1);
+  CHECK_EQ(st.wins, 1);
+  CHECK(!tt.lookup(base, &st)) << "least visited entry kept";
+  for (uint64_t k = 1; k < TranspositionTable::BUCKET_SIZE; ++k) {
+    CHECK(tt.lookup(base + k*stride, &st));
+    CHECK_EQ(st.visits, k + 2);
+  }
+
+  tt.clear();
+  CHECK(!tt.lookup(42, &st));
+
+  return;
+}
+
+// Threads update the same few positions: no visit or win is lost
+static void ConcurrencyTest(uint32_t num_threads, uint32_t num_updates) {
+  const uint32_t num_keys = 64;
+  TranspositionTable tt(1 << 12);
+  // One key per bucket: no replacement
+  std::vector<uint64_t> keys(num_keys);
+  FastRandom rnd(9);
+  for (uint32_t i = 0; i < num_keys; ++i)
+    keys.at(i) = (rnd() << 12) | (i*TranspositionTable::BUCKET_SIZE);
+
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&tt, &keys, t, num_updates]() {
+        for (uint32_t i = 0; i < num_updates; ++i)
+          tt.update(keys.at((i + t) % keys.size()), i % 4 == 0);
+      });
+  }
+  for (auto &t : threads)
+    t.join();
+  std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+  uint64_t visits = 0, wins = 0;
+  for (uint64_t k : keys) {
+    TranspositionTable::Stats st;
+    CHECK(tt.lookup(k, &st)) << "key " << k << " lost";
+    visits += st.visits;
+    wins += st.wins;
+  }
+  uint64_t total = static_cast<uint64_t>(num_threads)*num_updates;
+  CHECK_EQ(visits, total) << "visits lost";
+  CHECK_EQ(wins, num_threads*((num_updates + 3)/4)) << "wins lost";
+
+  DLOG(INFO) << num_threads << " threads: " << total << " updates: "
+             << elapsed.count() << " usecs";
+  if (!FLAGS_auto_test)
+    std::cout << num_threads << " threads: " << total << " updates: "
+              << elapsed.count() << " usecs" << std::endl;
+
+  return;
+}
+
+// The table is off by default: UCT searching with it plays open positions
+static void UCTTest(uint32_t dim, uint32_t num_threads) {
+  UCTStrategy uct(dim, true, 20, num_threads, 1 << 14);
+  std::vector<uint32_t> moves(dim*dim);
+  for (uint32_t i = 0; i < moves.size(); ++i)
+    moves.at(i) = i;
+  for (uint32_t num_moves : {0U, 3U, 6U}) {
+    std::vector<uint32_t> search_moves = moves;
+    uint32_t move = uct.get_next_move(
+        &search_moves, num_moves,
+        TimeManager::Clock::now() + std::chrono::minutes(10));
+    CHECK_GE(move, num_moves) << "occupied position played";
+    CHECK_LT(move, dim*dim) << "move off the board";
+  }
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "transposition_table_test called: "
+             << "dimension " << FLAGS_dimension
+             << ": num_threads " << FLAGS_num_threads
+             << ": num_updates " << FLAGS_num_updates;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    ZobristTest(FLAGS_dimension);
+    TableTest();
+    ConcurrencyTest(FLAGS_num_threads, FLAGS_num_updates);
+    UCTTest(FLAGS_dimension, FLAGS_num_threads);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(dimension, 11,
+             "# rows/columns of the Hex board hashed");
+static bool ValidateDimension(const char* flagname, int32_t dim) {
+  std::string s(flagname);
+  if (dim < static_cast<int32_t>(Hex::MIN_DIMENSION) ||
+      dim >= static_cast<int32_t>(Hex::MAX_DIMENSION)) {
+    std::cerr << "Invalid value for --" << s << ": " << dim
+              << ": should be in [" << Hex::MIN_DIMENSION << ", "
+              << Hex::MAX_DIMENSION << ")" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+dimension_dummy = google::RegisterFlagValidator(&FLAGS_dimension,
+                                                &ValidateDimension);
+
+DEFINE_int32(num_threads, 4,
+             "# of threads updating the table concurrently");
+static bool ValidateNumThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_threads_dummy = google::RegisterFlagValidator(&FLAGS_num_threads,
+                                                  &ValidateNumThreads);
+
+DEFINE_int32(num_updates, 100000,
+             "# of updates of the table by every thread");
+static bool ValidateNumUpdates(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_updates_dummy = google::RegisterFlagValidator(&FLAGS_num_updates,
+                                                  &ValidateNumUpdates);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
@@ -0,0 +1,95 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file time_manager.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: time budget of SW moves
+
+// Standard C++ Headers
+#include <algorithm>        // std::min, std::max
+#include <chrono>           // std::chrono::...
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "games/time_manager.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr double TimeManager::SAFETY_MARGIN;
+// End of Forward Declarations
+
+TimeManager::TimeManager(const double max_move_time_in_secs,
+                         const double max_game_time_in_secs) :
+    _max_move_time_in_secs{max_move_time_in_secs},
+    _max_game_time_in_secs{max_game_time_in_secs},
+    _remaining{max_game_time_in_secs}, _move_budget{0}, _in_move{false} {
+  if (max_move_time_in_secs <= 0 || max_game_time_in_secs < 0) {
+    std::stringstream ss;
+    ss << "TimeManager: max move time " << max_move_time_in_secs
+       << " should be > 0 & max game time " << max_game_time_in_secs
+       << " should be >= 0";
+    throw ss.str();
+  }
+
+  return;
+}
+
+//! @details budget = min(max move time, remaining game time / # moves SW
+//! is yet to make) less SAFETY_MARGIN. SW makes every other move of the
+//! open positions: (num_open + 1)/2 moves including this one.
+TimeManager::TimePoint TimeManager::start_move(const uint32_t num_open) {
+  assert(num_open > 0);
+  assert(!_in_move);
+  _in_move = true;
+  _move_start = Clock::now();
+
+  _move_budget = _max_move_time_in_secs;
+  if (is_game_bounded()) {
+    uint32_t num_sw_moves = (num_open + 1)/2;
+    _move_budget = std::min(_move_budget,
+                            std::max(_remaining, 0.0)/num_sw_moves);
+  }
+  _move_budget *= (1 - SAFETY_MARGIN);
+
+  DLOG(INFO) << "TimeManager: # open " << num_open
+             << ": move budget " << _move_budget << " secs"
+             << ": remaining " << _remaining << " secs";
+
+  return _move_start +
+      std::chrono::duration_cast<Clock::duration>(Seconds(_move_budget));
+}
+
+void TimeManager::end_move(void) {
+  assert(_in_move);
+  _in_move = false;
+  Seconds elapsed = Clock::now() - _move_start;
+  if (is_game_bounded())
+    _remaining -= elapsed.count();
+
+  DLOG(INFO) << "TimeManager: move took " << elapsed.count() << " secs"
+             << ": budget " << _move_budget << " secs";
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
@@ -0,0 +1,121 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     time_manager.h
+//! @brief    Definition: time budget of SW moves
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _TIME_MANAGER_H_
+#define _TIME_MANAGER_H_
+// C++ Standard Headers
+#include <chrono>           // std::chrono::steady_clock
+#include <iostream>         // std::cout
+// C Standard Headers
+#include <cassert>
+// Google Headers
+// Local Headers
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    TimeManager
+//! @brief    Splits the time budget of a game across the moves of SW
+//! @details  A move is allotted an equal share of the remaining game time
+//!           across the moves SW is still expected to make (every other
+//!           open position) capped by the max time of a move. The time a
+//!           move actually took is charged to the game once it ends.
+//!           Time is measured on the steady clock: deadlines never move
+//!           when the wall clock is adjusted.
+//! EXAMPLE USAGE:
+//!   TimeManager tm(10, 300);
+//!   TimeManager::TimePoint deadline = tm.start_move(num_open);
+//!   while (!TimeManager::is_expired(deadline)) ...search...
+//!   tm.end_move();
+class TimeManager {
+ public:
+  using Clock     = std::chrono::steady_clock;
+  using TimePoint = Clock::time_point;
+  using Seconds   = std::chrono::duration<double>;
+
+  //! Fraction of a move budget kept back to merge results & return a move
+  constexpr static double SAFETY_MARGIN = 0.05;
+
+  //! @param[in] max_move_time_in_secs max secs SW is allowed to make a move
+  //! @param[in] max_game_time_in_secs max secs SW is allowed for all its
+  //!            moves of a game: 0 => unbounded i.e. only moves are bound
+  explicit TimeManager(const double max_move_time_in_secs,
+                       const double max_game_time_in_secs = 0);
+  ~TimeManager() = default;
+
+  //! @brief Starts the clock of a move
+  //! @param[in] num_open # of open positions when SW is due to move
+  //! @return deadline by when SW should have made the move
+  TimePoint start_move(const uint32_t num_open);
+
+  //! @brief Stops the clock of the move & charges its time to the game
+  void end_move(void);
+
+  //! Secs allotted to the last move started
+  inline double get_move_budget(void) const { return _move_budget; }
+
+  //! Secs SW has left for the rest of the game: negative when overspent
+  inline double get_remaining_time(void) const { return _remaining; }
+
+  //! Resyncs the secs left with the clock of the game kept elsewhere
+  //! (e.g. by the controller of the game): bounded games only
+  inline void set_remaining_time(const double remaining) {
+    assert(!_in_move);
+    if (is_game_bounded())
+      _remaining = remaining;
+    return;
+  }
+
+  inline bool is_game_bounded(void) const {
+    return _max_game_time_in_secs > 0;
+  }
+
+  //! true once deadline has passed
+  static inline bool is_expired(const TimePoint &deadline) {
+    return Clock::now() >= deadline;
+  }
+
+  TimeManager(const TimeManager &)     = delete; //!< @brief disallow copy ctor
+  TimeManager(TimeManager &&)          = delete; //!< @brief disallow move ctor
+  void operator=(const TimeManager &)  = delete; //!< @brief disallow assignment
+  void operator=(TimeManager &&)       = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  const double _max_move_time_in_secs; //!< cap of the budget of a move
+  const double _max_game_time_in_secs; //!< budget of a game: 0 unbounded
+  double       _remaining;   //!< secs left for the rest of the game
+  double       _move_budget; //!< secs allotted to the last move started
+  TimePoint    _move_start;  //!< start time of the move in progress
+  bool         _in_move;     //!< true between start_move & end_move
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _TIME_MANAGER_H_
@@ -0,0 +1,115 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//! @file transposition_table.cc
+//! @author Arijit Sarcar <sarcar_a@yahoo.com>
+//! @brief Implementation: lock free table of search statistics of positions
+
+// Standard C++ Headers
+#include <limits>           // std::numeric_limits
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+// Local Headers
+#include "games/transposition_table.h"
+
+using namespace std;
+
+namespace hexgame { namespace games {
+
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t TranspositionTable::BUCKET_SIZE;
+constexpr uint64_t TranspositionTable::VISIT;
+constexpr uint64_t TranspositionTable::EMPTY_KEY;
+constexpr uint64_t TranspositionTable::EMPTY_TAG;
+// End of Forward Declarations
+
+TranspositionTable::TranspositionTable(std::size_t num_entries) :
+    _entries(new Entry[round_up(num_entries)]),
+    _mask{round_up(num_entries) - 1} {
+  clear();
+
+  return;
+}
+
+bool TranspositionTable::lookup(uint64_t key, Stats *stats_p) const {
+  uint64_t t = tag(key);
+  Entry *b = bucket(t);
+  for (uint32_t i = 0; i < BUCKET_SIZE; ++i) {
+    if (b[i].key.load(std::memory_order_relaxed) != t)
+      continue;
+    uint64_t s = b[i].stats.load(std::memory_order_relaxed);
+    stats_p->visits = static_cast<uint32_t>(s >> 32);
+    stats_p->wins   = static_cast<uint32_t>(s);
+    return true;
+  }
+
+  return false;
+}
+
+//! @details Counts the visit in the entry of the key, claiming an empty
+//! entry of the bucket (or else replacing the least visited one) when the
+//! key is not in the table yet.
+void TranspositionTable::update(uint64_t key, bool win) {
+  uint64_t t = tag(key);
+  uint64_t delta = VISIT + (win ? 1 : 0);
+  Entry *b = bucket(t);
+  Entry *victim = b;
+  uint64_t victim_stats = std::numeric_limits<uint64_t>::max();
+  for (uint32_t i = 0; i < BUCKET_SIZE; ++i) {
+    uint64_t k = b[i].key.load(std::memory_order_relaxed);
+    // A failed CAS loads the key claimed concurrently: maybe ours
+    if (k == EMPTY_KEY &&
+        b[i].key.compare_exchange_strong(k, t, std::memory_order_relaxed))
+      k = t;
+    if (k == t) {
+      b[i].stats.fetch_add(delta, std::memory_order_relaxed);
+      return;
+    }
+    uint64_t s = b[i].stats.load(std::memory_order_relaxed);
+    if (s < victim_stats) {
+      victim = &b[i];
+      victim_stats = s;
+    }
+  }
+
+  // Bucket full: a concurrent replacement of the victim wins & this visit
+  // is dropped
+  uint64_t k = victim->key.load(std::memory_order_relaxed);
+  if (victim->key.compare_exchange_strong(k, t, std::memory_order_relaxed))
+    victim->stats.store(delta, std::memory_order_relaxed);
+
+  return;
+}
+
+void TranspositionTable::clear(void) {
+  for (uint64_t i = 0; i <= _mask; ++i) {
+    _entries[i].key.store(EMPTY_KEY, std::memory_order_relaxed);
+    _entries[i].stats.store(0, std::memory_order_relaxed);
+  }
+
+  return;
+}
+
+std::size_t TranspositionTable::round_up(std::size_t num_entries) {
+  std::size_t n = BUCKET_SIZE;
+  while (n < num_entries)
+    n <<= 1;
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace games {
@@ -0,0 +1,125 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//! @file     transposition_table.h
+//! @brief    Definition: lock free table of search statistics of positions
+//! @author   Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _TRANSPOSITION_TABLE_H_
+#define _TRANSPOSITION_TABLE_H_
+// C++ Standard Headers
+#include <atomic>           // std::atomic
+#include <memory>           // std::unique_ptr
+// C Standard Headers
+#include <cassert>
+#include <cstddef>          // std::size_t
+#include <cstdint>          // uint64_t
+// Google Headers
+// Local Headers
+
+namespace hexgame {
+
+//! @addtogroup games
+//! @{
+
+//! Generic games interfaces and implementations
+namespace games {
+//-----------------------------------------------------------------------------
+
+//! @class    TranspositionTable
+//! @brief    Fixed size table of the # of visits & wins of positions keyed
+//!           by their Zobrist key: shared by all search threads
+//! @details  Lock free: an entry is a key word & a statistics word packing
+//!           the # of visits (upper 32 bits) & the # of wins (lower 32
+//!           bits). A visit is counted by a single fetch_add of both: wins
+//!           never exceed visits so the lower half never carries over.
+//!           A key hashes to a bucket of BUCKET_SIZE adjacent entries. An
+//!           empty entry (key 0) is claimed by a CAS of its key. When the
+//!           bucket is full the least visited entry is replaced: a visit
+//!           counted concurrently to the entry it used to hold may leak
+//!           into the new position. Statistics only guide the search so
+//!           such (rare) races are tolerated rather than locked out.
+//!           Wins are counted for the player who made the last move of the
+//!           position: the same whatever the path leading to it.
+//! EXAMPLE USAGE:
+//!   TranspositionTable tt(1 << 18);
+//!   tt.update(key, won);                // from any thread
+//!   TranspositionTable::Stats s;
+//!   if (tt.lookup(key, &s)) ...s.wins/s.visits...
+class TranspositionTable {
+ public:
+  //! # of entries a key may be stored in
+  constexpr static uint32_t BUCKET_SIZE = 4;
+
+  //! @brief Statistics of a position
+  struct Stats {
+    uint32_t visits;       //!< # of playouts through the position
+    uint32_t wins;         //!< # of those won by the player of its last move
+  };
+
+  //! @param[in] num_entries # of entries: rounded up to a power of 2
+  explicit TranspositionTable(std::size_t num_entries);
+  ~TranspositionTable() = default;
+
+  inline std::size_t get_num_entries(void) const { return _mask + 1; }
+
+  //! @brief Statistics of the position with the key (if in the table)
+  bool lookup(uint64_t key, Stats *stats_p) const;
+
+  //! @brief Counts a playout through the position with the key
+  //! @param[in] win true when the player of the last move won the playout
+  void update(uint64_t key, bool win);
+
+  //! @brief Drops all entries: not safe against concurrent lookup/update
+  void clear(void);
+
+  TranspositionTable(const TranspositionTable &) = delete; //!< @brief disallow copy ctor
+  TranspositionTable(TranspositionTable &&)      = delete; //!< @brief disallow move ctor
+  void operator=(const TranspositionTable &)     = delete; //!< @brief disallow assignment
+  void operator=(TranspositionTable &&)          = delete; //!< @brief disallow move assignment
+
+ protected:
+ private:
+  //! Added to the statistics word per visit
+  constexpr static uint64_t VISIT = 1ULL << 32;
+  //! Key of an empty entry: a position keyed 0 is stored as EMPTY_TAG
+  constexpr static uint64_t EMPTY_KEY = 0;
+  constexpr static uint64_t EMPTY_TAG = 1;
+
+  struct Entry {
+    std::atomic<uint64_t> key;
+    std::atomic<uint64_t> stats;
+  };
+
+  std::unique_ptr<Entry[]> _entries;
+  const uint64_t           _mask;    //!< # entries - 1
+
+  static inline uint64_t tag(uint64_t key) {
+    return (key == EMPTY_KEY) ? EMPTY_TAG : key;
+  }
+  //! first entry of the bucket of a tag
+  inline Entry* bucket(uint64_t tag) const {
+    return &_entries[tag & _mask & ~static_cast<uint64_t>(BUCKET_SIZE - 1)];
+  }
+  static std::size_t round_up(std::size_t num_entries);
+};
+//-----------------------------------------------------------------------------
+} // namespace games
+
+//! @} End of Doxygen games
+
+} // namespace hexgame
+
+#endif // _TRANSPOSITION_TABLE_H_
@@ -42,8 +42,9 @@ class BitSet {
       _v(BitSet::size(num_bits), 0) {}
   ~BitSet() = default;
   // Prevent unintended bad usage: 
-  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
-  BitSet(const BitSet&) = delete;
+  // Disallow: copy/move assignable (C++11)
+  // Copy ctor allowed: e.g. per thread copies of attribute overlays
+  BitSet(const BitSet&) = default;
   BitSet(BitSet&& o) : _v(std::move(o._v)) {}
   void operator=(const BitSet &) = delete;
   void operator=(BitSet &&) = delete; // C++11 only
@@ -63,6 +64,26 @@ class BitSet {
   inline void resize(uint32_t num_bits) {
     _v.resize(BitSet::size(num_bits), 0);
   }
+
+  // BitSet of (at least) num_bits bits: unlike the ctor that sizes
+  // the BitSet for a num_bits x num_bits (adjacency) matrix
+  static inline BitSet linear(uint32_t num_bits) {
+    BitSet b;
+    b._v.resize((num_bits + WORD_BITS - 1)/WORD_BITS, 0);
+    return b;
+  }
+
+  // 32 bits starting at bit pos: bit i of the result is bit pos+i.
+  // pos need not be word aligned. Bits beyond the BitSet read as 0.
+  inline uint32_t get_bits(uint32_t pos) const {
+    uint32_t w = BitSet::word_pos(pos), b = BitSet::bit_pos(pos);
+    if (w >= _v.size())
+      return 0;
+    uint32_t bits = _v[w] >> b;
+    if (b != 0 && w + 1 < _v.size())
+      bits |= _v[w + 1] << (WORD_BITS - b);
+    return bits;
+  }
  protected:
  private:
   // Private Data Structures
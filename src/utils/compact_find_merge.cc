@@ -0,0 +1,166 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <exception>        // std::out_of_range
+#include <iostream>
+#include <sstream>          // std::ostringstream
+#include <stdexcept>        // std::out_of_range
+#include <utility>          // std::swap
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/compact_find_merge.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+template <typename Idx>
+constexpr uint32_t CompactFindMerge<Idx>::DEFAULT_NUM_NODES;
+template <typename Idx>
+constexpr uint32_t CompactFindMerge<Idx>::BATCH_SIZE;
+template <typename Idx>
+constexpr std::size_t CompactFindMerge<Idx>::MAX_NUM_NODES;
+// End of Forward Declarations
+
+template <typename Idx>
+CompactFindMerge<Idx>::CompactFindMerge(std::size_t n) :
+    _p(n), _rank(n, 0), _num_sets{n} {
+  if (n > MAX_NUM_NODES) {
+    std::ostringstream oss;
+    oss << "CompactFindMerge: # nodes " << n
+        << " > max # nodes " << MAX_NUM_NODES << " of index type";
+    throw std::out_of_range(oss.str());
+  }
+  for (std::size_t idx = 0; idx < n; ++idx)
+    _p[idx] = static_cast<Idx>(idx);
+  return;
+}
+
+// adds a node as a set of its own and returns its idx
+template <typename Idx>
+Idx CompactFindMerge<Idx>::add_node(void) {
+  if (_p.size() >= MAX_NUM_NODES) {
+    std::ostringstream oss;
+    oss << "CompactFindMerge: add_node: max # nodes " << MAX_NUM_NODES
+        << " of index type reached";
+    throw std::out_of_range(oss.str());
+  }
+  Idx idx = static_cast<Idx>(_p.size());
+  _p.push_back(idx);
+  _rank.push_back(0);
+  ++_num_sets;
+  return idx;
+}
+
+// Batched find: lanes advance one parent per round. A lane issues the
+// prefetch of its next parent and yields to the other lanes, so by the
+// time it is visited again the parent is (hopefully) in the cache.
+template <typename Idx>
+void CompactFindMerge<Idx>::find_set(const Idx *in, Idx *out,
+                                     std::size_t n) {
+  Idx cur[BATCH_SIZE];
+  for (std::size_t base = 0; base < n; base += BATCH_SIZE) {
+    uint32_t num_lanes = (n - base < BATCH_SIZE) ? n - base : BATCH_SIZE;
+    for (uint32_t j = 0; j < num_lanes; ++j) {
+      assert(in[base + j] < _p.size());
+      cur[j] = in[base + j];
+      __builtin_prefetch(&_p[cur[j]]);
+    }
+
+    // Lanes whose root is found are swapped out of the active prefix:
+    // lane_of remembers the slot in the batch a lane belongs to
+    uint32_t lane_of[BATCH_SIZE];
+    for (uint32_t j = 0; j < num_lanes; ++j)
+      lane_of[j] = j;
+    uint32_t num_active = num_lanes;
+    while (num_active > 0) {
+      for (uint32_t j = 0; j < num_active; ) {
+        Idx p = _p[cur[j]];
+        if (p == cur[j]) {
+          out[base + lane_of[j]] = p;
+          --num_active;
+          std::swap(cur[j], cur[num_active]);
+          std::swap(lane_of[j], lane_of[num_active]);
+          continue;
+        }
+        __builtin_prefetch(&_p[p]);
+        cur[j] = p;
+        ++j;
+      }
+    }
+
+    // Compress: relink the starting nodes directly to their roots
+    for (uint32_t j = 0; j < num_lanes; ++j)
+      _p[in[base + j]] = out[base + j];
+  }
+
+  return;
+}
+
+// merge the two sets and return the identity of the merged set
+template <typename Idx>
+Idx CompactFindMerge<Idx>::merge_set(Idx node_idx1, Idx node_idx2) {
+  Idx set_id1 = find_set(node_idx1);
+  Idx set_id2 = find_set(node_idx2);
+
+  // The two sets are already merged
+  if (set_id1 == set_id2)
+    return set_id1;
+
+  // The set with lower rank merges to the one with higher rank
+  if (_rank[set_id1] < _rank[set_id2])
+    std::swap(set_id1, set_id2);
+  _p[set_id2] = set_id1;
+  if (_rank[set_id1] == _rank[set_id2])
+    ++_rank[set_id1];
+  --_num_sets;
+
+  return set_id1;
+}
+
+template <typename Idx>
+std::ostream& operator <<(std::ostream& os,
+                          const CompactFindMerge<Idx>& fm) {
+  os << "-----------------------------" << std::endl;
+  os << "Num Nodes: " << fm._p.size() << std::endl;
+  os << "Num Sets: " << fm._num_sets << std::endl;
+  os << "Array: { ";
+  for (std::size_t idx = 0; idx < fm._p.size(); ++idx)
+    os << static_cast<uint64_t>(fm._p[idx]) << " ";
+  os << "}" << std::endl;
+  os << "-----------------------------" << std::endl;
+
+  return os;
+}
+
+// Explicit Instantiation of all index types
+template class CompactFindMerge<uint16_t>;
+template class CompactFindMerge<uint32_t>;
+template class CompactFindMerge<uint64_t>;
+template std::ostream& operator << <uint16_t>(
+    std::ostream& os, const CompactFindMerge<uint16_t>& fm);
+template std::ostream& operator << <uint32_t>(
+    std::ostream& os, const CompactFindMerge<uint32_t>& fm);
+template std::ostream& operator << <uint64_t>(
+    std::ostream& os, const CompactFindMerge<uint64_t>& fm);
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
@@ -0,0 +1,126 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _COMPACT_FIND_MERGE_H_
+#define _COMPACT_FIND_MERGE_H_
+
+// Standard C++ Headers
+#include <iostream>
+#include <limits>           // std::numeric_limits
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// CompactFindMerge: find merge algorithm for huge memory bound workloads.
+// Idx (uint16_t, uint32_t, uint64_t) is the type of the parent index:
+// the footprint per node is sizeof(Idx) + 1 byte of rank.
+// 1. The highest ancestor (root) points to itself. Sets are merged by
+//    rank: rank never exceeds log2(# nodes) so it fits in a byte.
+// 2. Nodes may be added at any time via add_node.
+// 3. find_set compresses the path by path halving.
+// 4. Batched find_set walks up to BATCH_SIZE paths in lock step: while
+//    one lane waits on its cache miss the others issue the prefetch of
+//    their next parent, hiding the latency of the pointer chasing.
+//    The starting node of every lane is relinked to its root.
+// EXAMPLE USAGE:
+//   CompactFindMerge<uint32_t> fm(n);
+//   fm.merge_set(a, b);
+//   fm.find_set(nodes.data(), roots.data(), nodes.size());
+template <typename Idx=uint32_t>
+class CompactFindMerge {
+ public:
+  constexpr static uint32_t DEFAULT_NUM_NODES = 10;
+  constexpr static uint32_t BATCH_SIZE = 8;
+  // max value of Idx is not a valid idx: keeps the # nodes representable
+  constexpr static std::size_t MAX_NUM_NODES =
+      std::numeric_limits<Idx>::max();
+
+  explicit CompactFindMerge(std::size_t n=DEFAULT_NUM_NODES);
+  ~CompactFindMerge() = default;
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  CompactFindMerge(const CompactFindMerge &) = delete;
+  CompactFindMerge(CompactFindMerge &&) = delete; // C++11 only
+  void operator=(const CompactFindMerge &) = delete;
+  void operator=(const CompactFindMerge &&) = delete; // C++11 only
+
+  inline std::size_t get_num_nodes(void) const { return _p.size(); }
+  inline std::size_t get_num_sets(void) const { return _num_sets; }
+
+  // adds a node as a set of its own and returns its idx
+  Idx add_node(void);
+
+  // Traverse up the node hierarchy to get the highest ancestor
+  inline Idx find_set(Idx node_idx) {
+    assert(node_idx < _p.size());
+    Idx idx = node_idx;
+    while (_p[idx] != idx) {
+      // Path halving: relink node to grandfather
+      _p[idx] = _p[_p[idx]];
+      idx = _p[idx];
+    }
+    return idx;
+  }
+
+  // useful when invoked from functions expecting const FM
+  inline Idx find_set(Idx node_idx) const {
+    assert(node_idx < _p.size());
+    Idx idx = node_idx;
+    while (_p[idx] != idx)
+      idx = _p[idx];
+    return idx;
+  }
+
+  // Batched find: out[i] = find_set(in[i]) for i in [0, n)
+  void find_set(const Idx *in, Idx *out, std::size_t n);
+  void find_set(const std::vector<Idx> &in, std::vector<Idx> *out_p) {
+    out_p->resize(in.size());
+    find_set(in.data(), out_p->data(), in.size());
+  }
+
+  // true when both nodes belong to the same set
+  inline bool same_set(Idx node_idx1, Idx node_idx2) {
+    return (find_set(node_idx1) == find_set(node_idx2));
+  }
+
+  // merge the two sets and return the identity of the merged set
+  Idx merge_set(Idx node_idx1, Idx node_idx2);
+
+  template <typename I>
+  friend std::ostream & operator <<(std::ostream& os,
+                                    const CompactFindMerge<I>& fm);
+
+ protected:
+ private:
+  std::vector<Idx>     _p;    // parent idx: root points to itself
+  std::vector<uint8_t> _rank; // upper bound of height of the set
+  std::size_t          _num_sets;
+};
+
+extern template class CompactFindMerge<uint16_t>;
+extern template class CompactFindMerge<uint32_t>;
+extern template class CompactFindMerge<uint64_t>;
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _COMPACT_FIND_MERGE_H_
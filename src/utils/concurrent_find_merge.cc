@@ -0,0 +1,134 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <atomic>           // std::atomic
+#include <iostream>
+#include <sstream>          // std::ostringstream
+#include <utility>          // std::swap
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/concurrent_find_merge.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t ConcurrentFindMerge::DEFAULT_NUM_NODES;
+constexpr std::size_t ConcurrentFindMerge::MAX_NUM_NODES;
+// End of Forward Declarations
+
+ConcurrentFindMerge::ConcurrentFindMerge(std::size_t n) :
+    _n{n}, _v{}, _num_sets{n} {
+  if (n > MAX_NUM_NODES) {
+    std::ostringstream oss;
+    oss << "ConcurrentFindMerge: # nodes " << n
+        << " > max # nodes " << MAX_NUM_NODES << " of uint32_t parents";
+    throw oss.str();
+  }
+  _v.reset(new std::atomic<uint32_t>[n]);
+  // Every node starts as the root of its own set: publishing the object
+  // to other threads (e.g. thread creation) orders these stores
+  for (std::size_t idx = 0; idx < _n; ++idx)
+    _v[idx].store(idx, std::memory_order_relaxed);
+  return;
+}
+
+// Traverse up the node hierarchy to get the highest ancestor
+uint32_t ConcurrentFindMerge::find_set(uint32_t node_idx) {
+  assert(node_idx < _n);
+
+  uint32_t idx = node_idx;
+  uint32_t p_idx = _v[idx].load(std::memory_order_acquire);
+  while (p_idx != idx) {
+    uint32_t gf_idx = _v[p_idx].load(std::memory_order_acquire);
+    // Path halving: relink node to grandfather. Failure implies some other
+    // thread already relinked the node higher up: ignore it and move on.
+    if (gf_idx != p_idx)
+      _v[idx].compare_exchange_weak(p_idx, gf_idx,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_relaxed);
+    idx = gf_idx;
+    p_idx = _v[idx].load(std::memory_order_acquire);
+  }
+
+  return idx;
+}
+
+// true when both nodes belong to the same set
+bool ConcurrentFindMerge::same_set(uint32_t node_idx1, uint32_t node_idx2) {
+  uint32_t set_id1 = node_idx1, set_id2 = node_idx2;
+  for (;;) {
+    set_id1 = find_set(set_id1);
+    set_id2 = find_set(set_id2);
+    if (set_id1 == set_id2)
+      return true;
+    // set_id1 still a root: the two sets were disjoint when we looked at
+    // set_id2. Otherwise a concurrent merge linked set_id1: retry.
+    if (_v[set_id1].load(std::memory_order_acquire) == set_id1)
+      return false;
+  }
+}
+
+// merge the two sets and return the identity of the merged set
+uint32_t ConcurrentFindMerge::merge_set(uint32_t node_idx1,
+                                        uint32_t node_idx2) {
+  uint32_t set_id1 = node_idx1, set_id2 = node_idx2;
+  for (;;) {
+    set_id1 = find_set(set_id1);
+    set_id2 = find_set(set_id2);
+    // The two sets are already merged
+    if (set_id1 == set_id2)
+      return set_id1;
+
+    // The root with the lower priority links to the root with the higher
+    if (priority(set_id1) > priority(set_id2))
+      std::swap(set_id1, set_id2);
+
+    // CAS succeeds only if set_id1 is still a root. Otherwise another
+    // thread merged set_id1 concurrently: find the new roots and retry.
+    uint32_t expected = set_id1;
+    if (_v[set_id1].compare_exchange_strong(expected, set_id2,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+      _num_sets.fetch_sub(1, std::memory_order_relaxed);
+      return set_id2;
+    }
+    DLOG(INFO) << "merge_set: node_idx1 " << node_idx1
+               << ": node_idx2 " << node_idx2
+               << ": set_id1 " << set_id1 << " raced: retry";
+  }
+}
+
+std::ostream& operator <<(std::ostream& os,
+                          const ConcurrentFindMerge& fm) {
+  os << "-----------------------------" << std::endl;
+  os << "Num Nodes: " << fm._n << std::endl;
+  os << "Num Sets: " << fm.get_num_sets() << std::endl;
+  os << "Array: { ";
+  for (std::size_t idx = 0; idx < fm._n; ++idx)
+    os << fm._v[idx].load(std::memory_order_relaxed) << " ";
+  os << "}" << std::endl;
+  os << "-----------------------------" << std::endl;
+
+  return os;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
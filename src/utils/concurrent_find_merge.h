@@ -0,0 +1,102 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _CONCURRENT_FIND_MERGE_H_
+#define _CONCURRENT_FIND_MERGE_H_
+
+// Standard C++ Headers
+#include <atomic>           // std::atomic
+#include <iostream>
+#include <limits>           // std::numeric_limits
+#include <memory>           // std::unique_ptr
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// ConcurrentFindMerge: lock free find merge safe to be invoked from many
+// threads in parallel (e.g. parallel Kruskal, connected components).
+// Each node is uniquely identified by the idx. Each node keeps an atomic
+// parent word: the highest ancestor (root) points to itself.
+// 1. merge_set links one root to the other with a single CAS on the
+//    parent word of the root. The CAS fails if a concurrent merge linked
+//    the root first: the merge then retries from the new roots.
+// 2. Roots are linked by a fixed random priority of the index: the root
+//    with lower priority points to the one with higher priority. As the
+//    priority strictly increases along any path no loop can be formed,
+//    and the random order keeps the expected height logarithmic.
+// 3. find_set never waits on other threads: it compresses the path by
+//    path halving with a CAS that is allowed to fail. A failed CAS only
+//    means another thread already shortened the path (benign).
+class ConcurrentFindMerge {
+ public:
+  constexpr static uint32_t DEFAULT_NUM_NODES = 10;
+  // Parent words are uint32_t: every node index must fit in one
+  constexpr static std::size_t MAX_NUM_NODES =
+      std::numeric_limits<uint32_t>::max();
+  // Throws when n > MAX_NUM_NODES
+  explicit ConcurrentFindMerge(std::size_t n=DEFAULT_NUM_NODES);
+  ~ConcurrentFindMerge() = default;
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  ConcurrentFindMerge(const ConcurrentFindMerge &) = delete;
+  ConcurrentFindMerge(ConcurrentFindMerge &&) = delete; // C++11 only
+  void operator=(const ConcurrentFindMerge &) = delete;
+  void operator=(const ConcurrentFindMerge &&) = delete; // C++11 only
+
+  inline std::size_t get_num_nodes(void) const { return _n; }
+
+  // # of disjoint sets: exact once all concurrent merges have completed
+  inline std::size_t get_num_sets(void) const {
+    return _num_sets.load(std::memory_order_relaxed);
+  }
+
+  // Traverse up the node hierarchy to get the highest ancestor
+  // The returned root may get merged by a concurrent merge_set
+  uint32_t find_set(uint32_t node_idx);
+
+  // true when both nodes belong to the same set. Stays correct under
+  // concurrent merges: false means the nodes were in different sets at
+  // some instant during the call
+  bool same_set(uint32_t node_idx1, uint32_t node_idx2);
+
+  // merge the two sets and return the identity of the merged set
+  uint32_t merge_set(uint32_t node_idx1, uint32_t node_idx2);
+
+  friend std::ostream & operator <<(std::ostream& os,
+                                    const ConcurrentFindMerge& fm);
+
+ protected:
+ private:
+  const std::size_t                       _n;
+  std::unique_ptr<std::atomic<uint32_t>[]> _v;
+  std::atomic<std::size_t>                _num_sets;
+
+  // Fixed random priority of an index: multiplication by an odd constant
+  // is a bijection on uint32_t so no two indices share a priority
+  static inline uint32_t priority(uint32_t idx) {
+    return idx * 0x9E3779B1U;
+  }
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _CONCURRENT_FIND_MERGE_H_
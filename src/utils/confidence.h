@@ -0,0 +1,66 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _CONFIDENCE_H_
+#define _CONFIDENCE_H_
+
+// Standard C++ Headers
+#include <algorithm>        // std::max, std::min
+#include <cmath>            // std::sqrt
+// Standard C Headers
+#include <cstdint>          // uint32_t
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// Confidence intervals of win ratios measured by playouts.
+// wilson_interval: (p + z^2/2n +- z*sqrt(p(1-p)/n + z^2/4n^2))/(1 + z^2/n)
+// where p = num_wins/num_trials & n = num_trials. Unlike p +- z*sigma it
+// stays within [0, 1] & is sensible for few trials or p close to 0 or 1.
+// No trials give [0, 1].
+// EXAMPLE USAGE:
+//   double low, high;
+//   wilson_interval(num_wins, num_trials, CONFIDENCE_Z, &low, &high);
+
+// z of the 95% two sided confidence interval
+constexpr double CONFIDENCE_Z = 1.96;
+
+inline void wilson_interval(const uint32_t num_wins,
+                            const uint32_t num_trials, const double z,
+                            double *low_p, double *high_p) {
+  if (num_trials == 0) {
+    *low_p = 0;
+    *high_p = 1;
+    return;
+  }
+  double n = num_trials;
+  double p = num_wins/n;
+  double z2 = z*z;
+  double denom = 1 + z2/n;
+  double center = (p + z2/(2*n))/denom;
+  double half = z*std::sqrt(p*(1 - p)/n + z2/(4*n*n))/denom;
+  *low_p = std::max(0.0, center - half);
+  *high_p = std::min(1.0, center + half);
+
+  return;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _CONFIDENCE_H_
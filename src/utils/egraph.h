@@ -14,9 +14,18 @@
 //
 // Author: Arijit Sarcar <sarcar_a@yahoo.com>
 
+
 // 
 // Class eGraph:
 // Extends Graph class to allow storing values to Graph Nodes
+// The vertex attributes (with checkpoints, attribute index & iterators
+// over vertices of matching attributes) are kept in a VAttrOverlay bound
+// to the graph itself: see vattr_overlay.h
+// Iterators: eGraph hides the Graph iterators with iterators over its
+// overlay so the attribute filtering get_next_nbr is bound at compile time.
+// Consumers walking neighbors filter when instantiated on eGraph
+// (e.g. MSTPrim<GCost, eGraph<...>>): passed as a Graph& they see the
+// unfiltered topology.
 
 #ifndef _EGRAPH_H_
 #define _EGRAPH_H_
@@ -28,6 +37,8 @@
 // C Standard Headers
 // Local Headers
 #include "utils/graph.h"
+#include "utils/graph_iter.h"
+#include "utils/vattr_overlay.h"
 
 namespace hexgame { namespace utils {
 //-----------------------------------------------------------------------------
@@ -37,9 +48,11 @@ template <typename vAttr,
           typename GCost = uint32_t>
 class eGraph : public Graph<GCost> {
  public:
+  using Overlay = VAttrOverlay<vAttr, vAttrIsEqual, GCost>;
+
   explicit eGraph(uint32_t num_vertices=0) :
       Graph<GCost>(GEdgeType::UNDIRECTED, num_vertices, 0, 1, 1),
-      _vmap(num_vertices) {}
+      _overlay(*this) {}
   explicit eGraph(std::string file_name);
   virtual ~eGraph() = default;
 
@@ -51,52 +64,67 @@ class eGraph : public Graph<GCost> {
   void operator=(eGraph &&) = delete; // C++11 only
 
   inline void set_vertex_attr(GVertexId vid, const vAttr& vA) {
-    _vmap.at(vid) = vA;
-    return;
+    _overlay.set_vertex_attr(vid, vA);
   }
-
   inline const vAttr& get_vertex_attr(GVertexId vid) const {
-    return _vmap.at(vid);
+    return _overlay.get_vertex_attr(vid);
   }
-
   inline vAttr& get_vertex_attr(GVertexId vid) {
-    return _vmap.at(vid);
+    return _overlay.get_vertex_attr(vid);
   }
+  inline const Overlay& get_overlay(void) const { return _overlay; }
 
   // get_next_nbr: provide the first nbr vertex that is available
   // immediately from or after the passed nbr_vid 
   // *as long as* the attribute of the vertices match
-  virtual GVertexId get_next_nbr(GVertexId vid, GVertexId nbr_vid) const {
-    GVertexId vid_end = this->get_num_vertices();
-    assert(vid < vid_end);
-    for (GVertexId vid2 = nbr_vid; vid2 < vid_end; ++vid2) {
-      // We should replace the comparison of attributes with a functor
-      if (this->isset_adjmap(std::make_pair(vid, vid2)) &&
-          _vattr_is_equal(_vmap.at(vid), _vmap.at(vid2)))
-        return vid2;
-    }
-    return kGMaxVertexId<GCost>();
+  inline GVertexId get_next_nbr(GVertexId vid, GVertexId nbr_vid) const {
+    return _overlay.get_next_nbr(vid, nbr_vid);
+  }
+
+  // ITERATORS over eGraph: only neighbors with matching attributes
+  using VertexCIter = typename Overlay::VertexCIter;
+  using EdgeCIter   = typename Overlay::EdgeCIter;
+  inline VertexCIter vcbegin(GVertexIterType itype,
+                             const GVertexId &seed_vid) const {
+    return _overlay.vcbegin(itype, seed_vid);
+  }
+  inline VertexCIter vcbegin(GVertexIterType itype,
+                             const GVertexIterSeed& seed_v) const {
+    return _overlay.vcbegin(itype, seed_v);
   }
+  inline VertexCIter vcend(GVertexIterType itype) const {
+    return _overlay.vcend(itype);
+  }
+  inline EdgeCIter ecbegin(GVertexId vid) const {
+    return _overlay.ecbegin(vid);
+  }
+  inline EdgeCIter ecend(GVertexId vid) const {
+    return _overlay.ecend(vid);
+  }
+
   // Save State & Restore State: used by MC simulation to run "what if scenarios" 
   // without messing up current state of eGraph
-  inline void save_state(void) { 
-    _save = _vmap; 
-    return; 
-  }
-  inline void restore_state(void) { 
-    _vmap = _save; 
-    return; 
+  inline void save_state(void) { _overlay.save_state(); }
+  inline void restore_state(void) { _overlay.restore_state(); }
+  inline void discard_state(void) { _overlay.discard_state(); }
+  inline std::size_t get_num_checkpoints(void) const {
+    return _overlay.get_num_checkpoints();
   }
  protected:
  private:
   // Vertex Value: Every Vertex has an associated information of arbitrary 
   // complexity and size based on the preference of user
-  using gvertex_map_t = std::vector<vAttr>;
-  gvertex_map_t _vmap;
-  gvertex_map_t _save;
-  vAttrIsEqual _vattr_is_equal;
+  Overlay _overlay;
 };
 
+// helper function to allow chained cout cmds: lists the edges between
+// vertices of matching attributes
+template <typename vAttr, typename vAttrIsEqual, typename GCost>
+inline std::ostream&
+operator << (std::ostream& os, const eGraph<vAttr, vAttrIsEqual, GCost> &g) {
+  return output_graph<GCost>(os, g);
+}
+
 //-----------------------------------------------------------------------------
 } } // namespace hexgame { namespace utils {
 
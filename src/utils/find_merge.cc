@@ -36,7 +36,7 @@ constexpr uint32_t FindMerge::DEFAULT_NUM_NODES;
 constexpr int FindMerge::DEFAULT_PARENT_NODE_IDX;
 // End of Forward Declarations
 
-FindMerge::FindMerge(std::string file_name) {
+FindMerge::FindMerge(std::string file_name) : _num_sets{0} {
   std::ifstream inp;
   std::string line;
 
@@ -117,6 +117,7 @@ FindMerge::FindMerge(std::string file_name) {
   // set the vector size appropriately and execute the
   // merge find operation based on edges
   _v.resize(num_nodes, FindMerge::DEFAULT_PARENT_NODE_IDX);
+  _num_sets = num_nodes;
   for (auto &edge : edges) {
     this->merge_set(edge.first, edge.second);
   }
@@ -129,22 +130,22 @@ FindMerge::FindMerge(std::string file_name) {
 // Traverse up the node hierarchy to get the highest ancestor
 // Note: The set count is the -ve of the number in the highest ancestor
 int FindMerge::find_set(uint32_t node_idx) {
-  assert(node_idx >= 0 && node_idx < _v.size());
+  assert(node_idx < _v.size());
   
   int idx, gf_idx;
   // identify the set_id uniquely identified by the highest ancestor index
   // traverse up from the node to the highest ancestor (root) of the tree
-  for (idx = node_idx; _v.at(idx) >= 0; idx = _v.at(idx)) {
+  for (idx = node_idx; _v[idx] >= 0; idx = _v[idx]) {
     DLOG(INFO) << "find_set: node_idx " << node_idx 
-               << ": idx " << idx << ": _v[idx] " << _v.at(idx)
-               << ": _v[_v[idx]] " << _v.at(_v.at(idx));
+               << ": idx " << idx << ": _v[idx] " << _v[idx]
+               << ": _v[_v[idx]] " << _v[_v[idx]];
         
     // Limit the height of tree by always relinking node to grandfather
     // Otherwise: we can have a second loop linking all visited nodes 
     // to the root. In practise the linking to grandchildren to root 
     // whenever one can is good enough
-    if ((gf_idx = _v.at(_v.at(idx))) >= 0)
-      _v.at(idx) = gf_idx;
+    if ((gf_idx = _v[_v[idx]]) >= 0)
+      _v[idx] = gf_idx;
   }
   
   return idx;
@@ -152,11 +153,19 @@ int FindMerge::find_set(uint32_t node_idx) {
 
 // useful when invoked from functions expecting const FM
 int FindMerge::find_set(const uint32_t node_idx) const {
+  assert(node_idx < _v.size());
   int idx;
-  for (idx = node_idx; _v.at(idx) >= 0; idx = _v.at(idx));
+  for (idx = node_idx; _v[idx] >= 0; idx = _v[idx]);
   return idx;
 }
 
+// adds a node as a set of its own and returns its idx
+uint32_t FindMerge::add_node(void) {
+  _v.push_back(DEFAULT_PARENT_NODE_IDX);
+  ++_num_sets;
+  return _v.size() - 1;
+}
+
 // merge the two sets and return the identity of the merged set
 int FindMerge::merge_set(int node_idx1, int node_idx2) {
   int set_id1 = find_set(node_idx1);
@@ -169,8 +178,8 @@ int FindMerge::merge_set(int node_idx1, int node_idx2) {
              << ": node_idx2 " << node_idx2 
              << ": set_id1 " << set_id1
              << ": set_id2 " << set_id2 
-             << ": _v[set_id1] " << _v.at(set_id1) 
-             << ": _v[set_id2] " << _v.at(set_id2);
+             << ": _v[set_id1] " << _v[set_id1] 
+             << ": _v[set_id2] " << _v[set_id2];
         
   // The two sets are already merged
   if (set_id1 == set_id2)
@@ -186,13 +195,14 @@ int FindMerge::merge_set(int node_idx1, int node_idx2) {
   
   // As such, the smaller of the two sets has
   // the larger nubmer of children
-  if (_v.at(set_id1) < _v.at(set_id2)) { 
-    _v.at(set_id1) += _v.at(set_id2);
-    _v.at(set_id2) = set_id1;
+  --_num_sets;
+  if (_v[set_id1] < _v[set_id2]) { 
+    _v[set_id1] += _v[set_id2];
+    _v[set_id2] = set_id1;
     return set_id1;
   }
-  _v.at(set_id2) += _v.at(set_id1);
-  _v.at(set_id1) = set_id2;
+  _v[set_id2] += _v[set_id1];
+  _v[set_id1] = set_id2;
   return set_id2;
 }
 
@@ -219,24 +229,18 @@ std::ostream& operator <<(std::ostream& os,
   os << "-----------------------------" << std::endl;
   os << "Num Nodes: " << fm._v.size() << std::endl;
   os << "Array: { ";
-  
-  std::vector<int> sets;
-  for (uint32_t idx = 0; idx < fm._v.size(); ++idx) {
-    os << fm._v.at(idx) << " ";
-    if (fm._v.at(idx) < 0)
-      sets.push_back(idx);
-  }
+  for (uint32_t idx = 0; idx < fm._v.size(); ++idx)
+    os << fm._v[idx] << " ";
   os << "}" << std::endl;
   
-  os  << "SETS (#sets: " << sets.size() << ")" << std::endl
+  FindMerge::Components comps(fm);
+  os  << "SETS (#sets: " << comps.get_num_components() << ")" << std::endl
       << "----------------" << std::endl;
-  for (int &set_id : sets) {
-    os << "  Set ID: " << set_id;
+  for (uint32_t c = 0; c < comps.get_num_components(); ++c) {
+    os << "  Set ID: " << comps.get_set_id(c);
     os << " { ";
-    for (uint32_t idx=0; idx<fm._v.size(); ++idx) {
-      if (set_id == fm.find_set(idx))
-        os << idx << " ";
-    } 
+    for (uint32_t idx : comps.members(c))
+      os << idx << " ";
     os << "}" << std::endl;
   }
   os << "-----------------------------" << std::endl;
@@ -244,5 +248,49 @@ std::ostream& operator <<(std::ostream& os,
   return os;
 }
 
+// Components: one pass over the nodes. A node walks up only until it
+// reaches a node whose component is already known (or the root) and then
+// memoizes the component on every node of the walked path.
+FindMerge::Components::Components(const FindMerge &fm) :
+    _comp(fm._v.size(), fm._v.size()) {
+  const std::vector<int> &v = fm._v;
+  const uint32_t n = v.size();
+  const uint32_t unknown = n;
+
+  // Roots in ascending order get the component ids
+  for (uint32_t idx = 0; idx < n; ++idx) {
+    if (v[idx] < 0) {
+      _comp[idx] = _set_id.size();
+      _set_id.push_back(idx);
+    }
+  }
+
+  // Memoize the component of every node: path reused across nodes
+  std::vector<uint32_t> path;
+  for (uint32_t idx = 0; idx < n; ++idx) {
+    uint32_t cur = idx;
+    while (_comp[cur] == unknown) {
+      path.push_back(cur);
+      cur = v[cur];
+    }
+    for (uint32_t p : path)
+      _comp[p] = _comp[cur];
+    path.clear();
+  }
+
+  // Bucket the members by component: counting sort keeps nodes ascending
+  _off.assign(_set_id.size() + 1, 0);
+  for (uint32_t idx = 0; idx < n; ++idx)
+    ++_off[_comp[idx] + 1];
+  for (uint32_t c = 0; c < _set_id.size(); ++c)
+    _off[c + 1] += _off[c];
+  _member.resize(n);
+  std::vector<uint32_t> fill(_off.begin(), _off.end() - 1);
+  for (uint32_t idx = 0; idx < n; ++idx)
+    _member[fill[_comp[idx]]++] = idx;
+
+  return;
+}
+
 //-----------------------------------------------------------------------------
 } } // namespace hexgame { namespace utils {
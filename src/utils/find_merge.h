@@ -19,6 +19,7 @@
 
 // Standard C++ Headers
 #include <iostream>
+#include <vector>           // std::vector
 // Standard C Headers
 // Google Headers
 // Local Headers
@@ -33,13 +34,15 @@ namespace hexgame { namespace utils {
 // parent node (by storing the idx of the parent node)
 // The highest ancestor does not have any parent - denoted by a -ve number 
 // The -ve number is the count of the number of nodes in its set
+// Components of the sets are enumerated via a Components snapshot that
+// is built in one linear pass (see get_components)
 class FindMerge {
  public:
   constexpr static uint32_t MIN_NODES = 5;
   constexpr static uint32_t DEFAULT_NUM_NODES = 10;
   constexpr static int      DEFAULT_PARENT_NODE_IDX = -1;
   explicit FindMerge(std::size_t n=DEFAULT_NUM_NODES) : 
-      _v(n, DEFAULT_PARENT_NODE_IDX) {};
+      _v(n, DEFAULT_PARENT_NODE_IDX), _num_sets{n} {};
   explicit FindMerge(std::string file_name);
   ~FindMerge() = default;
 
@@ -57,9 +60,81 @@ class FindMerge {
   // useful when invoked from functions expecting const FM
   int find_set(const uint32_t node_idx) const;
 
+  // adds a node as a set of its own and returns its idx
+  uint32_t add_node(void);
+
   // merge the two sets and return the identity of the merged set
   int merge_set(int node_idx1, int node_idx2);
 
+  inline std::size_t get_num_nodes(void) const { return _v.size(); }
+
+  // # of disjoint sets (components)
+  inline std::size_t component_count(void) const { return _num_sets; }
+
+  // # of nodes in the set of node_idx
+  inline uint32_t size_of(uint32_t node_idx) const {
+    return -_v[find_set(node_idx)];
+  }
+
+  // Components: snapshot of the partition into sets. Members of every
+  // component are stored contiguously (bucketed) in ascending node order.
+  // Components are ordered by ascending set id.
+  // Built in O(n): every node memoizes the component of its highest
+  // ancestor so no path is walked twice.
+  // Snapshot is invalidated by any subsequent merge_set.
+  // EXAMPLE USAGE:
+  //   FindMerge::Components comps = fm.get_components();
+  //   for (uint32_t c = 0; c < comps.get_num_components(); ++c)
+  //     for (uint32_t node : comps.members(c)) ...
+  class Components {
+   public:
+    // Range of members of one component: usable in range based for
+    class Members {
+     public:
+      Members(const uint32_t *b, const uint32_t *e) : _b{b}, _e{e} {}
+      inline const uint32_t *begin(void) const { return _b; }
+      inline const uint32_t *end(void) const { return _e; }
+      inline std::size_t size(void) const { return _e - _b; }
+     private:
+      const uint32_t *_b, *_e;
+    };
+
+    explicit Components(const FindMerge &fm);
+
+    inline uint32_t get_num_components(void) const {
+      return _set_id.size();
+    }
+    // set id (highest ancestor) of component comp_idx
+    inline uint32_t get_set_id(uint32_t comp_idx) const {
+      return _set_id.at(comp_idx);
+    }
+    // component idx of node_idx
+    inline uint32_t get_component(uint32_t node_idx) const {
+      return _comp.at(node_idx);
+    }
+    inline Members members(uint32_t comp_idx) const {
+      return Members(_member.data() + _off.at(comp_idx),
+                     _member.data() + _off.at(comp_idx + 1));
+    }
+
+   private:
+    std::vector<uint32_t> _set_id; // comp idx -> set id
+    std::vector<uint32_t> _comp;   // node idx -> comp idx
+    std::vector<uint32_t> _off;    // comp idx -> offset in _member
+    std::vector<uint32_t> _member; // members bucketed by comp idx
+  };
+
+  inline Components get_components(void) const { return Components(*this); }
+
+  // invokes func(set_id, members) for every component in ascending
+  // set id order: members is a Components::Members range
+  template <typename Func>
+  void for_each_component(Func func) const {
+    Components comps(*this);
+    for (uint32_t c = 0; c < comps.get_num_components(); ++c)
+      func(comps.get_set_id(c), comps.members(c));
+  }
+
   //   Dumps the state of the find_merge in file_name
   void output_to_file(std::string file_name);
 
@@ -69,6 +144,7 @@ class FindMerge {
  protected:
  private:
   std::vector<int> _v;
+  std::size_t      _num_sets;
 };
 
 //-----------------------------------------------------------------------------
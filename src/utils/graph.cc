@@ -254,32 +254,7 @@ void Graph<GCost>::output_to_file(std::string file_name) {
 // cout << "The graph: " << endl << g << endl << "---------" << endl;
 template <typename GCost>
 ostream& operator << (ostream& os, const Graph<GCost> &g) {
-  os << "#************************#" << endl;
-  os << "# GRAPH:                 #" << endl;
-  os << "#------------------------#" << endl;
-  os << "# FORMAT:                #" << endl;
-  os << "# num_vertices           #" << endl;
-  os << "# svid dvid edge_cost    #" << endl; 
-  os << "#^^^^^^^^^^^^^^^^^^^^^^^^#" << endl;
-  os << "# GEdgeType: " << ((g._type == GEdgeType::UNDIRECTED) ? "U" : "D")
-     << "#" << endl;
-  os << "# #V: " << g.get_num_vertices() 
-     << ";" << " #E(uniq): " << g.get_num_edges() << "#" << endl;
-  os << "##########################" << endl;
-  os << g.get_num_vertices() << endl;
-
-  // Iterate through all vertices of the graph
-  for (GVertexId vid=0; vid <g.get_num_vertices(); ++vid) {
-    // Iterate through all edges of the given vertex
-    for (GEdgeCIter<GCost> it = g.ecbegin(vid); it != g.ecend(vid); ++it) {
-      GEdgeIterConstReference<GCost> edge{*it};
-      os << edge.first.first << " " << edge.first.second << " " << edge.second << endl;    
-    }
-  }    
-
-  os << "#************************#" << endl;
-  
-  return os;
+  return output_graph<GCost>(os, g);
 }
 
 // Trigger instantiation
@@ -141,7 +141,8 @@ enum class GEdgeType {UNDIRECTED = 0, DIRECTED};
 // Iterator Options: BFS ORDER, DFS ORDER
 enum class GVertexIterType {DFS_ORDER=0, BFS_ORDER};
 
-template <typename GCost>
+// G: graph type iterated: neighbors are determined by G::get_next_nbr
+template <typename GCost, typename G = Graph<GCost>>
 class GVertexCIter;
 
 // template <typename GCost>
@@ -151,7 +152,7 @@ using GVertexIterSeed     = std::vector<GVertexId>;
 using GVertexIterValue    = GVertexId;
 using GVertexIterConstReference= const GVertexId&;
 
-template <typename GCost>
+template <typename GCost, typename G = Graph<GCost>>
 class GEdgeCIter;
 
 // Used for the hashing function to store edges in unordered map
@@ -241,6 +242,9 @@ class Graph {
     return (this->_edges.size()); 
   }
 
+  // Graph type: directed or undirected
+  inline GEdgeType get_edge_type() const { return _type; }
+
   // add (g, x, y): adds to G the edge from x to y, if it is not there.
   // Creates an edge (adjacency) in the graph with edge and (optional) value
   void add_edge(GVertexId v1, GVertexId v2, GCost value =kGMinCost<GCost>());
@@ -292,25 +296,53 @@ class Graph {
   GEdgeCIter<GCost> ecbegin(GVertexId vid) const;
   GEdgeCIter<GCost> ecend(GVertexId vid) const;
 
- protected:
+  // NEIGHBOR POLICY: invoked by iterators of the graph type G
+  // (GEdgeCIter<GCost, G>) & bound at compile time. A derived class
+  // (e.g. eGraph) hides it with its own policy & iterators: consumers
+  // walking neighbors (MSTPrim, SPTDijkstra, output_graph) are templated
+  // on the graph type so that they see the policy of the derived class.
   // get_next_nbr: provide the first nbr vertex that is available
   // immediately from or after the passed nbr_vid 
-  virtual GVertexId get_next_nbr(GVertexId vid, GVertexId nbr_vid) const {
+  // Adjacency row of vid is scanned 32 vertices at a time
+  inline GVertexId get_next_nbr(GVertexId vid, GVertexId nbr_vid) const {
     GVertexId vid_end = get_num_vertices();
     assert(vid < vid_end);
-    for (GVertexId vid2 = nbr_vid; vid2 < vid_end; ++vid2) {
-      if (isset_adjmap(std::make_pair(vid, vid2)) == true)
-        return vid2;
+    for (GVertexId vid2 = nbr_vid; vid2 < vid_end; vid2 += 32) {
+      uint32_t bits = get_adjmap_bits(vid, vid2);
+      if (vid_end - vid2 < 32)
+        bits &= (1U << (vid_end - vid2)) - 1;
+      if (bits != 0)
+        return vid2 + __builtin_ctz(bits);
     }
     return kGMaxVertexId<GCost>();
   }
+
+  // ADJACENCY (read only): also used by attribute overlays of the graph
   // Tests whether edge eid is present in the adjacency map
   inline bool isset_adjmap(const GEdgeId &eid) const {
     // For Undirected graph both edge {v1, v2} and {v2, v1} would be present
     // So absence of any one of the two signifies the edge is not present
     return _adjmap.is_bit_set(pos(eid.first, eid.second));
   }
+  // 32 bits of the adjacency row of vid: bit i is set when edge
+  // (vid, nbr_vid + i) is present. Bits beyond the row are garbage
+  // (next row) and must be masked by the caller.
+  inline uint32_t get_adjmap_bits(GVertexId vid, GVertexId nbr_vid) const {
+    return _adjmap.get_bits(pos(vid, nbr_vid));
+  }
 
+  // Edge (vid, nbr_vid) as stored in the edge container: the edge must
+  // be present. Undirected edges are stored once as (min vid, max vid).
+  inline GEdgeIterConstReference<GCost>
+  get_edge_elem(GVertexId vid, GVertexId nbr_vid) const {
+    if (_type == GEdgeType::UNDIRECTED && vid > nbr_vid)
+      std::swap(vid, nbr_vid);
+    GEdgeContainerIter<GCost> it = _edges.find(std::make_pair(vid, nbr_vid));
+    assert(it != _edges.cend());
+    return *it;
+  }
+
+ protected:
 
  private:
   //! Fixed seed generates predictable MC runs when running test SW or debugging
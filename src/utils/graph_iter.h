@@ -22,6 +22,8 @@
 #include <limits>           // std::numeric_limits
 #include <queue>            // std::queue
 #include <stack>            // std::stack
+#include <stdexcept>        // std::out_of_range
+#include <string>           // std::string
 #include <vector>           // std::vector
 // Standard Headers
 #include <cassert>          // assert
@@ -33,15 +35,22 @@ namespace hexgame { namespace utils {
 //-----------------------------------------------------------------------------
 
 // ITERATOR Definitions
+// G: graph type iterated (Graph or a class derived from Graph e.g. eGraph).
+// The neighbor policy G::get_next_nbr is resolved at compile time (e.g.
+// the attribute overlay of eGraph) so that BFS/DFS & edge iteration over
+// G are inlinable.
+// Definitions are in the header so that iterators may be instantiated for
+// any G: the <uint32_t> Graph iterators are instantiated in graph_iter.cc
+
 // Vertex Iterator
-template <typename GCost>
+template <typename GCost, typename G>
 class GVertexCIter {
  public:
   explicit GVertexCIter(GVertexIterType itype,
-                        const Graph<GCost> &g, 
+                        const G &g, 
                         const GVertexIterSeed &seed_v);
   
-  inline bool operator ==(const GVertexCIter<GCost>& o) const {
+  inline bool operator ==(const GVertexCIter<GCost, G>& o) const {
     return ((this->_itype == o._itype) &&
             (this->_g == o._g) && 
             (this->_q.size() == o._q.size()) &&
@@ -49,18 +58,18 @@ class GVertexCIter {
             (this->_end == o._end));
   }
   
-  inline bool operator !=(const GVertexCIter<GCost>& o) const { 
+  inline bool operator !=(const GVertexCIter<GCost, G>& o) const { 
     return !(*this == o); 
   }
 
   // Implements the prefix increment case: ++iter; (not iter++)
-  GVertexCIter<GCost>& operator++(); 
+  GVertexCIter<GCost, G>& operator++(); 
   // Returns the reference to value stored in container
-  GVertexIterConstReference operator*(); 
+  inline GVertexIterConstReference operator*() { return _next_vid; }
  protected:
  private:
   GVertexIterType       _itype;
-  const Graph<GCost>&   _g;
+  const G&              _g;
   GVertexId             _next_vid;
   bool                  _end;
   BitSet                _visited; 
@@ -70,50 +79,168 @@ class GVertexCIter {
 
   // Private Methods
   // Based on itype (BFS/DFS) push the queue or stack
-  void push(const GVertexId& vid);
+  inline void push(const GVertexId& vid) {
+    if (_itype == GVertexIterType::BFS_ORDER)
+      _q.push(vid);
+    else
+      _s.push(vid);
+    return;
+  }
   // Based on itype (BFS/DFS) push the queue or stack
-  void pop(void);
+  inline void pop(void) {
+    if (_itype == GVertexIterType::BFS_ORDER)
+      _q.pop();
+    else
+      _s.pop();
+    return;
+  }
   // Based on itype (BFS/DFS) front the queue or top the stack
-  GVertexId& top(void);
+  inline GVertexId& top(void) {
+    return (_itype == GVertexIterType::BFS_ORDER) ? _q.front() : _s.top();
+  }
   // Based on itype (BFS/DFS) return the size of queue or stack
-  std::size_t size(void);
+  inline std::size_t size(void) {
+    return (_itype == GVertexIterType::BFS_ORDER) ? _q.size() : _s.size();
+  }
 };
 
 // Edge Iterator
-template <typename GCost>
+template <typename GCost, typename G>
 class GEdgeCIter {
  public:
-  explicit GEdgeCIter(const Graph<GCost> &g, 
+  explicit GEdgeCIter(const G &g, 
                       GVertexId vid=0, 
-                      GVertexId next_nbr_vid=0);
+                      GVertexId next_nbr_vid=0) :
+      _g(g), _vid(vid), _nbr_vid(next_nbr_vid) {
+    if (this->_vid >= _g.get_num_vertices())
+      throw std::out_of_range("VertexId exceeds # of vertices in graph");
+    this->_nbr_vid = _g.get_next_nbr(vid, next_nbr_vid);
+  }
   
-  bool operator ==(const GEdgeCIter<GCost>& o) const {
+  bool operator ==(const GEdgeCIter<GCost, G>& o) const {
     return ((this->_g == o._g) && 
             (this->_vid == o._vid) &&
             (this->_nbr_vid == o._nbr_vid));
   }
   
-  bool operator !=(const GEdgeCIter<GCost>& o) const { 
+  bool operator !=(const GEdgeCIter<GCost, G>& o) const { 
     return !(*this == o); 
   }
   
   // Implements the prefix increment case: ++iter; (not iter++)
-  GEdgeCIter<GCost>& operator++(); 
+  // Move to the immediately next possible nbr and call get_next_nbr
+  inline GEdgeCIter<GCost, G>& operator++() {
+    this->_nbr_vid = this->_g.get_next_nbr(this->_vid, this->_nbr_vid + 1);
+    return (*this);
+  }
   // Returns the reference to value stored in container
-  GEdgeIterConstReference<GCost> operator*(); 
+  inline GEdgeIterConstReference<GCost> operator*() {
+    return _g.get_edge_elem(_vid, _nbr_vid);
+  }
+
+  // neighbor vertex_id of the edge currently pointed to
+  inline GVertexId get_nbr(void) const { return _nbr_vid; }
 
  protected:
  private:
-  const Graph<GCost> &_g;
+  const G &_g;
   // vertex_id over which the iterator is elaborating edges
   const GVertexId _vid; 
   // neighbor vertex_id that is the next edge candidate for _vid
   GVertexId _nbr_vid; 
 };
 
+template <typename GCost, typename G>
+GVertexCIter<GCost, G>::GVertexCIter(GVertexIterType itype,
+                                     const G &g, 
+                                     const GVertexIterSeed& seed_v) :
+    _itype(itype), _g(g), 
+    _next_vid{0}, _end(false), 
+    _visited(BitSet::linear(g.get_num_vertices())) {
+  // 1. add all the vertices in the seed vector to the container
+  for (auto &vid : seed_v) {
+    if (_visited.is_bit_set(vid) == true)
+      continue;
+    _visited.set_bit(vid);
+    this->push(vid);
+  }
+
+  // 2. seed the process by calling the ++ operator so that the top vertex
+  //    of the container is all set to be returned.
+  this->operator++();
+
+  return;
+}
+
+// Implements the prefix increment case: ++iter; (not iter++)
+template <typename GCost, typename G>
+GVertexCIter<GCost, G>& GVertexCIter<GCost, G>::operator++() {
+  // already at end: done
+  if (_end == true) {
+    throw std::string("Out of range: ++can't execute: reached end error");
+  }
+
+  // the container is empty: reached end and done
+  if (this->size() == 0) {
+    _end = true;
+    return *this;
+  }
+
+  // 1. candidate vertex: get the topmost element (candidate to return) & pop the container
+  _next_vid = this->top();
+  this->pop();
+
+  // 2. Iterate over all the edge nbrs of the candidate vertex. Add to the container 
+  //    as the future contenders unless they have already been visited
+  GVertexId nbr_vid;
+  for (auto it = this->_g.ecbegin(_next_vid); it != this->_g.ecend(_next_vid); ++it) {
+    nbr_vid = it.get_nbr();
+    if (_visited.is_bit_set(nbr_vid) == true)
+      continue;
+    _visited.set_bit(nbr_vid);
+    this->push(nbr_vid);
+  }
+
+  return *this;
+}
+
+// Graph Output of the graph type G: edges are listed by the edge
+// iterators of G (e.g. eGraph lists edges of matching attributes only)
+template <typename GCost, typename G>
+std::ostream& output_graph(std::ostream& os, const G &g) {
+  os << "#************************#" << std::endl;
+  os << "# GRAPH:                 #" << std::endl;
+  os << "#------------------------#" << std::endl;
+  os << "# FORMAT:                #" << std::endl;
+  os << "# num_vertices           #" << std::endl;
+  os << "# svid dvid edge_cost    #" << std::endl; 
+  os << "#^^^^^^^^^^^^^^^^^^^^^^^^#" << std::endl;
+  os << "# GEdgeType: "
+     << ((g.get_edge_type() == GEdgeType::UNDIRECTED) ? "U" : "D")
+     << "#" << std::endl;
+  os << "# #V: " << g.get_num_vertices() 
+     << ";" << " #E(uniq): " << g.get_num_edges() << "#" << std::endl;
+  os << "##########################" << std::endl;
+  os << g.get_num_vertices() << std::endl;
+
+  // Iterate through all vertices of the graph
+  for (GVertexId vid=0; vid <g.get_num_vertices(); ++vid) {
+    // Iterate through all edges of the given vertex
+    for (auto it = g.ecbegin(vid); it != g.ecend(vid); ++it) {
+      GEdgeIterConstReference<GCost> edge{*it};
+      os << edge.first.first << " " << edge.first.second << " "
+         << edge.second << std::endl;
+    }
+  }    
+
+  os << "#************************#" << std::endl;
+  
+  return os;
+}
+
 // Suppress implicit instantiation of Graph Iterators
-extern template class GVertexCIter<uint32_t>;
-extern template class GEdgeCIter<uint32_t>;
+extern template class GVertexCIter<uint32_t, Graph<uint32_t>>;
+extern template class GEdgeCIter<uint32_t, Graph<uint32_t>>;
 
 //-----------------------------------------------------------------------------
 } } // namespace hexgame { namespace utils {
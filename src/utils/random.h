@@ -0,0 +1,144 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+// Standard C++ Headers
+#include <algorithm>        // std::swap
+#include <array>            // std::array
+#include <iterator>         // std::iterator_traits
+#include <limits>           // std::numeric_limits
+// Standard C Headers
+#include <cassert>          // assert()
+#include <cstdint>          // uint64_t
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// FastRandom: xoshiro256** (Blackman & Vigna) random stream for playouts.
+// 256 bits of state advanced by a few shifts, rotates & xors: much cheaper
+// than std::default_random_engine & std::uniform_int_distribution.
+// The state is seeded from a 64 bit seed via splitmix64 as recommended by
+// the authors. Satisfies UniformRandomBitGenerator: usable by <random>.
+// get_bounded draws uniformly from [0, range) by Lemire's multiply & shift:
+// a division happens only on the rare draws that could bias the result.
+// partial_shuffle is an incremental Fisher-Yates: it draws only as many
+// elements as the caller consumes & leaves the rest in place.
+// EXAMPLE USAGE:
+//   FastRandom rnd(seed);
+//   rnd.partial_shuffle(v.begin(), v.begin() + 1, v.end()); // v[0] random
+//   rnd.shuffle(v.begin() + 1, v.end());                    // rest random
+class FastRandom {
+ public:
+  using result_type = uint64_t;
+
+  explicit FastRandom(uint64_t seed = 0) { this->seed(seed); }
+  ~FastRandom() = default;
+
+  // Copy & assignment allowed: a stream is a plain value of 32 bytes
+  FastRandom(const FastRandom &) = default;
+  FastRandom& operator=(const FastRandom &) = default;
+
+  static constexpr result_type min(void) { return 0; }
+  static constexpr result_type max(void) {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  // splitmix64 expands seed into the 256 bits of state: never all zeros
+  inline void seed(uint64_t seed) {
+    for (auto &s : _s) {
+      seed += 0x9e3779b97f4a7c15ULL;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      s = z ^ (z >> 31);
+    }
+    return;
+  }
+
+  inline result_type operator()(void) {
+    const uint64_t result = rotl(_s[1] * 5, 7) * 9;
+    const uint64_t t = _s[1] << 17;
+    _s[2] ^= _s[0];
+    _s[3] ^= _s[1];
+    _s[1] ^= _s[2];
+    _s[0] ^= _s[3];
+    _s[2] ^= t;
+    _s[3] = rotl(_s[3], 45);
+    return result;
+  }
+
+  // Uniform in [0, range): Lemire's nearly divisionless method on the
+  // upper 32 bits (the strongest bits of xoshiro256**)
+  inline uint32_t get_bounded(uint32_t range) {
+    assert(range > 0);
+    uint64_t m = static_cast<uint64_t>(next32()) * range;
+    uint32_t l = static_cast<uint32_t>(m);
+    if (l < range) {
+      // 2**32 mod range: draws below it would favor some results
+      uint32_t threshold = static_cast<uint32_t>(-range) % range;
+      while (l < threshold) {
+        m = static_cast<uint64_t>(next32()) * range;
+        l = static_cast<uint32_t>(m);
+      }
+    }
+    return static_cast<uint32_t>(m >> 32);
+  }
+
+  // Incremental Fisher-Yates: [first, middle) becomes a uniformly random
+  // selection (in random order) of [first, last). Costs one draw per
+  // element of [first, middle) regardless of the size of [first, last).
+  template <typename RandomIt>
+  inline void partial_shuffle(RandomIt first, RandomIt middle,
+                              RandomIt last) {
+    assert(first <= middle && middle <= last);
+    auto n = last - first;
+    for (; first != middle; ++first, --n) {
+      auto j = get_bounded(static_cast<uint32_t>(n));
+      if (j != 0)
+        std::swap(*first, *(first + j));
+    }
+    return;
+  }
+
+  // Uniformly random permutation of [first, last): the last element needs
+  // no draw
+  template <typename RandomIt>
+  inline void shuffle(RandomIt first, RandomIt last) {
+    if (last - first > 1)
+      partial_shuffle(first, last - 1, last);
+    return;
+  }
+
+ protected:
+ private:
+  std::array<uint64_t, 4> _s; // state: never all zeros
+
+  static inline uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+  inline uint32_t next32(void) {
+    return static_cast<uint32_t>((*this)() >> 32);
+  }
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _RANDOM_H_
@@ -0,0 +1,93 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <iostream>
+#include <utility>          // std::swap
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/rollback_find_merge.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t RollbackFindMerge::DEFAULT_NUM_NODES;
+constexpr int RollbackFindMerge::DEFAULT_PARENT_NODE_IDX;
+// End of Forward Declarations
+
+// merge the two sets and return the identity of the merged set
+int RollbackFindMerge::merge_set(uint32_t node_idx1, uint32_t node_idx2) {
+  int set_id1 = find_set(node_idx1);
+  int set_id2 = find_set(node_idx2);
+
+  // The two sets are already merged: nothing to record
+  if (set_id1 == set_id2)
+    return set_id1;
+
+  // The smaller set (larger -ve count) merges to the larger set
+  if (_v[set_id1] > _v[set_id2])
+    std::swap(set_id1, set_id2);
+
+  // Record both words before they change: count of the larger set and
+  // the root of the smaller set
+  _undo.push_back(UndoElem{static_cast<uint32_t>(set_id1), _v[set_id1]});
+  _undo.push_back(UndoElem{static_cast<uint32_t>(set_id2), _v[set_id2]});
+
+  _v[set_id1] += _v[set_id2];
+  _v[set_id2] = set_id1;
+
+  return set_id1;
+}
+
+// undo all merges done after checkpoint cp was taken
+void RollbackFindMerge::rollback(Checkpoint cp) {
+  assert(cp <= _undo.size());
+  assert((cp % 2) == 0);
+
+  DLOG(INFO) << "rollback: checkpoint " << cp
+             << ": # merges undone " << (_undo.size() - cp)/2;
+
+  while (_undo.size() > cp) {
+    const UndoElem &u = _undo.back();
+    _v[u.idx] = u.val;
+    _undo.pop_back();
+  }
+
+  return;
+}
+
+std::ostream& operator <<(std::ostream& os,
+                          const RollbackFindMerge& fm) {
+  os << "-----------------------------" << std::endl;
+  os << "Num Nodes: " << fm._v.size() << std::endl;
+  os << "Num Sets: " << fm.get_num_sets() << std::endl;
+  os << "Undo Depth: " << fm._undo.size() << std::endl;
+  os << "Array: { ";
+  for (uint32_t idx = 0; idx < fm._v.size(); ++idx)
+    os << fm._v[idx] << " ";
+  os << "}" << std::endl;
+  os << "-----------------------------" << std::endl;
+
+  return os;
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
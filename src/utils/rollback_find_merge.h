@@ -0,0 +1,118 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _ROLLBACK_FIND_MERGE_H_
+#define _ROLLBACK_FIND_MERGE_H_
+
+// Standard C++ Headers
+#include <iostream>
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// RollbackFindMerge: find merge algorithm whose merges can be undone.
+// Same representation as FindMerge: a vector where given a node (idx)
+// the vector points to the parent node. The highest ancestor stores the
+// -ve count of the number of nodes in its set.
+// 1. Every merge_set records the two words it changes (old parent & old
+//    count) on an undo stack.
+// 2. checkpoint() remembers the depth of the undo stack. rollback(cp)
+//    pops and restores words until the stack is back to that depth:
+//    O(# merges since checkpoint). Checkpoints may be nested.
+// 3. Merges are by size without path compression: find_set never writes,
+//    so the undo stack only needs to record merges. Union by size alone
+//    bounds the height of every tree to log2(# nodes).
+// EXAMPLE USAGE:
+//   RollbackFindMerge fm(n);
+//   auto cp = fm.checkpoint();
+//   fm.merge_set(a, b); ... if (fm.same_set(x, y)) ...
+//   fm.rollback(cp);
+class RollbackFindMerge {
+ public:
+  constexpr static uint32_t DEFAULT_NUM_NODES = 10;
+  constexpr static int      DEFAULT_PARENT_NODE_IDX = -1;
+  using Checkpoint = std::size_t;
+
+  explicit RollbackFindMerge(std::size_t n=DEFAULT_NUM_NODES) :
+      _v(n, DEFAULT_PARENT_NODE_IDX) {}
+  ~RollbackFindMerge() = default;
+
+  // Copy ctor allowed: e.g. per thread copies of a game board
+  RollbackFindMerge(const RollbackFindMerge &) = default;
+  // Prevent unintended bad usage:
+  // Disallow: assignable or move ctor/assignable (C++11)
+  RollbackFindMerge(RollbackFindMerge &&) = delete; // C++11 only
+  void operator=(const RollbackFindMerge &) = delete;
+  void operator=(const RollbackFindMerge &&) = delete; // C++11 only
+
+  inline std::size_t get_num_nodes(void) const { return _v.size(); }
+
+  // # of disjoint sets: every merge recorded two words on the undo stack
+  inline std::size_t get_num_sets(void) const {
+    return _v.size() - _undo.size()/2;
+  }
+
+  // Traverse up the node hierarchy to get the highest ancestor
+  inline int find_set(uint32_t node_idx) const {
+    assert(node_idx < _v.size());
+    int idx = node_idx;
+    while (_v[idx] >= 0)
+      idx = _v[idx];
+    return idx;
+  }
+
+  // true when both nodes belong to the same set
+  inline bool same_set(uint32_t node_idx1, uint32_t node_idx2) const {
+    return (find_set(node_idx1) == find_set(node_idx2));
+  }
+
+  // # of nodes in the set of node_idx
+  inline uint32_t size_of(uint32_t node_idx) const {
+    return -_v[find_set(node_idx)];
+  }
+
+  // merge the two sets and return the identity of the merged set
+  int merge_set(uint32_t node_idx1, uint32_t node_idx2);
+
+  // mark the current state: merges after the mark may be rolled back
+  inline Checkpoint checkpoint(void) const { return _undo.size(); }
+
+  // undo all merges done after checkpoint cp was taken
+  void rollback(Checkpoint cp);
+
+  friend std::ostream & operator <<(std::ostream& os,
+                                    const RollbackFindMerge& fm);
+
+ protected:
+ private:
+  // Undo record: the word at idx had value val before the merge
+  struct UndoElem {
+    uint32_t idx;
+    int      val;
+  };
+  std::vector<int>      _v;
+  std::vector<UndoElem> _undo;
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _ROLLBACK_FIND_MERGE_H_
@@ -26,11 +26,16 @@
 //   if (sp.get_path_cost(vid1, vid2, path_cost) == true)
 //     process path_cost
 //   avg_path = sp.get_avg_path_size(vid, avg_path) provides avg_path_len
+//   SPTDijkstra<uint32_t, eGraph<Color>> sp(eg) follows the edges between
+//   vertices of matching attributes (neighbors iterated by G::ecbegin)
 
 #ifndef _SPT_DIJKSTRA_H_
 #define _SPT_DIJKSTRA_H_
 
+#include <fstream>      // std::ofstream
 #include <iostream>     // std::cout
+#include <sstream>      // std::stringstream
+#include <stdexcept>    // std::out_of_range
 #include <vector>       // std::vector
 #include <utility>      // std::pair
 #include <string>       // std::string
@@ -39,20 +44,27 @@
 
 #include <cassert>      // assert
 
+#include <glog/logging.h>   // Daemon Log function
+
 #include "utils/graph.h"
+#include "utils/graph_iter.h"
+#include "utils/prio_q.h"
 #include "utils/tree.h"
 
 namespace hexgame { namespace utils {
 //-----------------------------------------------------------------------------
 // Forward Declarations
-template <typename GCost>
+// G: graph type searched (Graph or a class derived from Graph e.g. eGraph)
+// Definitions are in the header so that SPTDijkstra may be instantiated
+// for any G: SPTDijkstra<uint32_t> is instantiated in spt_dijkstra.cc
+template <typename GCost, typename G = Graph<GCost>>
 class SPTDijkstra;
 
-template <typename GCost>
-std::ostream& operator <<(std::ostream&, const SPTDijkstra<GCost>&);
+template <typename GCost, typename G>
+std::ostream& operator <<(std::ostream&, const SPTDijkstra<GCost, G>&);
 // End of Forward Declarations
 
-template <typename GCost>
+template <typename GCost, typename G>
 class SPTDijkstra {
  public:
 
@@ -62,7 +74,7 @@ class SPTDijkstra {
   //     vertex 0 as the default root vertex. 
   //     One can subsequently run_spt_dijkstra with another root vertex
   //     if so desired.
-  SPTDijkstra(const Graph<GCost>& g): _g(g), _spt(g) { run_spt_dijkstra(0); }
+  SPTDijkstra(const G& g): _g(g), _spt(g) { run_spt_dijkstra(0); }
 
   // Destructor
   ~SPTDijkstra() {}
@@ -93,12 +105,16 @@ class SPTDijkstra {
   // return number of vertices in the tree
   inline uint32_t get_num_vertices() const { return _spt.get_num_vertices(); }
 
+  // return the shortest path tree: e.g. to build a TreeIndex over it
+  inline const Tree<GCost>& get_tree() const { return _spt; }
+
   //   Dumps the state of the SPT in file_name
   void output_to_file(std::string file_name);
 
   // helper function to allow chained output cmds: example
   // cout << "The SPT: " << endl << spt << endl << "---------" << endl;
-  friend std::ostream& operator << <>(std::ostream& os, const SPTDijkstra<GCost> &spt);
+  friend std::ostream& operator << <>(std::ostream& os,
+                                      const SPTDijkstra<GCost, G> &spt);
 
   // ITERATORS: 
   //   We simply use delegation to Tree class
@@ -114,13 +130,321 @@ class SPTDijkstra {
  protected:
 
  private:
-  const Graph<GCost> &_g;
+  // PQElem are units store in prioirty Q while running the MST Prim 
+  // algorithm: 
+  using PQElem = std::pair<GVertexId, TreeElem<GCost>>;
+
+  // Common Useful Function Objects
+  class MinCostVertex {
+   public:
+    // Vertex v1 has "lower" prio than v2 if v1 has "higher" cost than v2
+    bool operator() (const PQElem& e1, const PQElem& e2) const {
+      return (e1.second.second > e2.second.second);
+    }
+  };
+
+  class EqRefVertexId {
+   public:
+    // Vertex v1 is "equal" from a "find" perspective if the reference
+    // (first) vertex ids are the same
+    bool operator() (const PQElem& e1, const PQElem& e2) const {
+      return (e1.first == e2.first);
+    }
+  };
+
+  const G &_g;
   Tree<GCost> _spt;
   // as the graph does not allow self referential nodes
   // i.e. an edge from a node N to itsel, we designate a root of a tree 
   // by having it point to itself in the tree
 };
 
+// Priority Q: Keeps a list of candidate edges that are candidates for 
+// Shortest Path Tree. 
+// Initial Condition: 
+//   1. All vertices are at infinite cost in the spanning tree
+//   2. All vertices (v1) have root vertex as immediate parent with infinite cost
+
+//   run_spt_dijkstra with srv_vid as root of the tree
+//     arg1: root vertex id
+template <typename GCost, typename G>
+void SPTDijkstra<GCost, G>::run_spt_dijkstra(GVertexId root_vid) {
+  if (root_vid >= _g.get_num_vertices()) {
+    DLOG(ERROR) << "Graph has " << _g.get_num_vertices() 
+                << " vertices: spt_dijkstra called with vertex_id " 
+                << root_vid;
+    throw std::out_of_range("VertexId exceeds # of vertices in graph");
+  }
+  
+  // priority Q: keeps all vertices that are candidates but not yet 
+  // a part of the Minimum Spanning Tree
+  PrioQ <PQElem, MinCostVertex, EqRefVertexId> pq;
+
+  // 1. Initiatlize Data Structures:
+  // 1.a. spt = {} i.e. parents of all vertices is vertex 0 with INFINITE cost
+  // 1.B. pq = {all vertices of graph with cost 0 except root vertex}
+  // Start with adding all the vertices to pq with infinite cost except
+  // the "root" graph: we will add vertex root_id with cost 0.
+  // Add the rest of the vertices with cost "infinity"
+  PQElem elem; 
+  TreeElem<GCost> e;
+  GVertexId vid = 0;
+  for (auto it = _spt.begin(); it != _spt.end(); ++it, ++vid) {    
+    e = std::make_pair(root_vid, kGInfinityCost<GCost>());
+    *it = e;
+    if (vid == root_vid)
+      e.second = 0;
+    elem = std::make_pair(vid, e);
+    pq.insert_elem(elem);
+  }
+
+  // 2. Iterate until pq is empty or we do not find any vertex that is 
+  //    at an infinite cost (i.e. not reachable at all)
+  // a. spt <- pick the vertex with the minimal edge cost from pq.
+  // b. Update pq: If any nbr vertex in pq has now a lower path cost 
+  //    via the vertex that was just added to SPT, then update
+  //    that path cost for the nbr than what is currently in pq
+  uint32_t num_edges = _g.get_num_edges();
+  uint32_t num_iter=0;
+
+  while (pq.get_size() > 0) {
+    // 2.a. spt <- pick the vertex with the minimal edge cost from pq.
+    PQElem elem(pq.get_top());
+    TreeElem<GCost> e = elem.second;
+    
+    GVertexId v=elem.first; // current vertex examined
+    GCost vcost=e.second;   // path cost of reaching v
+
+    DLOG(INFO) << "PriQ: size " << pq.get_size() << "-> top elem = [" << v << "]:<" 
+               << e.first << "," << e.second << ">";
+    DLOG(INFO) << "PriQ State: " << pq;
+
+    // If the cost of the lowest cost edge is infinity then we do not
+    // have a tree solution that covers all vertices (i.e. graph is 
+    // partitioned when traversing from root_vid: terminate the loop
+    if (vcost >= kGInfinityCost<GCost>()) {
+      DLOG(INFO) << "Graph does NOT have a shortest path tree that "
+                 << "covers all nodes of the tree";
+      break;
+    }
+    pq.pop_top();
+    
+    // add the topmost element to the tree
+    _spt.at(v) = e;
+    
+    // 2.b. Update pq: If any nbr vertex in pq has now a lower path cost 
+    //      via the vertex v that was just added to SPT, then update
+    //      that path cost for the nbr than what is currently in pq
+    // 2.b.i. Traverse all the vertices nbr reachable from v. 
+    //        Iterate through all edges of vertex v to all other vertices ov
+    for (auto it =_g.ecbegin(v); it != _g.ecend(v); ++it) {
+      GEdgeIterConstReference<GCost> edge{*it};
+      DLOG(INFO) << "Reference Vertex " << v << ": Examining Edge " 
+                 << edge.first.first << " " << edge.first.second << " " 
+                 << edge.second << " num_iter " << num_iter << std::endl;
+      
+      // sanity check: iteration should terminate in at most 2*E
+      assert((num_iter++) < (num_edges << 1));
+      assert((edge.first.first == v) || (edge.first.second == v));
+      
+      // 2.b.ii. Identify the other vertex nbr reachable through
+      //         v with associated cost. 
+      //         If nbr is already one among 
+      //         the shortest path tree vertices we can ignore this vertex
+      GVertexId nbr = (edge.first.first == v) ? 
+                      edge.first.second : edge.first.first;
+      e = _spt.at(nbr);
+      if (e.second < kGInfinityCost<GCost>())
+        continue;
+      
+      // 3. Compute the cost of reaching nbr in the SPT that now includes v
+      // 3.a. If this vertex nbr is reachable for the first time (was not even
+      //      visible in pri Q, then add this vertex to the pri Q with the 
+      //      reachability cost.
+      GCost ncost = edge.second + vcost;
+      bool match;
+      PQElem nbr_elem(std::make_pair(nbr, std::make_pair(v, ncost)));
+      PQElem& pq_elem = pq.contains_elem(nbr_elem, match);
+      if (match == false) {
+        pq.insert_elem(nbr_elem);
+        continue;
+      }
+      
+      DLOG(INFO) << "\tNeighbor Vertex: " << nbr << " Cost " << ncost 
+                 << " past cost: " << pq_elem.second.second << std::endl;
+
+      // 3.b.1. If the cost of reaching nbr via v is not less 
+      //        than past estimated cost via some other 
+      //        destination we can ignore this path: goto next iteration
+      if (ncost >= pq_elem.second.second)
+        continue;
+      
+      // 3.b.2. Update the new cost in the pri Q.
+      pq.chg_val(pq_elem, nbr_elem);
+    }
+  }
+
+  return;
+}
+
+//   get_path_size
+//     arg1: source vertex id
+//     arg2: destination vertex id
+//     Return: path_cost from source to destination vertex id
+template <typename GCost, typename G> 
+GCost SPTDijkstra<GCost, G>::get_path_size(GVertexId vid1, 
+                                           GVertexId vid2) {
+  // We first retrieve the shortest path from vid1 to all vertices
+  // Then we just walk the vector until we hit vertex vid2
+
+  // For efficiency we could have terminated the loop as soon as vid2 is 
+  // reached in the shortest path loop instead of trying to find the shortest 
+  // path to all other vertices.
+  // Here: I am being lazy and just trying to reuse the code of 
+  // run_spt_dijkstra :-)
+  this->run_spt_dijkstra(vid1);
+
+  for (auto it = this->cbegin(); it != this->cend(); ++it) {
+    if (it->first == vid2) 
+      return (it->second);
+  } 
+
+  // Set path cost to "INFINITY" as the vid2 is not
+  // reachable from vid1
+  return kGInfinityCost<GCost>();
+}
+
+//   get_avg_path_size_for_vertex
+//     arg1: source vertex id
+//     return: avg path size from given vertex id to all other reachable 
+//             vertices
+template <typename GCost, typename G>
+double SPTDijkstra<GCost, G>::get_avg_path_size_for_vertex(GVertexId vid) {
+  // We first retrieve the shortest path from vid to all vertices
+  // Then we just walk the vector summing up all cost and divide
+  // by the number of entries in the vector 
+  this->run_spt_dijkstra(vid);
+
+  GCost path_cost{0};
+  uint32_t num_vertices = 0;
+  for (auto it = this->cbegin(); it != this->cend(); ++it, ++num_vertices) {
+    // skip over the source vertex itself as that is reachable at cost 0
+    // skip over vertices that are not reachable at all
+    if ((it->first == vid) || (it->second == kGInfinityCost<GCost>()))
+      continue;
+    path_cost += it->second;
+  }
+
+  // For pathological case where there are no edges from the vertex
+  // return MAX possible value
+  if (num_vertices == 0)
+    return kGInfinityCost<GCost>();
+
+  return (static_cast<double>(path_cost)/num_vertices);
+}
+
+//   get_avg_path_size
+//     return: avg path size from all vertices to all other reachable 
+//             vertices
+template <typename GCost, typename G>
+double SPTDijkstra<GCost, G>::get_avg_path_size(void) {
+  // Retrieve all vertices in the graph
+  // Keep a running total of path_size from each source vertex to 
+  // all destination vertices.
+  // Compute the average over all the data
+
+  uint32_t num = 0;
+  GCost path_cost = 0;
+
+  for (GVertexId vid=0; vid < _g.get_num_vertices(); ++vid) {
+    this->run_spt_dijkstra(vid);
+    for (auto it = this->cbegin(); it != this->cend(); ++it, ++num) {
+      // skip over the source vertex itself as that is reachable at cost 0
+      // skip over vertices that are not reachable at all
+      if ((it->first == vid) || (it->second == kGInfinityCost<GCost>()))
+        continue;
+      path_cost += it->second;
+    }
+  }
+
+  // For pathological case where there are no edges from the vertex
+  // return MAX possible value
+  if (num == 0)
+    return kGInfinityCost<GCost>();
+
+  return (path_cost/num);
+}
+
+// Dumps the state of the SPT in file_name
+template <typename GCost, typename G>
+void SPTDijkstra<GCost, G>::output_to_file(std::string file_name) {
+  std::ofstream ofp;
+
+  ofp.open(file_name, std::ios::out);
+  if (!ofp) {
+    std::stringstream ss;
+    ss << "Can't open output file " << file_name;
+    throw ss.str();
+  }
+  // Dump the state of Tree in the output stream
+  ofp << *this;
+  
+  ofp.close();
+
+  return;
+}
+
+// helper function to allow chained output cmds: example
+// cout << "The SPT: " << endl << spt << endl << "---------" << endl;
+template <typename GCost, typename G>
+std::ostream& 
+operator << (std::ostream& os, const SPTDijkstra<GCost, G> &spt) {
+  // Identify root vertex of the tree
+  // as the graph does not allow self referential nodes
+  // i.e. an edge from a node N to itself, we designate a root of the SPT
+  // tree by having it point to itself with cost 0 
+  // similarly: vertex exists in the tree when its cost to the 
+  // parent is not Infinity
+  GVertexId root_vid{kGMaxVertexId<GCost>()};
+  GCost tot_path{0};
+  GVertexId vid=0;
+  for (auto it = spt.cbegin(); it != spt.cend(); ++it, ++vid) {
+    if (vid == it->first) {
+      assert(it->second == 0);
+      root_vid = vid; // remember the root vertex
+    }
+    if (it->second >= kGInfinityCost<GCost>())
+      continue;
+    tot_path += it->second; // calculate the total cost of the MST
+  }
+  assert(root_vid != kGMaxVertexId<GCost>()); // tree must have a seed vertex
+
+  os << "#*******************************#" << std::endl;
+  os << "# SHORTEST PATH TREE OUTPUT     #" << std::endl;
+  os << "#-------------------------------#" << std::endl;
+  os << "# FORMAT:                       #" << std::endl;
+  os << "#+++++++++++++++++++++++++++++++#" << std::endl;
+  os << "# SPT Dijkstra root vertex: " << root_vid << " #" << std::endl;
+  os << "# SPT Total path cost: " << tot_path << "     #" << std::endl;
+  os << "#+++++++++++++++++++++++++++++++#" << std::endl;
+  os << "#= num_vertices                 #" << std::endl;
+  os << "#=== vid parent_vid path_cost   #" << std::endl;
+  os << "#################################" << std::endl;
+  os << spt.get_num_vertices() << std::endl;
+  
+  vid = 0;
+  for (auto it = spt.cbegin(); it != spt.cend(); ++it, ++vid) {
+    if ((vid == it->first) || (it->second >= kGInfinityCost<GCost>()))
+      continue;
+    os << vid << " " << it->first << " " << it->second << std::endl;
+  }
+  os << "#################################" << std::endl;
+  
+  os << "#*******************************#" << std::endl;
+
+  return os;
+}
+
 // Suppress implicit instantiation
 extern template std::ostream& 
 operator << <uint32_t>(std::ostream& os, const SPTDijkstra<uint32_t> &spt);
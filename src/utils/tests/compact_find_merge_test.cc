@@ -0,0 +1,167 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>    // std::min
+#include <chrono>       // std::chrono::...
+#include <exception>    // std::exception
+#include <iostream>     // std::cout
+#include <random>       // std::default_random_engine
+#include <stdexcept>    // std::out_of_range
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/compact_find_merge.h"
+#include "utils/find_merge.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_nodes);
+DECLARE_int32(num_edges);
+DECLARE_bool(auto_test);
+
+// Grows both find merges node by node while merging random edges and
+// validates the partition via single and batched finds
+template <typename Idx>
+static void RunTest(std::size_t num_nodes, uint32_t seed) {
+  num_nodes = std::min(num_nodes, CompactFindMerge<Idx>::MAX_NUM_NODES);
+  std::default_random_engine rnd_e{seed};
+
+  // Half the nodes exist upfront: the rest are added between merges
+  std::size_t init_nodes = (num_nodes + 1)/2;
+  FindMerge fm(init_nodes);
+  CompactFindMerge<Idx> cfm(init_nodes);
+  std::size_t num_edges = FLAGS_num_edges;
+  for (std::size_t i = 0; i < num_edges; ++i) {
+    if (cfm.get_num_nodes() < num_nodes && (i % 2) == 0) {
+      CHECK_EQ(fm.add_node(), cfm.add_node()) << "add_node mismatch";
+    }
+    std::uniform_int_distribution<std::size_t>
+        node_dis{0, cfm.get_num_nodes() - 1};
+    Idx n1 = node_dis(rnd_e), n2 = node_dis(rnd_e);
+    fm.merge_set(n1, n2);
+    cfm.merge_set(n1, n2);
+  }
+  while (cfm.get_num_nodes() < num_nodes)
+    CHECK_EQ(fm.add_node(), cfm.add_node()) << "add_node mismatch";
+  CHECK_EQ(fm.component_count(), cfm.get_num_sets()) << "# sets mismatch";
+
+  // Batched finds agree with single finds
+  std::vector<Idx> nodes(num_nodes), roots;
+  for (std::size_t idx = 0; idx < num_nodes; ++idx)
+    nodes[idx] = static_cast<Idx>(idx);
+  std::shuffle(nodes.begin(), nodes.end(), rnd_e);
+  std::chrono::time_point<std::chrono::steady_clock> start, end;
+  start = std::chrono::steady_clock::now();
+  cfm.find_set(nodes, &roots);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed_seconds = end - start;
+  const CompactFindMerge<Idx> &ccfm = cfm;
+  for (std::size_t i = 0; i < num_nodes; ++i)
+    CHECK_EQ(roots[i], ccfm.find_set(nodes[i]))
+        << "node " << nodes[i] << ": batched find mismatch";
+
+  // Both must agree on the partition: roots map one to one
+  std::vector<std::size_t> ref_to_cfm(num_nodes, num_nodes);
+  std::vector<std::size_t> cfm_to_ref(num_nodes, num_nodes);
+  for (std::size_t idx = 0; idx < num_nodes; ++idx) {
+    std::size_t ref_id = fm.find_set(idx);
+    std::size_t cfm_id = cfm.find_set(static_cast<Idx>(idx));
+    if (ref_to_cfm[ref_id] == num_nodes) {
+      CHECK_EQ(cfm_to_ref[cfm_id], num_nodes)
+          << "node " << idx << ": set " << cfm_id << " spans two sets";
+      ref_to_cfm[ref_id] = cfm_id;
+      cfm_to_ref[cfm_id] = ref_id;
+    }
+    CHECK_EQ(ref_to_cfm[ref_id], cfm_id)
+        << "node " << idx << ": set mismatch";
+  }
+
+  // Index type is full: no more nodes may be added
+  if (num_nodes == CompactFindMerge<Idx>::MAX_NUM_NODES) {
+    bool thrown = false;
+    try { cfm.add_node(); } catch (const std::out_of_range &e) {
+      thrown = true;
+    }
+    CHECK(thrown) << "add_node beyond max # nodes did not throw";
+  }
+
+  DLOG(INFO) << "Index bytes " << sizeof(Idx) << ": # nodes " << num_nodes
+             << ": # sets " << cfm.get_num_sets()
+             << ": batched find of all nodes in "
+             << elapsed_seconds.count() << " secs";
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "compact_find_merge_test called: "
+             << "num_nodes " << FLAGS_num_nodes
+             << ": num_edges " << FLAGS_num_edges;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    // Random edges: fixed seed when run from automated test scripts
+    uint32_t seed = FLAGS_auto_test ? 2014 : std::random_device{}();
+    RunTest<uint16_t>(FLAGS_num_nodes, seed);
+    RunTest<uint32_t>(FLAGS_num_nodes, seed);
+    RunTest<uint64_t>(FLAGS_num_nodes, seed);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_nodes, 100000,
+             "# of nodes over which the find merge algorithm is to run");
+static bool ValidateNumNodes(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_nodes_dummy = google::RegisterFlagValidator(&FLAGS_num_nodes,
+                                                &ValidateNumNodes);
+
+DEFINE_int32(num_edges, 80000,
+             "# of random edges merged");
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
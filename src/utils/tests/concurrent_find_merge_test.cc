@@ -0,0 +1,172 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <chrono>       // std::chrono::...
+#include <exception>    // std::exception
+#include <iostream>     // std::cout
+#include <random>       // std::default_random_engine
+#include <thread>       // std::thread
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/concurrent_find_merge.h"
+#include "utils/find_merge.h"
+#include "utils/init.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_nodes);
+DECLARE_int32(num_edges);
+DECLARE_int32(num_threads);
+DECLARE_bool(auto_test);
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "concurrent_find_merge_test called: "
+             << "num_nodes " << FLAGS_num_nodes
+             << ": num_edges " << FLAGS_num_edges
+             << ": num_threads " << FLAGS_num_threads;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    // Node indices beyond uint32_t parent words are rejected up front
+    bool rejected = false;
+    try {
+      ConcurrentFindMerge too_big(ConcurrentFindMerge::MAX_NUM_NODES + 1);
+    }
+    catch (const std::string s) {
+      rejected = true;
+    }
+    CHECK(rejected) << "# nodes > " << ConcurrentFindMerge::MAX_NUM_NODES
+                    << " accepted";
+
+    // Random edges: fixed seed when run from automated test scripts
+    uint32_t num_nodes = FLAGS_num_nodes;
+    uint32_t seed = FLAGS_auto_test ? 2014 : std::random_device{}();
+    std::default_random_engine rnd_e{seed};
+    std::uniform_int_distribution<uint32_t> node_dis{0, num_nodes - 1};
+    std::vector<std::pair<uint32_t, uint32_t>> edges(FLAGS_num_edges);
+    for (auto &edge : edges)
+      edge = std::make_pair(node_dis(rnd_e), node_dis(rnd_e));
+
+    // Reference: sequential find merge
+    FindMerge fm(num_nodes);
+    for (auto &edge : edges)
+      fm.merge_set(edge.first, edge.second);
+
+    // Every thread merges an interleaved slice of the edges
+    ConcurrentFindMerge cfm(num_nodes);
+    uint32_t num_threads = FLAGS_num_threads;
+    std::chrono::time_point<std::chrono::steady_clock> start, end;
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      workers.emplace_back([&cfm, &edges, t, num_threads]() {
+        for (std::size_t i = t; i < edges.size(); i += num_threads)
+          cfm.merge_set(edges[i].first, edges[i].second);
+      });
+    }
+    for (auto &w : workers)
+      w.join();
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    // Both must agree on the partition: roots map one to one
+    std::vector<uint32_t> ref_to_cfm(num_nodes, num_nodes);
+    std::vector<uint32_t> cfm_to_ref(num_nodes, num_nodes);
+    std::size_t num_sets = 0;
+    for (uint32_t idx = 0; idx < num_nodes; ++idx) {
+      uint32_t ref_id = fm.find_set(idx);
+      uint32_t cfm_id = cfm.find_set(idx);
+      if (ref_to_cfm[ref_id] == num_nodes) {
+        CHECK_EQ(cfm_to_ref[cfm_id], num_nodes)
+            << "node " << idx << ": set " << cfm_id << " spans two sets";
+        ref_to_cfm[ref_id] = cfm_id;
+        cfm_to_ref[cfm_id] = ref_id;
+        ++num_sets;
+      }
+      CHECK_EQ(ref_to_cfm[ref_id], cfm_id)
+          << "node " << idx << ": set mismatch";
+    }
+    CHECK_EQ(cfm.get_num_sets(), num_sets) << "# sets mismatch";
+    for (auto &edge : edges)
+      CHECK(cfm.same_set(edge.first, edge.second))
+          << "edge (" << edge.first << "," << edge.second << ") not merged";
+
+    DLOG(INFO) << "Parallel merge of " << edges.size() << " edges on "
+               << num_threads << " threads: " << num_sets << " sets in "
+               << elapsed_seconds.count() << " secs";
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_nodes, 100000,
+             "# of nodes over which the find merge algorithm is to run");
+static bool ValidateNumNodes(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_nodes_dummy = google::RegisterFlagValidator(&FLAGS_num_nodes,
+                                                &ValidateNumNodes);
+
+DEFINE_int32(num_edges, 80000,
+             "# of random edges merged in parallel");
+
+DEFINE_int32(num_threads, 4,
+             "# of threads merging edges in parallel");
+static bool ValidateNumThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_threads_dummy = google::RegisterFlagValidator(&FLAGS_num_threads,
+                                                  &ValidateNumThreads);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
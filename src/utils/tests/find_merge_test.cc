@@ -43,6 +43,24 @@ DECLARE_int32(num_nodes);
 DECLARE_int32(num_edges);
 DECLARE_string(edge_str);
 
+// Component API must agree with find_set on every node
+static void ValidateComponents(const FindMerge &fm, uint32_t num_nodes) {
+  std::size_t num_comps = 0, num_members = 0;
+  fm.for_each_component([&](uint32_t set_id,
+                            FindMerge::Components::Members members) {
+    CHECK_EQ(members.size(), fm.size_of(set_id))
+        << "Set ID " << set_id << ": size mismatch";
+    for (uint32_t idx : members)
+      CHECK_EQ(static_cast<uint32_t>(fm.find_set(idx)), set_id)
+          << "node " << idx << ": not in set " << set_id;
+    ++num_comps;
+    num_members += members.size();
+  });
+  CHECK_EQ(num_comps, fm.component_count()) << "# sets mismatch";
+  CHECK_EQ(num_members, num_nodes) << "# members mismatch";
+  return;
+}
+
 int main (int argc, char **argv)
 {
   Init::InitEnv(&argc, &argv);
@@ -82,10 +100,12 @@ int main (int argc, char **argv)
         fm.merge_set(edge.first, edge.second);
       }
     
+      ValidateComponents(fm, FLAGS_num_nodes);
       DLOG(INFO) << fm;
       fm.output_to_file(FLAGS_output_file);
     } else {
       FindMerge fm(FLAGS_input_file);
+      ValidateComponents(fm, fm.get_num_nodes());
       DLOG(INFO) << fm;
       fm.output_to_file(FLAGS_output_file);
     }
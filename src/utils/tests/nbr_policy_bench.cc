@@ -0,0 +1,250 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Benchmark: DFS from every vertex over Graph & eGraph by the library
+// vertex iterators (neighbor policy G::get_next_nbr).
+// Check: the iterators, a DFS calling G::get_next_nbr & consumers
+// instantiated on the graph type (MSTPrim, SPTDijkstra, output_graph)
+// see the same neighbors (eGraph: only vertices of matching attributes).
+// Graphs: Hex sized board (eGraph), 1000 vertices random (Graph, eGraph)
+
+// Standing C++ Headers
+#include <chrono>       // std::chrono::...
+#include <exception>    // std::exception
+#include <iomanip>      // std::setw
+#include <iostream>     // std::cout
+#include <random>       // std::default_random_engine
+#include <sstream>      // std::stringstream
+#include <string>       // std::string
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/egraph.h"
+#include "utils/graph.h"
+#include "utils/graph_iter.h"
+#include "utils/init.h"
+#include "utils/mst_prim.h"
+#include "utils/spt_dijkstra.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_iters);
+DECLARE_int32(dimension);
+DECLARE_int32(num_vertices);
+DECLARE_bool(auto_test);
+
+enum class Color {EMPTY=0, BLUE, RED};
+namespace hexgame { namespace utils {
+template <>
+struct eGraphAttrTraits<Color> {
+  constexpr static uint32_t NUM_VALUES = 3;
+  static inline uint32_t index(const Color &c) {
+    return static_cast<uint32_t>(c);
+  }
+};
+} } // namespace hexgame { namespace utils {
+
+// DFS from every vertex: returns # of vertices visited over all DFS
+template <typename NextNbr>
+static uint64_t AllDfs(uint32_t n, NextNbr next_nbr) {
+  uint64_t num_visited = 0;
+  std::vector<GVertexId> stack;
+  std::vector<bool> visited(n);
+  for (GVertexId src = 0; src < n; ++src) {
+    visited.assign(n, false);
+    visited[src] = true;
+    stack.push_back(src);
+    while (!stack.empty()) {
+      GVertexId vid = stack.back();
+      stack.pop_back();
+      ++num_visited;
+      for (GVertexId nbr = next_nbr(vid, 0); nbr < n;
+           nbr = next_nbr(vid, nbr + 1)) {
+        if (visited[nbr])
+          continue;
+        visited[nbr] = true;
+        stack.push_back(nbr);
+      }
+    }
+  }
+  return num_visited;
+}
+
+// Same via the library vertex iterator of G
+template <typename G>
+static uint64_t AllDfsIter(const G &g) {
+  uint64_t num_visited = 0;
+  auto it_end = g.vcend(GVertexIterType::DFS_ORDER);
+  for (GVertexId src = 0; src < g.get_num_vertices(); ++src)
+    for (auto it = g.vcbegin(GVertexIterType::DFS_ORDER, src);
+         it != it_end; ++it)
+      ++num_visited;
+  return num_visited;
+}
+
+// Vertices reached from vid (DFS by the vertex iterator of G)
+template <typename G>
+static uint32_t NumReached(const G &g, GVertexId vid) {
+  uint32_t num_reached = 0;
+  auto it_end = g.vcend(GVertexIterType::DFS_ORDER);
+  for (auto it = g.vcbegin(GVertexIterType::DFS_ORDER, vid);
+       it != it_end; ++it)
+    ++num_reached;
+  return num_reached;
+}
+
+// Vertices in the tree of vid: the root & vertices at finite cost
+static uint32_t NumInTree(const Tree<uint32_t> &t, GVertexId vid) {
+  uint32_t num_in_tree = 0;
+  GVertexId v = 0;
+  for (auto it = t.cbegin(); it != t.cend(); ++it, ++v)
+    if (v == vid || it->second < kGInfinityCost<uint32_t>())
+      ++num_in_tree;
+  return num_in_tree;
+}
+
+// MSTPrim, SPTDijkstra & output_graph instantiated on G walk the
+// neighbors of G::get_next_nbr
+template <typename G>
+static void ConsumerCheck(const std::string &name, const G &g) {
+  MSTPrim<uint32_t, G> mst(g);
+  CHECK_EQ(NumInTree(mst.get_tree(), 0), NumReached(g, 0))
+      << name << ": MST of vertex 0";
+  SPTDijkstra<uint32_t, G> spt(g);
+  CHECK_EQ(NumInTree(spt.get_tree(), 0), NumReached(g, 0))
+      << name << ": SPT of vertex 0";
+
+  uint32_t num_edges = 0;
+  for (GVertexId vid = 0; vid < g.get_num_vertices(); ++vid)
+    for (auto it = g.ecbegin(vid); it != g.ecend(vid); ++it)
+      ++num_edges;
+  std::stringstream ss;
+  ss << g;
+  uint32_t num_lines = 0;
+  for (std::string line; std::getline(ss, line); )
+    ++num_lines;
+  // 12 lines of header & trailer besides the edges
+  CHECK_EQ(num_lines, num_edges + 12) << name << ": edges output";
+
+  return;
+}
+
+template <typename Func>
+static double Time(uint32_t num_iters, uint64_t *num_visited_p, Func func) {
+  std::chrono::time_point<std::chrono::steady_clock> start, end;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < num_iters; ++i)
+    *num_visited_p = func();
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed_seconds = end - start;
+  return elapsed_seconds.count();
+}
+
+template <typename G>
+static void Bench(const std::string &name, const G &g, uint32_t num_iters) {
+  uint32_t n = g.get_num_vertices();
+  uint64_t iter_visited;
+  double iter_secs = Time(num_iters, &iter_visited, [&g]() {
+    return AllDfsIter(g);
+  });
+  uint64_t policy_visited = AllDfs(n, [&g](GVertexId vid, GVertexId nbr_vid) {
+    return g.get_next_nbr(vid, nbr_vid);
+  });
+
+  CHECK_EQ(iter_visited, policy_visited) << name << ": # visited";
+  ConsumerCheck(name, g);
+
+  std::cout << std::left << std::setw(24) << name
+            << ": # visited " << std::setw(10) << iter_visited
+            << ": iterator " << iter_secs << " secs" << std::endl;
+  return;
+}
+
+// Random attributes: BLUE or RED each with probability 1/2
+template <typename EG>
+static void ColorVertices(EG *g_p, std::default_random_engine *rnd_p) {
+  std::bernoulli_distribution coin(0.5);
+  for (GVertexId vid = 0; vid < g_p->get_num_vertices(); ++vid)
+    g_p->set_vertex_attr(vid, coin(*rnd_p) ? Color::BLUE : Color::RED);
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "nbr_policy_bench called: "
+             << "num_iters " << FLAGS_num_iters
+             << ": dimension " << FLAGS_dimension
+             << ": num_vertices " << FLAGS_num_vertices;
+
+  try {
+    uint32_t seed = FLAGS_auto_test ? 2014 : std::random_device{}();
+    std::default_random_engine rnd_e{seed};
+    uint32_t num_iters = FLAGS_num_iters;
+
+    // 1. Hex board: cell (r, c) connects to (r, c+1), (r+1, c), (r+1, c-1)
+    uint32_t dim = FLAGS_dimension;
+    eGraph<Color> hex_g(dim*dim);
+    for (uint32_t r = 0; r < dim; ++r) {
+      for (uint32_t c = 0; c < dim; ++c) {
+        if (c + 1 < dim)
+          hex_g.add_edge(dim*r + c, dim*r + c + 1);
+        if (r + 1 < dim)
+          hex_g.add_edge(dim*r + c, dim*(r + 1) + c);
+        if (r + 1 < dim && c > 0)
+          hex_g.add_edge(dim*r + c, dim*(r + 1) + c - 1);
+      }
+    }
+    ColorVertices(&hex_g, &rnd_e);
+    Bench("Hex eGraph " + std::to_string(dim) + "x" + std::to_string(dim),
+          hex_g, num_iters);
+
+    // 2. Random graphs: ~8 edges per vertex
+    uint32_t n = FLAGS_num_vertices;
+    double density = 8.0/n;
+    Graph<uint32_t> rnd_g(GEdgeType::UNDIRECTED, n, density, 1, 10,
+                          FLAGS_auto_test);
+    Bench("Graph " + std::to_string(n), rnd_g, num_iters);
+
+    eGraph<Color> rnd_eg(n);
+    std::uniform_int_distribution<GVertexId> vid_dis{0, n - 1};
+    for (uint32_t i = 0; i < 4*n; ++i)
+      rnd_eg.add_edge(vid_dis(rnd_e), vid_dis(rnd_e));
+    ColorVertices(&rnd_eg, &rnd_e);
+    Bench("eGraph " + std::to_string(n), rnd_eg, num_iters);
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_iters, 10, "# of times every benchmark is repeated");
+DEFINE_int32(dimension, 11, "dimension of the Hex board");
+DEFINE_int32(num_vertices, 1000, "# of vertices of the random graphs");
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
@@ -0,0 +1,192 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>    // std::shuffle, std::is_permutation
+#include <array>        // std::array
+#include <chrono>       // std::chrono::steady_clock
+#include <exception>    // std::exception
+#include <iostream>     // std::cout
+#include <numeric>      // std::iota
+#include <random>       // std::default_random_engine
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/init.h"
+#include "utils/random.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_draws);
+DECLARE_bool(auto_test);
+
+// Stream must match the reference xoshiro256** seeded by splitmix64
+static void SequenceTest(void) {
+  const std::array<uint64_t, 4> expected = {{
+      0xa7101bea9a74b250ULL, 0x6dec7a467f64d815ULL,
+      0xa0ca841cbaf2e257ULL, 0x98a5c9a93131ecccULL}};
+  FastRandom rnd(13607);
+  for (auto e : expected)
+    CHECK_EQ(rnd(), e) << "xoshiro256** stream mismatch";
+
+  // Same seed: same stream
+  FastRandom a(7), b(7);
+  for (uint32_t i = 0; i < 100; ++i)
+    CHECK_EQ(a(), b());
+
+  return;
+}
+
+// Every value of [0, range) is drawn with frequency close to 1/range
+static void BoundedTest(uint32_t num_draws) {
+  FastRandom rnd(1);
+  for (uint32_t range : {1U, 2U, 121U, (1U << 31) + 1, 0xffffffffU}) {
+    for (uint32_t i = 0; i < 1000; ++i)
+      CHECK_LT(rnd.get_bounded(range), range);
+  }
+
+  const uint32_t range = 7;
+  std::vector<uint32_t> counts(range, 0);
+  for (uint32_t i = 0; i < num_draws; ++i)
+    ++counts.at(rnd.get_bounded(range));
+  double expected = static_cast<double>(num_draws)/range;
+  for (uint32_t v = 0; v < range; ++v)
+    CHECK_NEAR(counts.at(v), expected, 0.05*expected)
+        << "value " << v << ": drawn " << counts.at(v) << " times";
+
+  return;
+}
+
+// Partial shuffle: [first, middle) uniformly drawn & the whole range
+// remains a permutation
+static void ShuffleTest(uint32_t num_draws) {
+  FastRandom rnd(2);
+  const uint32_t n = 5;
+  std::vector<uint32_t> init(n), v(n);
+  std::iota(init.begin(), init.end(), 0);
+
+  std::vector<uint32_t> counts(n, 0);
+  for (uint32_t i = 0; i < num_draws; ++i) {
+    v = init;
+    rnd.partial_shuffle(v.begin(), v.begin() + 1, v.end());
+    CHECK(std::is_permutation(v.begin(), v.end(), init.begin()));
+    ++counts.at(v.at(0));
+  }
+  double expected = static_cast<double>(num_draws)/n;
+  for (uint32_t e = 0; e < n; ++e)
+    CHECK_NEAR(counts.at(e), expected, 0.05*expected)
+        << "element " << e << ": drawn first " << counts.at(e) << " times";
+
+  // Nothing to draw: range left in place
+  v = init;
+  rnd.partial_shuffle(v.begin(), v.begin(), v.end());
+  CHECK(v == init) << "empty partial shuffle moved elements";
+
+  // Full shuffle: last element lands anywhere
+  std::fill(counts.begin(), counts.end(), 0);
+  for (uint32_t i = 0; i < num_draws; ++i) {
+    v = init;
+    rnd.shuffle(v.begin(), v.end());
+    CHECK(std::is_permutation(v.begin(), v.end(), init.begin()));
+    ++counts.at(std::find(v.begin(), v.end(), n - 1) - v.begin());
+  }
+  for (uint32_t p = 0; p < n; ++p)
+    CHECK_NEAR(counts.at(p), expected, 0.05*expected)
+        << "position " << p << ": held last " << counts.at(p) << " times";
+
+  return;
+}
+
+// Time of shuffles of a playout sized range: <random> vs FastRandom
+static void ShuffleBench(uint32_t num_draws) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<uint32_t> v(121);
+  std::iota(v.begin(), v.end(), 0);
+  uint32_t num_shuffles = num_draws/v.size() + 1;
+
+  std::default_random_engine rnd_e(3);
+  Clock::time_point start = Clock::now();
+  for (uint32_t i = 0; i < num_shuffles; ++i)
+    std::shuffle(v.begin(), v.end(), rnd_e);
+  std::chrono::duration<double, std::micro> std_time = Clock::now() - start;
+
+  FastRandom rnd(3);
+  start = Clock::now();
+  for (uint32_t i = 0; i < num_shuffles; ++i)
+    rnd.shuffle(v.begin(), v.end());
+  std::chrono::duration<double, std::micro> fast_time = Clock::now() - start;
+
+  DLOG(INFO) << num_shuffles << " shuffles of " << v.size() << " elements"
+             << ": std::shuffle " << std_time.count() << " usecs"
+             << ": FastRandom " << fast_time.count() << " usecs";
+  if (!FLAGS_auto_test)
+    std::cout << "shuffle: std " << std_time.count() << " usecs: fast "
+              << fast_time.count() << " usecs" << std::endl;
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "random_test called: num_draws " << FLAGS_num_draws;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    SequenceTest();
+    BoundedTest(FLAGS_num_draws);
+    ShuffleTest(FLAGS_num_draws);
+    ShuffleBench(FLAGS_num_draws);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_draws, 700000,
+             "# of random draws checked for uniformity");
+static bool ValidateNumDraws(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 10000) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=10000" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_draws_dummy = google::RegisterFlagValidator(&FLAGS_num_draws,
+                                                &ValidateNumDraws);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
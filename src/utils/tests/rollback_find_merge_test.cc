@@ -0,0 +1,181 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <exception>    // std::exception
+#include <iostream>     // std::cout
+#include <random>       // std::default_random_engine
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/find_merge.h"
+#include "utils/init.h"
+#include "utils/rollback_find_merge.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_nodes);
+DECLARE_int32(num_edges);
+DECLARE_int32(num_batches);
+DECLARE_bool(auto_test);
+
+using Edges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+// Partition of rfm must match the partition of the first num_edges edges
+static void Validate(const RollbackFindMerge &rfm, const Edges &edges,
+                     std::size_t num_edges) {
+  uint32_t num_nodes = rfm.get_num_nodes();
+  FindMerge fm(num_nodes);
+  for (std::size_t i = 0; i < num_edges; ++i)
+    fm.merge_set(edges[i].first, edges[i].second);
+
+  std::vector<uint32_t> ref_to_rfm(num_nodes, num_nodes);
+  std::vector<uint32_t> rfm_to_ref(num_nodes, num_nodes);
+  std::size_t num_sets = 0;
+  for (uint32_t idx = 0; idx < num_nodes; ++idx) {
+    uint32_t ref_id = fm.find_set(idx);
+    uint32_t rfm_id = rfm.find_set(idx);
+    if (ref_to_rfm[ref_id] == num_nodes) {
+      CHECK_EQ(rfm_to_ref[rfm_id], num_nodes)
+          << "node " << idx << ": set " << rfm_id << " spans two sets";
+      ref_to_rfm[ref_id] = rfm_id;
+      rfm_to_ref[rfm_id] = ref_id;
+      ++num_sets;
+    }
+    CHECK_EQ(ref_to_rfm[ref_id], rfm_id)
+        << "node " << idx << ": set mismatch";
+  }
+  CHECK_EQ(rfm.get_num_sets(), num_sets) << "# sets mismatch";
+
+  // sizes of all sets add up to the # of nodes
+  std::size_t total = 0;
+  for (uint32_t idx = 0; idx < num_nodes; ++idx)
+    if (static_cast<uint32_t>(rfm.find_set(idx)) == idx)
+      total += rfm.size_of(idx);
+  CHECK_EQ(total, num_nodes) << "set sizes do not add up";
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "rollback_find_merge_test called: "
+             << "num_nodes " << FLAGS_num_nodes
+             << ": num_edges " << FLAGS_num_edges
+             << ": num_batches " << FLAGS_num_batches;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    // Random edges: fixed seed when run from automated test scripts
+    uint32_t num_nodes = FLAGS_num_nodes;
+    uint32_t seed = FLAGS_auto_test ? 2014 : std::random_device{}();
+    std::default_random_engine rnd_e{seed};
+    std::uniform_int_distribution<uint32_t> node_dis{0, num_nodes - 1};
+    Edges edges(FLAGS_num_edges);
+    for (auto &edge : edges)
+      edge = std::make_pair(node_dis(rnd_e), node_dis(rnd_e));
+
+    // Merge the edges in batches: nested checkpoint before every batch
+    RollbackFindMerge rfm(num_nodes);
+    std::size_t batch_len = (edges.size() + FLAGS_num_batches - 1) /
+        FLAGS_num_batches;
+    std::vector<RollbackFindMerge::Checkpoint> cps;
+    std::vector<std::size_t> cp_edges;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+      if (i % batch_len == 0) {
+        cps.push_back(rfm.checkpoint());
+        cp_edges.push_back(i);
+      }
+      rfm.merge_set(edges[i].first, edges[i].second);
+    }
+    Validate(rfm, edges, edges.size());
+
+    // Undo the batches innermost first: redo the last batch once to
+    // check that a rolled back state can be built upon again
+    for (std::size_t b = cps.size(); b-- > 0; ) {
+      rfm.rollback(cps.at(b));
+      Validate(rfm, edges, cp_edges.at(b));
+      if (b + 1 == cps.size()) {
+        for (std::size_t i = cp_edges.at(b); i < edges.size(); ++i)
+          rfm.merge_set(edges[i].first, edges[i].second);
+        Validate(rfm, edges, edges.size());
+        rfm.rollback(cps.at(b));
+      }
+    }
+    CHECK_EQ(rfm.get_num_sets(), num_nodes) << "rollback to empty failed";
+
+    DLOG(INFO) << "Rolled back " << edges.size() << " edges over "
+               << cps.size() << " checkpoints";
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_nodes, 1000,
+             "# of nodes over which the find merge algorithm is to run");
+static bool ValidateNumNodes(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_nodes_dummy = google::RegisterFlagValidator(&FLAGS_num_nodes,
+                                                &ValidateNumNodes);
+
+DEFINE_int32(num_edges, 2000,
+             "# of random edges merged");
+
+DEFINE_int32(num_batches, 10,
+             "# of checkpoints taken while merging the edges");
+static bool ValidateNumBatches(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_batches_dummy = google::RegisterFlagValidator(&FLAGS_num_batches,
+                                                  &ValidateNumBatches);
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
@@ -0,0 +1,248 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <algorithm>    // std::max
+#include <exception>    // std::exception
+#include <fstream>      // std::ofstream
+#include <iostream>     // std::cout
+#include <string>       // std::string
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/init.h"
+#include "utils/mst_prim.h"
+#include "utils/spt_dijkstra.h"
+#include "utils/tree_index.h"
+#include "utils/tree_layout.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_string(input_file);
+DECLARE_string(output_file);
+DECLARE_int32(root_vertex_id);
+DECLARE_bool(auto_test);
+
+using GCost=uint32_t;
+
+// Reference answers computed by walking parents one vertex at a time
+class TreeWalker {
+ public:
+  explicit TreeWalker(const Tree<GCost> &t) : _t(t) {}
+  GVertexId parent(GVertexId vid) const {
+    TreeElem<GCost> e = _t.at(vid);
+    if (e.first == vid || e.second >= kGInfinityCost<GCost>())
+      return vid;
+    return e.first;
+  }
+  uint32_t depth(GVertexId vid) const {
+    uint32_t d = 0;
+    for (; parent(vid) != vid; vid = parent(vid), ++d);
+    return d;
+  }
+  // lca, path cost & max edge cost of the path between vid1 and vid2
+  GVertexId walk(GVertexId vid1, GVertexId vid2,
+                 GCost &path_cost, GCost &max_cost) const {
+    const Graph<GCost> &g = _t.get_graph();
+    uint32_t d1 = depth(vid1), d2 = depth(vid2);
+    path_cost = max_cost = 0;
+    while (d1 > d2 || d2 > d1 || vid1 != vid2) {
+      GVertexId &vid = (d1 >= d2) ? vid1 : vid2;
+      uint32_t  &d   = (d1 >= d2) ? d1 : d2;
+      if (parent(vid) == vid) {
+        path_cost = max_cost = kGInfinityCost<GCost>();
+        return kGMaxVertexId<GCost>();
+      }
+      GCost c = g.get_edge_value(parent(vid), vid);
+      path_cost += c;
+      max_cost = std::max(max_cost, c);
+      vid = parent(vid);
+      --d;
+    }
+    return vid1;
+  }
+  // true when vid1 is an ancestor of (or same as) vid2
+  bool is_ancestor(GVertexId vid1, GVertexId vid2) const {
+    for (; vid2 != vid1 && parent(vid2) != vid2; vid2 = parent(vid2));
+    return (vid1 == vid2);
+  }
+ private:
+  const Tree<GCost> &_t;
+};
+
+// Validate every vertex pair of the index against the walker
+static uint32_t ValidateIndex(const std::string &name,
+                              const Tree<GCost> &t,
+                              std::ofstream &op) {
+  TreeIndex<GCost> idx(t);
+  TreeWalker walker(t);
+  uint32_t n = t.get_num_vertices(), num_pairs = 0;
+
+  op << "-------- " << name << " --------" << std::endl;
+  for (GVertexId v1 = 0; v1 < n; ++v1) {
+    CHECK_EQ(idx.get_depth(v1), walker.depth(v1))
+        << name << ": depth mismatch for vertex " << v1;
+    for (GVertexId v2 = 0; v2 < n; ++v2, ++num_pairs) {
+      GCost path_cost, max_cost;
+      GVertexId lca = walker.walk(v1, v2, path_cost, max_cost);
+      CHECK_EQ(idx.get_lca(v1, v2), lca)
+          << name << ": lca mismatch for (" << v1 << "," << v2 << ")";
+      CHECK_EQ(idx.get_path_cost(v1, v2), path_cost)
+          << name << ": path cost mismatch for (" << v1 << "," << v2 << ")";
+      CHECK_EQ(idx.get_max_edge_cost(v1, v2), max_cost)
+          << name << ": max edge mismatch for (" << v1 << "," << v2 << ")";
+      if (v1 < v2 && lca != kGMaxVertexId<GCost>())
+        op << v1 << " " << v2 << " lca " << lca
+           << " cost " << path_cost << " max " << max_cost << std::endl;
+    }
+    CHECK_EQ(idx.get_ancestor(v1, idx.get_depth(v1)), idx.get_root(v1))
+        << name << ": root mismatch for vertex " << v1;
+  }
+
+  return num_pairs;
+}
+
+// Validate children & subtree aggregates of the layout against the walker
+static void ValidateLayout(const std::string &name,
+                           const Tree<GCost> &t) {
+  TreeLayout<GCost> tl(t);
+  TreeWalker walker(t);
+  const Graph<GCost> &g = t.get_graph();
+  uint32_t n = t.get_num_vertices();
+  std::vector<uint64_t> vval(n);
+  for (GVertexId vid = 0; vid < n; ++vid)
+    vval[vid] = vid + 1;
+  std::vector<uint64_t> pfx = tl.get_prefix_sums(vval);
+
+  for (GVertexId v1 = 0; v1 < n; ++v1) {
+    uint32_t size = 0, num_children = 0;
+    GCost cost = 0;
+    uint64_t sum = 0;
+    for (GVertexId v2 = 0; v2 < n; ++v2) {
+      if (walker.parent(v2) == v1 && v2 != v1)
+        ++num_children;
+      if (walker.is_ancestor(v1, v2) == false)
+        continue;
+      CHECK(tl.is_ancestor(v1, v2))
+          << name << ": ancestor mismatch for (" << v1 << "," << v2 << ")";
+      ++size;
+      sum += vval[v2];
+      if (v2 != v1)
+        cost += g.get_edge_value(walker.parent(v2), v2);
+    }
+    CHECK_EQ(tl.get_subtree_size(v1), size)
+        << name << ": subtree size mismatch for vertex " << v1;
+    CHECK_EQ(tl.get_subtree_cost(v1), cost)
+        << name << ": subtree cost mismatch for vertex " << v1;
+    CHECK_EQ(tl.get_subtree_sum(v1, pfx), sum)
+        << name << ": subtree sum mismatch for vertex " << v1;
+    CHECK_EQ(tl.get_num_children(v1), num_children)
+        << name << ": # children mismatch for vertex " << v1;
+    for (auto it = tl.cbegin_children(v1); it != tl.cend_children(v1); ++it)
+      CHECK_EQ(walker.parent(*it), v1)
+          << name << ": child " << *it << " of vertex " << v1 << " mismatch";
+  }
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  std::string pgm = "/tree_index_test-op.txt";
+  std::string output_file;
+  if (FLAGS_output_file.empty() == false)
+    output_file = FLAGS_output_file;
+  else if (FLAGS_auto_test == true)
+    output_file = std::string(argv[0]) + "-op.txt";
+  else if (FLAGS_log_dir.empty() == false)
+    output_file = FLAGS_log_dir + pgm;
+  else
+    output_file = "." + pgm;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    std::ofstream op;
+    op.open(output_file, std::ios::out);
+    if (!op) {
+      ostringstream oss;
+      oss << "Can't open output file " << output_file;
+      throw oss.str();
+    }
+
+    Graph<GCost> g(FLAGS_input_file);
+    DLOG(INFO) << g << std::endl;
+    GVertexId root_vid =
+        static_cast<uint32_t>(FLAGS_root_vertex_id) < g.get_num_vertices() ?
+        FLAGS_root_vertex_id : 0;
+
+    MSTPrim<GCost> mst(g);
+    SPTDijkstra<GCost> spt(g);
+    spt.run_spt_dijkstra(root_vid);
+
+    uint32_t num_pairs = ValidateIndex("MST", mst.get_tree(), op);
+    num_pairs += ValidateIndex("SPT", spt.get_tree(), op);
+    ValidateLayout("MST", mst.get_tree());
+    ValidateLayout("SPT", spt.get_tree());
+    DLOG(INFO) << "Validated " << num_pairs << " vertex pairs";
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_string(input_file, "data/input.txt",
+              "Input file with graph input data");
+static bool ValidateInputFile(const char* flagname, const std::string& file_name) {
+  std::string s(flagname);
+  std::ifstream ip;
+  ip.open(file_name, std::ios::in);
+  if (!ip) {
+    std::string s(flagname);
+    std::cerr << "Invalid value for --" << s << ": " << file_name << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+string_dummy = google::RegisterFlagValidator(&FLAGS_input_file,
+                                             &ValidateInputFile);
+
+DEFINE_string(output_file, "",
+              "Output file to store tree path queries");
+
+DEFINE_int32(root_vertex_id, 0,
+             "root vertex of the shortest path tree");
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
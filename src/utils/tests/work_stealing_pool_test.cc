@@ -0,0 +1,166 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standing C++ Headers
+#include <atomic>       // std::atomic
+#include <exception>    // std::exception
+#include <future>       // std::future
+#include <iostream>     // std::cout
+#include <stdexcept>    // std::out_of_range
+#include <vector>       // std::vector
+// Standing C Headers
+#include <cstdlib>      // std::exit std::EXIT_FAILURE
+// Google Headers
+#include <gflags/gflags.h>  // Parse command line args and flags
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/init.h"
+#include "utils/work_stealing_pool.h"
+
+using namespace hexgame;
+using namespace hexgame::utils;
+using namespace std;
+
+// Flag Declarations
+DECLARE_int32(num_threads);
+DECLARE_int32(num_tasks);
+DECLARE_bool(auto_test);
+
+// Sum of [first, last) forked in halves down to grain: every task waits
+// for the half it forked
+static uint64_t Sum(WorkStealingPool *pool_p, uint64_t first, uint64_t last) {
+  const uint64_t grain = 64;
+  if (last - first <= grain) {
+    uint64_t sum = 0;
+    for (uint64_t i = first; i < last; ++i)
+      sum += i;
+    return sum;
+  }
+  uint64_t mid = first + (last - first)/2;
+  std::future<uint64_t> left = pool_p->submit([pool_p, first, mid]() {
+      return Sum(pool_p, first, mid);
+    });
+  uint64_t right = Sum(pool_p, mid, last);
+  return pool_p->get(left) + right;
+}
+
+// Tasks forking tasks complete on any # of threads: a waiting worker runs
+// the tasks it forked
+static void ForkJoinTest(uint32_t num_threads, uint64_t num_values) {
+  WorkStealingPool pool(num_threads);
+  std::future<uint64_t> sum = pool.submit([&pool, num_values]() {
+      return Sum(&pool, 0, num_values);
+    });
+  CHECK_EQ(pool.get(sum), num_values*(num_values - 1)/2)
+      << num_threads << " threads: bad sum";
+
+  DLOG(INFO) << num_threads << " threads: fork join of " << num_values
+             << " values: # steals " << pool.get_num_steals();
+  if (!FLAGS_auto_test)
+    std::cout << num_threads << " threads: fork join of " << num_values
+              << " values: # steals " << pool.get_num_steals() << std::endl;
+
+  return;
+}
+
+int main(int argc, char **argv) {
+  Init::InitEnv(&argc, &argv);
+
+  DLOG(INFO) << "work_stealing_pool_test called: "
+             << "num_threads " << FLAGS_num_threads
+             << ": num_tasks " << FLAGS_num_tasks;
+
+  try {
+    DLOG(INFO) << "Test Program Begins: ..." << std::endl
+               << "------------------------" << std::endl;
+
+    std::atomic<uint32_t> num_run{0};
+    {
+      WorkStealingPool pool(FLAGS_num_threads);
+      CHECK_EQ(pool.get_num_threads(),
+               static_cast<uint32_t>(FLAGS_num_threads));
+
+      // Every task returns its square: results arrive via the futures
+      std::vector<std::future<uint64_t>> results;
+      for (int32_t i = 0; i < FLAGS_num_tasks; ++i) {
+        results.push_back(pool.submit([i, &num_run]() {
+              ++num_run;
+              return static_cast<uint64_t>(i)*i;
+            }));
+      }
+      for (int32_t i = 0; i < FLAGS_num_tasks; ++i)
+        CHECK_EQ(pool.get(results.at(i)), static_cast<uint64_t>(i)*i)
+            << "task " << i << ": bad result";
+
+      // Exception of a task is rethrown by its future
+      std::future<uint32_t> fail = pool.submit([]() -> uint32_t {
+          throw std::out_of_range("task failed");
+        });
+      bool caught = false;
+      try {
+        pool.get(fail);
+      } catch (const std::out_of_range &e) {
+        caught = true;
+      }
+      CHECK(caught) << "exception of task not propagated";
+
+      // Tasks pending at destruction are completed before workers join:
+      // including the tasks they fork
+      for (int32_t i = 0; i < FLAGS_num_tasks; ++i) {
+        pool.submit([&pool, &num_run]() {
+            pool.submit([&num_run]() { ++num_run; });
+          });
+      }
+    }
+    CHECK_EQ(num_run.load(), 2*static_cast<uint32_t>(FLAGS_num_tasks))
+        << "pending tasks dropped";
+
+    ForkJoinTest(1, 64*FLAGS_num_tasks);
+    ForkJoinTest(FLAGS_num_threads, 64*FLAGS_num_tasks);
+
+    DLOG(INFO) << "Test Program Ends: ..." << std::endl
+               << "************************" << std::endl;
+  }
+  catch (const std::string s) {
+    std::cerr << "Exception caught: " << s << std::endl;
+  }
+  catch (std::exception e) {
+    std::cerr << "Exception caught: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+DEFINE_int32(num_threads, 4,
+             "# of threads of the pool");
+static bool ValidateNumThreads(const char* flagname, int32_t num) {
+  std::string s(flagname);
+  if (num < 1) {
+    std::cerr << "Invalid value for --" << s << ": " << num
+              << ": should be >=1" << std::endl;
+    return false;
+  }
+  return true;
+}
+static const bool
+num_threads_dummy = google::RegisterFlagValidator(&FLAGS_num_threads,
+                                                  &ValidateNumThreads);
+
+DEFINE_int32(num_tasks, 1000,
+             "# of tasks submitted to the pool");
+
+DEFINE_bool(auto_test, false,
+            "test run programmatically (when true) or manually (when false)");
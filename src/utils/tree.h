@@ -69,6 +69,18 @@ class Tree {
   // return number of vertices in the tree
   inline uint32_t get_num_vertices() const { return _g.get_num_vertices(); }
 
+  // return the graph on which the tree is referenced
+  inline const Graph<GCost>& get_graph() const { return _g; }
+
+  // return parent of vid: a root of the tree points to itself. Vertices
+  // not reachable from the root (infinite cost) are treated as roots too.
+  inline GVertexId get_parent(GVertexId vid) const {
+    const TreeElem<GCost> &e = _v.at(vid);
+    if ((e.first >= _v.size()) || (e.second >= kGInfinityCost<GCost>()))
+      return vid;
+    return e.first;
+  }
+
   //   Dumps the state of the tree in file_name
   void output_to_file(std::string file_name);
 
@@ -0,0 +1,217 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <algorithm>        // std::max
+#include <exception>        // throw
+#include <iostream>
+#include <sstream>          // std::stringstream
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/graph.h"
+#include "utils/tree.h"
+#include "utils/tree_index.h"
+
+using namespace std;
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Builds the index over tree t: O(V log V) time and space
+template <typename GCost>
+TreeIndex<GCost>::TreeIndex(const Tree<GCost> &t) :
+    _num_vertices{t.get_num_vertices()}, _num_levels{1},
+    _root(_num_vertices), _depth(_num_vertices, 0),
+    _cost(_num_vertices, 0) {
+  const Graph<GCost> &g = t.get_graph();
+  const uint32_t n = _num_vertices;
+  while ((1U << (_num_levels - 1)) < n)
+    ++_num_levels;
+  _up.resize(static_cast<size_t>(_num_levels)*n);
+  _max.resize(static_cast<size_t>(_num_levels)*n, 0);
+
+  // 1. Level 0 of the lifting table: immediate parent & the edge cost.
+  //    The root of a tree points to itself. Vertices not reachable from
+  //    the root (infinite cost) are designated roots of their own tree.
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    GVertexId par = t.get_parent(vid);
+    _up[lpos(0, vid)] = par;
+    if (par == vid)
+      continue;
+    GCost ecost = g.get_edge_value(par, vid);
+    assert(ecost < kGInfinityCost<GCost>());
+    _max[lpos(0, vid)] = ecost;
+  }
+
+  // 2. Visit vertices parents first (BFS from every root) to compute the
+  //    root, depth, and root path cost of each vertex.
+  //    Children are bucketed by parent (counting sort) to avoid per vertex
+  //    allocation of child lists.
+  vector<uint32_t> off(n + 1, 0);
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    if (_up[lpos(0, vid)] != vid)
+      ++off[_up[lpos(0, vid)] + 1];
+  }
+  for (GVertexId vid = 0; vid < n; ++vid)
+    off[vid + 1] += off[vid];
+  vector<GVertexId> child(off[n]);
+  vector<uint32_t> fill(off.begin(), off.end() - 1);
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    GVertexId par = _up[lpos(0, vid)];
+    if (par != vid)
+      child[fill[par]++] = vid;
+  }
+
+  vector<GVertexId> q;
+  q.reserve(n);
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    if (_up[lpos(0, vid)] != vid)
+      continue;
+    _root[vid] = vid;
+    q.push_back(vid);
+  }
+  for (size_t i = 0; i < q.size(); ++i) {
+    GVertexId par = q[i];
+    for (uint32_t j = off[par]; j < off[par + 1]; ++j) {
+      GVertexId vid = child[j];
+      _root[vid]  = _root[par];
+      _depth[vid] = _depth[par] + 1;
+      _cost[vid]  = _cost[par] + _max[lpos(0, vid)];
+      q.push_back(vid);
+    }
+  }
+  // Parent pointers that do not lead to a root imply a loop in the tree
+  if (q.size() != n) {
+    ostringstream oss;
+    oss << "TreeIndex: tree has a loop: " << n - q.size()
+        << " of " << n << " vertices do not lead to a root";
+    throw oss.str();
+  }
+
+  // 3. Level k: 2^k(th) ancestor is the 2^(k-1)(th) ancestor of the
+  //    2^(k-1)(th) ancestor. The max edge cost is the larger of the two.
+  for (uint32_t k = 1; k < _num_levels; ++k) {
+    for (GVertexId vid = 0; vid < n; ++vid) {
+      GVertexId mid = _up[lpos(k-1, vid)];
+      _up[lpos(k, vid)] = _up[lpos(k-1, mid)];
+      _max[lpos(k, vid)] = std::max(_max[lpos(k-1, vid)],
+                                    _max[lpos(k-1, mid)]);
+    }
+  }
+
+  DLOG(INFO) << "TreeIndex: # vertices " << n
+             << ": # levels " << _num_levels;
+
+  return;
+}
+
+// k(th) ancestor of vid: root of the tree when k >= depth of vid
+template <typename GCost>
+GVertexId TreeIndex<GCost>::get_ancestor(GVertexId vid, uint32_t k) const {
+  assert(vid < _num_vertices);
+  if (k >= _depth[vid])
+    return _root[vid];
+  for (uint32_t level = 0; k != 0; ++level, k >>= 1) {
+    if (k & 1)
+      vid = _up[lpos(level, vid)];
+  }
+  return vid;
+}
+
+// lift vid1 and vid2 up to their lowest common ancestor
+// return: lca and max edge cost along both paths (max_cost)
+template <typename GCost>
+GVertexId TreeIndex<GCost>::lift(GVertexId vid1, GVertexId vid2,
+                                 GCost &max_cost) const {
+  assert(vid1 < _num_vertices && vid2 < _num_vertices);
+  max_cost = 0;
+  if (_root[vid1] != _root[vid2]) {
+    max_cost = kGInfinityCost<GCost>();
+    return kGMaxVertexId<GCost>();
+  }
+
+  // 1. Bring the deeper of the two vertices to the same depth
+  if (_depth[vid1] < _depth[vid2])
+    std::swap(vid1, vid2);
+  uint32_t diff = _depth[vid1] - _depth[vid2];
+  for (uint32_t level = 0; diff != 0; ++level, diff >>= 1) {
+    if ((diff & 1) == 0)
+      continue;
+    max_cost = std::max(max_cost, _max[lpos(level, vid1)]);
+    vid1 = _up[lpos(level, vid1)];
+  }
+  if (vid1 == vid2)
+    return vid1;
+
+  // 2. Jump both vertices as far up as possible without meeting:
+  //    their parents is then the lowest common ancestor
+  for (uint32_t level = _num_levels; level-- > 0;) {
+    GVertexId up1 = _up[lpos(level, vid1)];
+    GVertexId up2 = _up[lpos(level, vid2)];
+    if (up1 == up2)
+      continue;
+    max_cost = std::max(max_cost, std::max(_max[lpos(level, vid1)],
+                                           _max[lpos(level, vid2)]));
+    vid1 = up1;
+    vid2 = up2;
+  }
+  max_cost = std::max(max_cost, std::max(_max[lpos(0, vid1)],
+                                         _max[lpos(0, vid2)]));
+  return _up[lpos(0, vid1)];
+}
+
+// lowest common ancestor of vid1 and vid2
+template <typename GCost>
+GVertexId TreeIndex<GCost>::get_lca(GVertexId vid1, GVertexId vid2) const {
+  GCost max_cost;
+  return lift(vid1, vid2, max_cost);
+}
+
+// # of edges on the tree path between vid1 and vid2
+template <typename GCost>
+uint32_t TreeIndex<GCost>::get_path_len(GVertexId vid1, GVertexId vid2) const {
+  GVertexId lca = get_lca(vid1, vid2);
+  if (lca == kGMaxVertexId<GCost>())
+    return kGMaxVertexId<GCost>();
+  return _depth[vid1] + _depth[vid2] - 2*_depth[lca];
+}
+
+// total edge cost on the tree path between vid1 and vid2
+template <typename GCost>
+GCost TreeIndex<GCost>::get_path_cost(GVertexId vid1, GVertexId vid2) const {
+  GVertexId lca = get_lca(vid1, vid2);
+  if (lca == kGMaxVertexId<GCost>())
+    return kGInfinityCost<GCost>();
+  return _cost[vid1] + _cost[vid2] - 2*_cost[lca];
+}
+
+// maximum edge cost on the tree path between vid1 and vid2
+template <typename GCost>
+GCost TreeIndex<GCost>::get_max_edge_cost(GVertexId vid1,
+                                          GVertexId vid2) const {
+  GCost max_cost;
+  lift(vid1, vid2, max_cost);
+  return max_cost;
+}
+
+// Trigger instantiation
+template class TreeIndex<uint32_t>;
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
@@ -0,0 +1,145 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+//
+// Class TreeIndex:
+// DESCRIPTION:
+//   Path query index built once over a Tree (MST, SPT, ...). The tree only
+//   stores a parent pointer per vertex, so every path question would
+//   otherwise walk parents one vertex at a time. The index uses binary
+//   lifting: for every vertex v and level k it remembers the 2^k-th
+//   ancestor of v and the maximum edge cost on that stretch of the path.
+//   Answers lowest common ancestor, depth, path cost, and maximum edge
+//   cost (bottleneck) queries in O(log V).
+//
+//   The tree may be a forest: vertices that are not reachable (cost
+//   infinity in the tree) become roots of their own single vertex tree.
+//   Queries between vertices of different trees report kGMaxVertexId
+//   (lca) or kGInfinityCost (costs).
+//
+//   Edge costs are always read from the graph the tree is referenced on:
+//   MST stores the edge cost in the tree while SPT stores the path cost.
+//
+// EXAMPLE USAGE:
+//   MSTPrim<uint32_t> mst(g);
+//   TreeIndex<uint32_t> idx(mst.get_tree());
+//   idx.get_lca(v1, v2), idx.get_path_cost(v1, v2),
+//   idx.get_max_edge_cost(v1, v2)
+
+#ifndef _TREE_INDEX_H_
+#define _TREE_INDEX_H_
+
+// Standard C++ Headers
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+// Standard C Headers
+#include <cassert>      // assert
+// Local Headers
+#include "utils/graph.h"
+#include "utils/tree.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+template <typename GCost>
+class TreeIndex {
+ public:
+  // Contructors
+  //     Builds the index over tree t: O(V log V) time and space
+  explicit TreeIndex(const Tree<GCost> &t);
+
+  // Destructor
+  ~TreeIndex() {}
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  TreeIndex(const TreeIndex &) = delete;
+  TreeIndex(TreeIndex &&) = delete; // C++11 only
+  void operator=(const TreeIndex &) = delete;
+  void operator=(TreeIndex &&) = delete; // C++11 only
+
+  // METHODS:
+  // return number of vertices in the index
+  inline uint32_t get_num_vertices() const { return _num_vertices; }
+
+  // root of the tree that contains vid
+  inline GVertexId get_root(GVertexId vid) const {
+    assert(vid < _num_vertices);
+    return _root[vid];
+  }
+
+  // # of edges from root of the tree to vid
+  inline uint32_t get_depth(GVertexId vid) const {
+    assert(vid < _num_vertices);
+    return _depth[vid];
+  }
+
+  // total edge cost on the path from root of the tree to vid
+  inline GCost get_root_path_cost(GVertexId vid) const {
+    assert(vid < _num_vertices);
+    return _cost[vid];
+  }
+
+  // k(th) ancestor of vid: root of the tree when k >= depth of vid
+  GVertexId get_ancestor(GVertexId vid, uint32_t k) const;
+
+  // lowest common ancestor of vid1 and vid2
+  // return: kGMaxVertexId when vid1 and vid2 are in different trees
+  GVertexId get_lca(GVertexId vid1, GVertexId vid2) const;
+
+  // # of edges on the tree path between vid1 and vid2
+  // return: kGMaxVertexId when vid1 and vid2 are in different trees
+  uint32_t get_path_len(GVertexId vid1, GVertexId vid2) const;
+
+  // total edge cost on the tree path between vid1 and vid2
+  // return: kGInfinityCost when vid1 and vid2 are in different trees
+  GCost get_path_cost(GVertexId vid1, GVertexId vid2) const;
+
+  // maximum edge cost on the tree path between vid1 and vid2: 0 if vid1==vid2
+  // return: kGInfinityCost when vid1 and vid2 are in different trees
+  GCost get_max_edge_cost(GVertexId vid1, GVertexId vid2) const;
+
+ protected:
+ private:
+  uint32_t _num_vertices;
+  // # of levels of the binary lifting table: 2^(_num_levels-1) >= V
+  uint32_t _num_levels;
+  // root of the tree containing the vertex
+  std::vector<GVertexId> _root;
+  // # edges from root to the vertex
+  std::vector<uint32_t>  _depth;
+  // total edge cost from root to the vertex
+  std::vector<GCost>     _cost;
+  // Binary Lifting Tables: flattened [level][vid] i.e. idx = level*V + vid
+  // _up: 2^level(th) ancestor of vid (root points to itself)
+  // _max: max edge cost on path from vid to its 2^level(th) ancestor
+  std::vector<GVertexId> _up;
+  std::vector<GCost>     _max;
+
+  inline std::size_t lpos(uint32_t level, GVertexId vid) const {
+    return static_cast<std::size_t>(level)*_num_vertices + vid;
+  }
+  // lift vid1 and vid2 up to their lowest common ancestor
+  // return: lca and max edge cost along both paths (max_cost)
+  GVertexId lift(GVertexId vid1, GVertexId vid2, GCost &max_cost) const;
+};
+
+// Suppress implicit instantiation
+extern template class TreeIndex<uint32_t>;
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _TREE_INDEX_H_
@@ -0,0 +1,117 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <exception>        // throw
+#include <iostream>
+#include <sstream>          // std::stringstream
+#include <vector>           // std::vector
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/graph.h"
+#include "utils/tree.h"
+#include "utils/tree_layout.h"
+
+using namespace std;
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Lays out tree t: O(V) time and space
+template <typename GCost>
+TreeLayout<GCost>::TreeLayout(const Tree<GCost> &t) :
+    _pos(t.get_num_vertices()), _size(t.get_num_vertices(), 1),
+    _child_off(t.get_num_vertices() + 1, 0),
+    _cost_pfx(t.get_num_vertices() + 1, 0) {
+  const Graph<GCost> &g = t.get_graph();
+  const uint32_t n = t.get_num_vertices();
+
+  // 1. Bucket children by parent vid (counting sort): children of a
+  //    vertex end up in vid order
+  vector<GVertexId> par(n);
+  vector<uint32_t> off(n + 1, 0);
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    par[vid] = t.get_parent(vid);
+    if (par[vid] != vid)
+      ++off[par[vid] + 1];
+  }
+  for (GVertexId vid = 0; vid < n; ++vid)
+    off[vid + 1] += off[vid];
+  vector<GVertexId> child(off[n]);
+  vector<uint32_t> fill(off.begin(), off.end() - 1);
+  for (GVertexId vid = 0; vid < n; ++vid) {
+    if (par[vid] != vid)
+      child[fill[par[vid]]++] = vid;
+  }
+
+  // 2. DFS pre-order from every root (roots in vid order). Children are
+  //    pushed in reverse so that they pop in vid order.
+  _order.reserve(n);
+  vector<GVertexId> stk;
+  for (GVertexId root = 0; root < n; ++root) {
+    if (par[root] != root)
+      continue;
+    stk.push_back(root);
+    while (stk.empty() == false) {
+      GVertexId vid = stk.back();
+      stk.pop_back();
+      _pos[vid] = _order.size();
+      _order.push_back(vid);
+      for (uint32_t j = off[vid + 1]; j-- > off[vid];)
+        stk.push_back(child[j]);
+    }
+  }
+  // Parent pointers that do not lead to a root imply a loop in the tree
+  if (_order.size() != n) {
+    ostringstream oss;
+    oss << "TreeLayout: tree has a loop: " << n - _order.size()
+        << " of " << n << " vertices do not lead to a root";
+    throw oss.str();
+  }
+
+  // 3. Subtree sizes: children appear after parents in pre-order, so a
+  //    reverse sweep accumulates each subtree into its parent
+  for (uint32_t p = n; p-- > 0;) {
+    GVertexId vid = _order[p];
+    if (par[vid] != vid)
+      _size[_pos[par[vid]]] += _size[p];
+  }
+
+  // 4. CSR children & edge cost prefix sums with rows in pre-order
+  _child.reserve(child.size());
+  for (uint32_t p = 0; p < n; ++p) {
+    GVertexId vid = _order[p];
+    _child.insert(_child.end(),
+                  child.begin() + off[vid], child.begin() + off[vid + 1]);
+    _child_off[p + 1] = _child.size();
+    GCost ecost = (par[vid] == vid) ? 0 : g.get_edge_value(par[vid], vid);
+    assert(ecost < kGInfinityCost<GCost>());
+    _cost_pfx[p + 1] = _cost_pfx[p] + ecost;
+  }
+
+  DLOG(INFO) << "TreeLayout: # vertices " << n
+             << ": # edges " << _child.size();
+
+  return;
+}
+
+// Trigger instantiation
+template class TreeLayout<uint32_t>;
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
@@ -0,0 +1,164 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+//
+// Class TreeLayout:
+// DESCRIPTION:
+//   Layout pass run once over a Tree (MST, SPT, ...) after it is built.
+//   The tree only stores parent pointers: enumerating children or
+//   aggregating over a subtree would otherwise require a full tree walk.
+//   (i) Vertices are ordered in DFS pre-order (roots in vid order,
+//       children in vid order). Every subtree is a contiguous range
+//       [pos(vid), pos(vid) + subtree_size(vid)) of that order.
+//   (ii) Children are kept in CSR form: one children array with per
+//        vertex offsets, rows laid out in DFS pre-order.
+//   Subtree aggregates (vertex count, edge cost, or any per vertex value)
+//   are then range sums over prefix sums: O(1) per query.
+//
+// EXAMPLE USAGE:
+//   SPTDijkstra<uint32_t> spt(g);
+//   TreeLayout<uint32_t> tl(spt.get_tree());
+//   for (auto it = tl.cbegin_children(v); it != tl.cend_children(v); ++it) ...
+//   tl.get_subtree_size(v), tl.get_subtree_cost(v)
+//   std::vector<uint64_t> pfx = tl.get_prefix_sums(traffic_by_vid);
+//   tl.get_subtree_sum(v, pfx)
+
+#ifndef _TREE_LAYOUT_H_
+#define _TREE_LAYOUT_H_
+
+// Standard C++ Headers
+#include <iostream>     // std::cout
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+// Standard C Headers
+#include <cassert>      // assert
+// Local Headers
+#include "utils/graph.h"
+#include "utils/tree.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+template <typename GCost>
+class TreeLayout {
+ public:
+  // Contructors
+  //     Lays out tree t: O(V) time and space
+  explicit TreeLayout(const Tree<GCost> &t);
+
+  // Destructor
+  ~TreeLayout() {}
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  TreeLayout(const TreeLayout &) = delete;
+  TreeLayout(TreeLayout &&) = delete; // C++11 only
+  void operator=(const TreeLayout &) = delete;
+  void operator=(TreeLayout &&) = delete; // C++11 only
+
+  // METHODS:
+  // return number of vertices in the layout
+  inline uint32_t get_num_vertices() const { return _order.size(); }
+
+  // vertices in DFS pre-order
+  inline const std::vector<GVertexId>& get_preorder() const { return _order; }
+
+  // position of vid in DFS pre-order
+  inline uint32_t get_pos(GVertexId vid) const {
+    assert(vid < _pos.size());
+    return _pos[vid];
+  }
+
+  // # of vertices in the subtree rooted at vid (including vid)
+  inline uint32_t get_subtree_size(GVertexId vid) const {
+    assert(vid < _pos.size());
+    return _size[_pos[vid]];
+  }
+
+  // range [first, second) of DFS pre-order positions covering subtree of vid
+  inline std::pair<uint32_t, uint32_t> get_subtree_range(GVertexId vid) const {
+    uint32_t p = get_pos(vid);
+    return std::make_pair(p, p + _size[p]);
+  }
+
+  // true when vid1 is an ancestor of (or same as) vid2
+  inline bool is_ancestor(GVertexId vid1, GVertexId vid2) const {
+    uint32_t p1 = get_pos(vid1), p2 = get_pos(vid2);
+    return (p1 <= p2) && (p2 < p1 + _size[p1]);
+  }
+
+  // # of children of vid
+  inline uint32_t get_num_children(GVertexId vid) const {
+    uint32_t p = get_pos(vid);
+    return _child_off[p + 1] - _child_off[p];
+  }
+
+  // ITERATORS: children of vid in the CSR children array
+  using TLConstIterator = typename std::vector<GVertexId>::const_iterator;
+  inline TLConstIterator cbegin_children(GVertexId vid) const {
+    return _child.cbegin() + _child_off[get_pos(vid)];
+  }
+  inline TLConstIterator cend_children(GVertexId vid) const {
+    return _child.cbegin() + _child_off[get_pos(vid) + 1];
+  }
+
+  // total edge cost of all edges inside the subtree rooted at vid
+  inline GCost get_subtree_cost(GVertexId vid) const {
+    uint32_t p = get_pos(vid);
+    return _cost_pfx[p + _size[p]] - _cost_pfx[p + 1];
+  }
+
+  // prefix sums of a per vertex value (indexed by vid) in DFS pre-order:
+  // computed once and then consumed by get_subtree_sum for any subtree
+  template <typename T>
+  std::vector<T> get_prefix_sums(const std::vector<T> &vval) const {
+    assert(vval.size() == _order.size());
+    std::vector<T> pfx(_order.size() + 1, T{});
+    for (uint32_t i = 0; i < _order.size(); ++i)
+      pfx[i + 1] = pfx[i] + vval[_order[i]];
+    return pfx;
+  }
+
+  // sum of the per vertex value over subtree of vid (including vid)
+  template <typename T>
+  inline T get_subtree_sum(GVertexId vid, const std::vector<T> &pfx) const {
+    assert(pfx.size() == _order.size() + 1);
+    uint32_t p = get_pos(vid);
+    return pfx[p + _size[p]] - pfx[p];
+  }
+
+ protected:
+ private:
+  // vertices in DFS pre-order
+  std::vector<GVertexId> _order;
+  // position of the vertex (indexed by vid) in DFS pre-order
+  std::vector<uint32_t>  _pos;
+  // subtree sizes: indexed by DFS pre-order position
+  std::vector<uint32_t>  _size;
+  // CSR children: children of vertex at pre-order position p are
+  // _child[_child_off[p] .. _child_off[p+1])
+  std::vector<uint32_t>  _child_off;
+  std::vector<GVertexId> _child;
+  // prefix sums of the edge cost to the parent: in DFS pre-order
+  std::vector<GCost>     _cost_pfx;
+};
+
+// Suppress implicit instantiation
+extern template class TreeLayout<uint32_t>;
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _TREE_LAYOUT_H_
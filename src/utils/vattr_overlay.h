@@ -0,0 +1,253 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+
+// 
+// Class VAttrOverlay:
+// DESCRIPTION:
+//   Vertex attributes of a graph kept apart from the graph (topology).
+//   The topology (Graph) is immutable & may be shared read-only by any
+//   number of overlays (e.g. one per thread). An overlay costs O(V)
+//   memory against O(V^2) of the adjacency of the topology: copying an
+//   overlay is cheap and binds the copy to the same topology.
+//   Checkpoints: save_state pushes a checkpoint. While a checkpoint is
+//   active every modified vertex attribute is logged (vid, old value) in
+//   an undo log. restore_state rolls the log back to the last checkpoint
+//   and pops it: O(# modifications) rather than O(V). Checkpoints nest.
+//   Attribute Index: when the attribute takes few values (eGraphAttrTraits
+//   specialized) and attributes match by std::equal_to, the overlay keeps
+//   one BitSet per attribute value. Neighbors of vid with the same
+//   attribute are then the AND of the adjacency row of vid with the BitSet
+//   of the attribute of vid: scanned 32 vertices at a time.
+//   Iterators: BFS/DFS & edge iterators over the overlay only visit
+//   neighbors with matching attributes (neighbor policy get_next_nbr).
+// EXAMPLE USAGE:
+//   Graph<uint32_t> g(...);                // shared by all threads
+//   VAttrOverlay<Color> board(g);          // per thread
+//   board.save_state(); board.set_vertex_attr(vid, Color::BLUE);
+//   for (auto it = board.vcbegin(DFS_ORDER, vid); ...) ...
+//   board.restore_state();
+
+#ifndef _VATTR_OVERLAY_H_
+#define _VATTR_OVERLAY_H_
+// C++ Standard Headers
+#include <functional>       // std::BinaryPredicate, std::equal_to
+#include <iostream>         // std::cout
+#include <type_traits>      // std::is_same
+#include <utility>          // std::pair
+#include <vector>           // std::vector
+// C Standard Headers
+#include <cassert>          // assert
+// Local Headers
+#include "utils/bit_set.h"
+#include "utils/graph.h"
+#include "utils/graph_iter.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// eGraphAttrTraits: maps an attribute that takes a small number of values
+// to a dense index [0, NUM_VALUES). Specialize (NUM_VALUES > 0) to let
+// eGraph & VAttrOverlay index vertices by attribute value.
+template <typename vAttr>
+struct eGraphAttrTraits {
+  constexpr static uint32_t NUM_VALUES = 0;
+  static inline uint32_t index(const vAttr &) { return 0; }
+};
+
+template <typename vAttr, 
+          typename vAttrIsEqual = std::equal_to<vAttr>, 
+          typename GCost = uint32_t>
+class VAttrOverlay {
+ public:
+  explicit VAttrOverlay(const Graph<GCost> &g) :
+      _g(&g), _vmap(g.get_num_vertices()) {
+    if (!use_attr_index())
+      return;
+    // every vertex starts with the default attribute
+    uint32_t num_vertices = g.get_num_vertices();
+    _vattr_bits.reserve(eGraphAttrTraits<vAttr>::NUM_VALUES);
+    for (uint32_t i = 0; i < eGraphAttrTraits<vAttr>::NUM_VALUES; ++i)
+      _vattr_bits.push_back(BitSet::linear(num_vertices));
+    uint32_t idx = eGraphAttrTraits<vAttr>::index(vAttr());
+    for (GVertexId vid = 0; vid < num_vertices; ++vid)
+      _vattr_bits.at(idx).set_bit(vid);
+  }
+  ~VAttrOverlay() = default;
+
+  // Copy: O(V) attributes, bound to the same (shared) topology
+  VAttrOverlay(const VAttrOverlay &) = default;
+  // Prevent unintended bad usage: 
+  // Disallow: move ctor/assignable (C++11)
+  VAttrOverlay(VAttrOverlay &&) = delete; // C++11 only
+  void operator=(const VAttrOverlay &) = delete;
+  void operator=(VAttrOverlay &&) = delete; // C++11 only
+
+  // Two overlays are "equal" when they are pointing to the same location 
+  bool operator ==(const VAttrOverlay& o) const { return (this == &o); }
+
+  inline const Graph<GCost>& get_topology(void) const { return *_g; }
+  inline uint32_t get_num_vertices(void) const {
+    return _g->get_num_vertices();
+  }
+
+  inline void set_vertex_attr(GVertexId vid, const vAttr& vA) {
+    log_vertex_attr(vid);
+    update_attr_index(vid, _vmap.at(vid), vA);
+    _vmap.at(vid) = vA;
+    return;
+  }
+
+  inline const vAttr& get_vertex_attr(GVertexId vid) const {
+    return _vmap.at(vid);
+  }
+
+  // Caller may modify the attribute via the reference: logged upfront
+  // Not available with the attribute index: use set_vertex_attr
+  inline vAttr& get_vertex_attr(GVertexId vid) {
+    static_assert(eGraphAttrTraits<vAttr>::NUM_VALUES == 0 ||
+                  !std::is_same<vAttrIsEqual, std::equal_to<vAttr>>::value,
+                  "attribute index cannot track modification by reference");
+    log_vertex_attr(vid);
+    return _vmap.at(vid);
+  }
+
+  // get_next_nbr: provide the first nbr vertex that is available
+  // immediately from or after the passed nbr_vid 
+  // *as long as* the attribute of the vertices match
+  inline GVertexId get_next_nbr(GVertexId vid, GVertexId nbr_vid) const {
+    GVertexId vid_end = get_num_vertices();
+    assert(vid < vid_end);
+    if (use_attr_index()) {
+      // AND adjacency row of vid with vertices of the same attribute
+      const BitSet &same =
+          _vattr_bits[eGraphAttrTraits<vAttr>::index(_vmap[vid])];
+      for (GVertexId vid2 = nbr_vid; vid2 < vid_end; vid2 += 32) {
+        uint32_t bits =
+            _g->get_adjmap_bits(vid, vid2) & same.get_bits(vid2);
+        if (vid_end - vid2 < 32)
+          bits &= (1U << (vid_end - vid2)) - 1;
+        if (bits != 0)
+          return vid2 + __builtin_ctz(bits);
+      }
+      return kGMaxVertexId<GCost>();
+    }
+    for (GVertexId vid2 = nbr_vid; vid2 < vid_end; ++vid2) {
+      if (_g->isset_adjmap(std::make_pair(vid, vid2)) &&
+          _vattr_is_equal(_vmap[vid], _vmap[vid2]))
+        return vid2;
+    }
+    return kGMaxVertexId<GCost>();
+  }
+
+  inline GEdgeIterConstReference<GCost>
+  get_edge_elem(GVertexId vid, GVertexId nbr_vid) const {
+    return _g->get_edge_elem(vid, nbr_vid);
+  }
+
+  // ITERATORS over the overlay: only neighbors with matching attributes
+  using VertexCIter = GVertexCIter<GCost, VAttrOverlay>;
+  using EdgeCIter   = GEdgeCIter<GCost, VAttrOverlay>;
+  inline VertexCIter vcbegin(GVertexIterType itype,
+                             const GVertexId &seed_vid) const {
+    return VertexCIter(itype, *this, GVertexIterSeed(1, seed_vid));
+  }
+  inline VertexCIter vcbegin(GVertexIterType itype,
+                             const GVertexIterSeed& seed_v) const {
+    return VertexCIter(itype, *this, seed_v);
+  }
+  inline VertexCIter vcend(GVertexIterType itype) const {
+    return VertexCIter(itype, *this, GVertexIterSeed());
+  }
+  inline EdgeCIter ecbegin(GVertexId vid) const {
+    return EdgeCIter(*this, vid, 0);
+  }
+  inline EdgeCIter ecend(GVertexId vid) const {
+    return EdgeCIter(*this, vid, kGMaxVertexId<GCost>());
+  }
+
+  // Save State & Restore State: used by MC simulation to run "what if
+  // scenarios" without messing up current state of the overlay
+  // save_state: push a checkpoint
+  inline void save_state(void) { 
+    _checkpoints.push_back(_undo.size());
+    return; 
+  }
+  // restore_state: undo all modifications since the last checkpoint & pop it
+  inline void restore_state(void) { 
+    assert(!_checkpoints.empty());
+    std::size_t cp = _checkpoints.back();
+    while (_undo.size() > cp) {
+      GVertexId vid = _undo.back().first;
+      update_attr_index(vid, _vmap[vid], _undo.back().second);
+      _vmap[vid] = _undo.back().second;
+      _undo.pop_back();
+    }
+    _checkpoints.pop_back();
+    return; 
+  }
+  // discard_state: pop the last checkpoint keeping all modifications
+  // (they remain undoable by the enclosing checkpoint, if any)
+  inline void discard_state(void) {
+    assert(!_checkpoints.empty());
+    _checkpoints.pop_back();
+    if (_checkpoints.empty())
+      _undo.clear();
+    return;
+  }
+  // # of active (nested) checkpoints
+  inline std::size_t get_num_checkpoints(void) const {
+    return _checkpoints.size();
+  }
+ protected:
+ private:
+  // Topology: never modified via the overlay
+  const Graph<GCost> *_g;
+  // Vertex Value: Every Vertex has an associated information of arbitrary 
+  // complexity and size based on the preference of user
+  std::vector<vAttr> _vmap;
+  vAttrIsEqual _vattr_is_equal;
+  // Undo log: (vid, attribute before modification) in modification order
+  std::vector<std::pair<GVertexId, vAttr>> _undo;
+  // Checkpoints: undo log size when the checkpoint was pushed
+  std::vector<std::size_t> _checkpoints;
+  // Attribute Index: BitSet of vertices per attribute value (if used)
+  std::vector<BitSet> _vattr_bits;
+
+  static constexpr inline bool use_attr_index(void) {
+    return (eGraphAttrTraits<vAttr>::NUM_VALUES > 0 &&
+            std::is_same<vAttrIsEqual, std::equal_to<vAttr>>::value);
+  }
+  inline void update_attr_index(GVertexId vid, const vAttr &old_vA,
+                                const vAttr &new_vA) {
+    if (!use_attr_index())
+      return;
+    _vattr_bits[eGraphAttrTraits<vAttr>::index(old_vA)].clr_bit(vid);
+    _vattr_bits[eGraphAttrTraits<vAttr>::index(new_vA)].set_bit(vid);
+    return;
+  }
+  // Log the attribute of vid before it gets modified: only needed when
+  // some checkpoint may have to restore it
+  inline void log_vertex_attr(GVertexId vid) {
+    if (!_checkpoints.empty())
+      _undo.push_back(std::make_pair(vid, _vmap.at(vid)));
+    return;
+  }
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _VATTR_OVERLAY_H_
@@ -0,0 +1,159 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+// Standard C++ Headers
+#include <iostream>
+#include <mutex>            // std::unique_lock
+#include <sstream>          // std::stringstream
+// Standard C Headers
+#include <cassert>          // assert()
+// Google Headers
+#include <glog/logging.h>   // Daemon Log function
+// Local Headers
+#include "utils/work_stealing_pool.h"
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+// Forward Declarations
+// constexpr definitions
+constexpr uint32_t WorkStealingPool::DEFAULT_NUM_THREADS;
+// End of Forward Declarations
+
+// Pool & index of the worker run by the calling thread: nullptr when the
+// thread is not a worker of any pool
+static thread_local const WorkStealingPool *tl_pool = nullptr;
+static thread_local uint32_t                tl_index = 0;
+
+WorkStealingPool::WorkStealingPool(uint32_t num_threads) :
+    _num_pending{0}, _num_steals{0}, _stop{false} {
+  if (num_threads == 0) {
+    std::stringstream ss;
+    ss << "WorkStealingPool: # threads " << num_threads << ": should be >= 1";
+    throw ss.str();
+  }
+  // Deques exist before any worker may steal from them
+  for (uint32_t i = 0; i < num_threads; ++i)
+    _deques.emplace_back(new Worker());
+  _workers.reserve(num_threads);
+  for (uint32_t i = 0; i < num_threads; ++i)
+    _workers.emplace_back(&WorkStealingPool::run, this, i);
+
+  DLOG(INFO) << "WorkStealingPool: started " << num_threads << " workers";
+
+  return;
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_all();
+  for (auto &w : _workers)
+    w.join();
+
+  DLOG(INFO) << "WorkStealingPool: stopped: # steals " << _num_steals.load();
+
+  return;
+}
+
+// The task is counted once it can be taken: a worker woken by the count
+// always finds it (or finds it taken by another worker)
+void WorkStealingPool::push(std::function<void()> task) {
+  Worker *self = get_self();
+  if (self != nullptr) {
+    {
+      std::lock_guard<std::mutex> lock(self->mutex);
+      self->tasks.push_back(std::move(task));
+    }
+    _num_pending.fetch_add(1);
+    // Sleeping workers check the count under _mutex: no wakeup is lost
+    std::lock_guard<std::mutex> lock(_mutex);
+  } else {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shared.push_back(std::move(task));
+    _num_pending.fetch_add(1);
+  }
+  _cv.notify_one();
+
+  return;
+}
+
+WorkStealingPool::Worker *WorkStealingPool::get_self(void) const {
+  return (tl_pool == this) ? _deques.at(tl_index).get() : nullptr;
+}
+
+bool WorkStealingPool::pop_own(Worker *self, std::function<void()> *task_p) {
+  std::lock_guard<std::mutex> lock(self->mutex);
+  if (self->tasks.empty())
+    return false;
+  *task_p = std::move(self->tasks.back());
+  self->tasks.pop_back();
+  _num_pending.fetch_sub(1);
+  return true;
+}
+
+// Victims are scanned from the next worker onwards: steals of different
+// workers spread across the deques
+bool WorkStealingPool::take_other(uint32_t index,
+                                  std::function<void()> *task_p) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_shared.empty()) {
+      *task_p = std::move(_shared.front());
+      _shared.pop_front();
+      _num_pending.fetch_sub(1);
+      return true;
+    }
+  }
+  uint32_t num_deques = _deques.size();
+  for (uint32_t k = 1; k < num_deques; ++k) {
+    Worker &victim = *_deques.at((index + k) % num_deques);
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty())
+      continue;
+    *task_p = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    _num_pending.fetch_sub(1);
+    _num_steals.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+// worker thread: run tasks until the pool is stopped & drained
+void WorkStealingPool::run(uint32_t index) {
+  tl_pool = this;
+  tl_index = index;
+  Worker *self = _deques.at(index).get();
+  for (;;) {
+    std::function<void()> task;
+    if (pop_own(self, &task) || take_other(index, &task)) {
+      // exceptions of the task are captured in its future
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this]() { return _stop || _num_pending.load() > 0; });
+    if (_num_pending.load() == 0) {
+      assert(_stop);
+      return;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
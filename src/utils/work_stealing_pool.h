@@ -0,0 +1,135 @@
+// Copyright 2014 asarcar Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Arijit Sarcar <sarcar_a@yahoo.com>
+
+#ifndef _WORK_STEALING_POOL_H_
+#define _WORK_STEALING_POOL_H_
+
+// Standard C++ Headers
+#include <atomic>           // std::atomic
+#include <chrono>           // std::chrono::seconds
+#include <condition_variable> // std::condition_variable
+#include <deque>            // std::deque
+#include <functional>       // std::function
+#include <future>           // std::future, std::packaged_task
+#include <memory>           // std::make_shared, std::unique_ptr
+#include <mutex>            // std::mutex
+#include <thread>           // std::thread
+#include <type_traits>      // std::result_of
+#include <vector>           // std::vector
+// Standard C Headers
+// Google Headers
+// Local Headers
+
+namespace hexgame { namespace utils {
+//-----------------------------------------------------------------------------
+
+// WorkStealingPool: fixed # of worker threads shared by many producers of
+// tasks (e.g. the searches of many games). Every worker owns a deque:
+// tasks submitted by a worker go to its own deque & are run newest first
+// (fork-join locality), tasks submitted by other threads go to a shared
+// queue & are run oldest first. An idle worker takes tasks from the
+// shared queue & then steals the oldest task of another worker.
+// get waits for the future of a task: a worker waiting runs the tasks of
+// its own deque meanwhile so tasks waiting for tasks they forked never
+// deadlock the pool, whatever its # of threads. The destructor completes
+// all pending tasks & joins the workers.
+// EXAMPLE USAGE:
+//   WorkStealingPool pool(4);
+//   auto sum = pool.submit([&pool]() {
+//       auto half = pool.submit([]() { return count(0, N/2); });
+//       uint64_t rest = count(N/2, N);
+//       return pool.get(half) + rest;
+//     });
+//   total = pool.get(sum);
+class WorkStealingPool {
+ public:
+  constexpr static uint32_t DEFAULT_NUM_THREADS = 1;
+
+  explicit WorkStealingPool(uint32_t num_threads = DEFAULT_NUM_THREADS);
+  ~WorkStealingPool();
+
+  // Prevent unintended bad usage:
+  // Disallow: copy ctor/assignable or move ctor/assignable (C++11)
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool(WorkStealingPool &&) = delete; // C++11 only
+  void operator=(const WorkStealingPool &) = delete;
+  void operator=(WorkStealingPool &&) = delete; // C++11 only
+
+  inline uint32_t get_num_threads(void) const { return _workers.size(); }
+  // # of tasks an idle worker took from the deque of another worker
+  inline uint64_t get_num_steals(void) const { return _num_steals.load(); }
+
+  // Queue func for execution by a worker: returns future of its result
+  template <typename Func>
+  std::future<typename std::result_of<Func()>::type> submit(Func func) {
+    using Result = typename std::result_of<Func()>::type;
+    // packaged_task is move only: std::function needs a copyable callable
+    auto task = std::make_shared<std::packaged_task<Result()>>(func);
+    std::future<Result> result = task->get_future();
+    push([task]() { (*task)(); });
+    return result;
+  }
+
+  // Result of a task: a worker of the pool runs tasks of its own deque
+  // until the result is ready
+  template <typename Result>
+  Result get(std::future<Result> &result) {
+    Worker *self = get_self();
+    while (self != nullptr &&
+           result.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      std::function<void()> task;
+      if (!pop_own(self, &task))
+        break;
+      task();
+    }
+    return result.get();
+  }
+
+ protected:
+ private:
+  // Deque of the tasks submitted by a worker
+  struct Worker {
+    std::mutex                        mutex;  // guards tasks
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<Worker>> _deques;
+  std::vector<std::thread>             _workers;
+  std::deque<std::function<void()>>    _shared;  // tasks of other threads
+  std::mutex                           _mutex;   // guards _shared & _stop
+  std::condition_variable              _cv;      // signals tasks or _stop
+  // # of tasks queued (shared queue & deques) but not yet taken
+  std::atomic<uint64_t>                _num_pending;
+  std::atomic<uint64_t>                _num_steals;
+  bool                                 _stop;
+
+  // Queues task: in the deque of the calling worker or the shared queue
+  void push(std::function<void()> task);
+  // Deque of the calling thread: nullptr unless a worker of this pool
+  Worker *get_self(void) const;
+  // Newest task of the deque of self: false when none
+  bool pop_own(Worker *self, std::function<void()> *task_p);
+  // Oldest task of the shared queue or of the deque of another worker
+  bool take_other(uint32_t index, std::function<void()> *task_p);
+  // worker thread: run tasks until the pool is stopped & drained
+  void run(uint32_t index);
+};
+
+//-----------------------------------------------------------------------------
+} } // namespace hexgame { namespace utils {
+
+#endif // _WORK_STEALING_POOL_H_